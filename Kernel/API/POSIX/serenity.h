@@ -43,6 +43,21 @@ enum {
 #define THREAD_PRIORITY_HIGH 50
 #define THREAD_PRIORITY_MAX 99
 
+#define EVENT_QUEUE_CLOEXEC 0x1
+
+#define EVENT_QUEUE_CTL_ADD 1
+#define EVENT_QUEUE_CTL_MODIFY 2
+#define EVENT_QUEUE_CTL_REMOVE 3
+
+// A one-shot registration is disarmed once it has been reported, until it is modified again.
+#define EVENT_QUEUE_ONESHOT 0x1
+
+struct event_queue_event {
+    uint64_t id;
+    short events; // POLLIN, POLLOUT, ... like in struct pollfd.
+    short flags;
+};
+
 #ifdef __cplusplus
 }
 #endif
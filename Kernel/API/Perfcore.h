@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// The binary perfcore format.
+//
+// A perfcore file starts with the 8 byte magic and a LEB128 format version, followed by a sequence of records.
+// Every record starts with a RecordType byte. All integers are LEB128 encoded, signed ones using signed LEB128.
+// Strings are encoded as their length followed by their bytes.
+//
+// - String records hold one entry of the string table (signpost strings, filenames), in index order.
+// - Stack records hold one interned backtrace: the frame count, followed by the innermost frame address,
+//   followed by the signed difference of every other frame address to the one before it.
+//   Stacks are numbered in the order they appear, starting at 1.
+// - Event records hold the event type (PERF_EVENT_*), pid, tid, the signed difference of the timestamp
+//   to the one of the previous event, lost sample count and stack number (0 for no stack), followed by
+//   the type specific data in the order it is declared in Kernel/Tasks/PerformanceEventBuffer.h.
+//   Filesystem events start with the FilesystemEventType byte and the duration in nanoseconds.
+//
+// A record only ever refers to strings and stacks that were written before it.
+
+namespace Perfcore {
+
+static constexpr u8 magic[] = { 'P', 'E', 'R', 'F', 'C', 'O', 'R', 'E' };
+static constexpr u32 version = 1;
+
+enum class RecordType : u8 {
+    String = 1,
+    Stack = 2,
+    Event = 3,
+};
+
+// Mirrors Kernel::FilesystemEventType.
+enum class FilesystemEventType : u8 {
+    Open,
+    Close,
+    Preadv,
+    Read,
+    Pread,
+};
+
+static constexpr size_t max_leb128_size = 10;
+
+constexpr size_t encode_unsigned(u64 value, u8* out)
+{
+    size_t size = 0;
+    do {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        out[size++] = byte;
+    } while (value != 0);
+    return size;
+}
+
+constexpr size_t encode_signed(i64 value, u8* out)
+{
+    size_t size = 0;
+    while (true) {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        bool is_done = (value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40));
+        if (!is_done)
+            byte |= 0x80;
+        out[size++] = byte;
+        if (is_done)
+            return size;
+    }
+}
+
+}
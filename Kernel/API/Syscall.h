@@ -18,6 +18,7 @@
 
 extern "C" {
 struct pollfd;
+struct event_queue_event;
 struct timeval;
 struct timespec;
 struct sockaddr;
@@ -62,6 +63,7 @@ enum class NeedsBigProcessLock {
     S(close, NeedsBigProcessLock::No)                      \
     S(connect, NeedsBigProcessLock::No)                    \
     S(copy_mount, NeedsBigProcessLock::No)                 \
+    S(create_event_queue, NeedsBigProcessLock::No)         \
     S(create_inode_watcher, NeedsBigProcessLock::No)       \
     S(create_thread, NeedsBigProcessLock::No)              \
     S(dbgputstr, NeedsBigProcessLock::No)                  \
@@ -71,6 +73,8 @@ enum class NeedsBigProcessLock {
     S(dup2, NeedsBigProcessLock::No)                       \
     S(execve, NeedsBigProcessLock::Yes)                    \
     S(exit, NeedsBigProcessLock::Yes)                      \
+    S(event_queue_ctl, NeedsBigProcessLock::No)            \
+    S(event_queue_wait, NeedsBigProcessLock::No)           \
     S(exit_thread, NeedsBigProcessLock::Yes)               \
     S(faccessat, NeedsBigProcessLock::No)                  \
     S(fchdir, NeedsBigProcessLock::No)                     \
@@ -156,6 +160,7 @@ enum class NeedsBigProcessLock {
     S(scheduler_get_parameters, NeedsBigProcessLock::No)   \
     S(scheduler_set_parameters, NeedsBigProcessLock::No)   \
     S(sendfd, NeedsBigProcessLock::No)                     \
+    S(sendfile, NeedsBigProcessLock::Yes)                  \
     S(sendmsg, NeedsBigProcessLock::Yes)                   \
     S(set_mmap_name, NeedsBigProcessLock::No)              \
     S(setegid, NeedsBigProcessLock::No)                    \
@@ -538,6 +543,20 @@ struct SC_inode_watcher_add_watch_params {
     u32 event_mask;
 };
 
+struct SC_event_queue_ctl_params {
+    int queue_fd;
+    int operation;
+    int fd;
+    struct event_queue_event const* event;
+};
+
+struct SC_event_queue_wait_params {
+    int queue_fd;
+    struct event_queue_event* events;
+    size_t max_events;
+    struct timespec const* timeout;
+};
+
 struct SC_statvfs_params {
     StringArgument path;
     struct statvfs* buf;
@@ -56,6 +56,7 @@
 #include <Kernel/Security/Random.h>
 #include <Kernel/Tasks/FinalizerTask.h>
 #include <Kernel/Tasks/HostnameContext.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/SyncTask.h>
@@ -355,6 +356,7 @@ void init_stage2(void*)
 
     SyncTask::spawn();
     FinalizerTask::spawn();
+    PageZeroingTask::spawn();
 
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
 
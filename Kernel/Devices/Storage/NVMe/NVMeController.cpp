@@ -67,6 +67,9 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
     dbgln_if(NVME_DEBUG, "NVMe: IO queue depth is: {}", IO_QUEUE_SIZE);
 
     TRY(identify_and_init_controller());
+    // The controller might support fewer IO queues than we have cores, in which case cores share queues
+    nr_of_queues = set_number_of_io_queues(nr_of_queues);
+    dbgln_if(NVME_DEBUG, "NVMe: Using {} IO queues for {} cores", nr_of_queues, Processor::count());
     // Create an IO queue per core
     for (u32 cpuid = 0; cpuid < nr_of_queues; ++cpuid) {
         // qid is zero is used for admin queue
@@ -281,6 +284,29 @@ ErrorOr<void> NVMeController::identify_and_init_controller()
     return {};
 }
 
+UNMAP_AFTER_INIT u32 NVMeController::set_number_of_io_queues(u32 nr_of_queues)
+{
+    VERIFY(nr_of_queues > 0);
+
+    NVMeSubmission sub {};
+    u32 result = 0;
+    sub.op = OP_ADMIN_SET_FEATURES;
+    sub.generic.cdw10 = NVMe_FEATURE_NUMBER_OF_QUEUES;
+    // Ask for the same number of submission and completion queues, as every IO queue gets its own pair
+    sub.generic.cdw11 = (nr_of_queues - 1) | ((nr_of_queues - 1) << NVMe_NR_OF_QUEUES_NCQ_SHIFT);
+    auto status = submit_admin_command(sub, true, &result);
+    if (status) {
+        // Every controller has at least one IO queue pair, so we can still work without the feature
+        dmesgln_pci(*this, "Failed to set the number of IO queues, falling back to a single IO queue");
+        return 1;
+    }
+
+    // The controller may allocate more or fewer queues than requested
+    u32 allocated_submission_queues = (result & NVMe_NR_OF_QUEUES_NSQ_MASK) + 1;
+    u32 allocated_completion_queues = (result >> NVMe_NR_OF_QUEUES_NCQ_SHIFT) + 1;
+    return min(nr_of_queues, min(allocated_submission_queues, allocated_completion_queues));
+}
+
 UNMAP_AFTER_INIT NVMeController::NSFeatures NVMeController::get_ns_features(IdentifyNamespace& identify_data_struct)
 {
     auto flbas = identify_data_struct.flbas & FLBA_SIZE_MASK;
@@ -441,7 +467,9 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, QueueType
         .dbbuf_eventidx = move(eventidx_doorbell_regs),
     };
 
-    auto irq = TRY(allocate_irq(qid));
+    // NVMeNameSpace submits to queue (processor ID % number of queues), so steer the completion
+    // interrupts of each queue to the first processor that submits to it.
+    auto irq = TRY(allocate_irq(qid, qid - 1));
 
     TRY(m_queues.try_append(TRY(NVMeQueue::try_create(*this, qid, irq, IO_QUEUE_SIZE, move(cq_dma_region), move(sq_dma_region), move(doorbell), queue_type))));
     dbgln_if(NVME_DEBUG, "NVMe: Created IO Queue with QID{}", m_queues.size());
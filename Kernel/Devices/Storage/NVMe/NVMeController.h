@@ -38,11 +38,11 @@ public:
     ErrorOr<void> reset_controller();
     ErrorOr<void> start_controller();
 
-    u16 submit_admin_command(NVMeSubmission& sub, bool sync = false)
+    u16 submit_admin_command(NVMeSubmission& sub, bool sync = false, u32* result = nullptr)
     {
         // First queue is always the admin queue
         if (sync) {
-            return m_admin_queue->submit_sync_sqe(sub);
+            return m_admin_queue->submit_sync_sqe(sub, result);
         }
         m_admin_queue->submit_sqe(sub);
         return 0;
@@ -62,6 +62,7 @@ private:
     void set_admin_q_depth();
     ErrorOr<void> identify_and_init_namespaces();
     ErrorOr<void> identify_and_init_controller();
+    u32 set_number_of_io_queues(u32 nr_of_queues);
     NSFeatures get_ns_features(IdentifyNamespace& identify_data_struct);
     ErrorOr<void> create_admin_queue(QueueType queue_type);
     ErrorOr<void> create_io_queue(u8 qid, QueueType queue_type);
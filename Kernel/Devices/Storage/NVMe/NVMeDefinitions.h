@@ -111,12 +111,19 @@ static constexpr u8 FLBA_SIZE_MASK = 0xf;
 static constexpr u8 LBA_FORMAT_SUPPORT_INDEX = 128;
 static constexpr u32 LBA_SIZE_MASK = 0x00ff0000;
 
+// SET FEATURES
+static constexpr u8 NVMe_FEATURE_NUMBER_OF_QUEUES = 0x7;
+// Both the requested and the allocated queue counts are 0 based
+static constexpr u32 NVMe_NR_OF_QUEUES_NSQ_MASK = 0xffff;
+static constexpr u32 NVMe_NR_OF_QUEUES_NCQ_SHIFT = 16;
+
 // OPCODES
 // ADMIN COMMAND SET
 enum AdminCommandOpCode {
     OP_ADMIN_CREATE_COMPLETION_QUEUE = 0x5,
     OP_ADMIN_CREATE_SUBMISSION_QUEUE = 0x1,
     OP_ADMIN_IDENTIFY = 0x6,
+    OP_ADMIN_SET_FEATURES = 0x9,
     OP_ADMIN_DBBUF_CONFIG = 0x7C,
 };
 
@@ -52,7 +52,7 @@ void NVMeInterruptQueue::complete_current_request(u16 cmdid, u16 status)
 
             current_request->complete(AsyncDeviceRequest::OutOfMemory);
             if (request_pdu.end_io_handler)
-                request_pdu.end_io_handler(status);
+                request_pdu.end_io_handler(status, request_pdu.result);
             request_pdu.clear();
         });
     }
@@ -83,6 +83,7 @@ u32 NVMeQueue::process_cq()
                 dmesgln("Bogus cmd id: {}", cmdid);
                 VERIFY_NOT_REACHED();
             }
+            requests.get(cmdid)->result = m_cqe_array[m_cq_head].cmd_spec;
             complete_current_request_impl(cmdid, status, requests);
             update_cqe_head();
         }
@@ -120,7 +121,7 @@ void NVMeQueue::complete_current_request_impl(u16 cmdid, u16 status, HashMap<u16
         if (request_pdu.request)
             request_pdu.request->complete(req_result);
         if (request_pdu.end_io_handler)
-            request_pdu.end_io_handler(status);
+            request_pdu.end_io_handler(status, request_pdu.result);
         request_pdu.clear();
     };
 
@@ -149,21 +150,24 @@ void NVMeQueue::complete_current_request(u16 cmdid, u16 status)
     });
 }
 
-u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub)
+u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub, u32* result)
 {
     // For now let's use sq tail as a unique command id.
     u16 cmd_status;
+    u32 cmd_result;
     u16 cid = get_request_cid();
     sub.cmdid = cid;
 
-    m_requests.with([this, &sub, &cmd_status](auto& requests) {
-        requests.set(sub.cmdid, { nullptr, [this, &cmd_status](u16 status) mutable { cmd_status = status; m_sync_wait_queue.wake_all(); } });
+    m_requests.with([this, &sub, &cmd_status, &cmd_result](auto& requests) {
+        requests.set(sub.cmdid, { nullptr, [this, &cmd_status, &cmd_result](u16 status, u32 result) mutable { cmd_status = status; cmd_result = result; m_sync_wait_queue.wake_all(); } });
     });
     submit_sqe(sub);
 
     // FIXME: Only sync submissions (usually used for admin commands) use a DeprecatedWaitQueue based IO. Eventually we need to
     //  move this logic into the block layer instead of sprinkling them in the driver code.
     m_sync_wait_queue.wait_forever("NVMe sync submit"sv);
+    if (result)
+        *result = cmd_result;
     return cmd_status;
 }
 
@@ -46,9 +46,12 @@ struct NVMeIO {
     {
         request = nullptr;
         end_io_handler = nullptr;
+        result = 0;
     }
     RefPtr<AsyncBlockDeviceRequest> request;
-    Function<void(u16 status)> end_io_handler;
+    Function<void(u16 status, u32 result)> end_io_handler;
+    // Command specific dword 0 of the completion entry
+    u32 result { 0 };
 };
 
 class NVMeController;
@@ -56,7 +59,7 @@ class NVMeQueue : public AtomicRefCounted<NVMeQueue> {
 public:
     static ErrorOr<NonnullLockRefPtr<NVMeQueue>> try_create(NVMeController& device, u16 qid, Optional<u8> irq, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs, QueueType queue_type);
     bool is_admin_queue() { return m_admin_queue; }
-    u16 submit_sync_sqe(NVMeSubmission&);
+    u16 submit_sync_sqe(NVMeSubmission&, u32* result = nullptr);
     void read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count);
     void write(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count);
     virtual void submit_sqe(NVMeSubmission&);
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/POSIX/poll.h>
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static constexpr short supported_events = POLLIN | POLLOUT | POLLPRI | POLLWRBAND | POLLRDHUP;
+
+static BlockFlags block_flags_for_events(short events)
+{
+    BlockFlags block_flags = BlockFlags::WriteError | BlockFlags::WriteHangUp; // always want POLLERR, POLLHUP
+    if (events & POLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & POLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (events & POLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    if (events & POLLWRBAND)
+        block_flags |= BlockFlags::WritePriority;
+    if (events & POLLRDHUP)
+        block_flags |= BlockFlags::ReadHangUp;
+    return block_flags;
+}
+
+static short events_for_unblocked_flags(BlockFlags unblocked_flags)
+{
+    // NOTE: This matches what poll() reports.
+    short events = 0;
+    if (has_flag(unblocked_flags, BlockFlags::WriteHangUp))
+        events |= POLLHUP;
+    if (has_flag(unblocked_flags, BlockFlags::WriteError))
+        return events | POLLERR;
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        events |= POLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::ReadPriority))
+        events |= POLLPRI;
+    if (!has_flag(unblocked_flags, BlockFlags::WriteHangUp) && has_flag(unblocked_flags, BlockFlags::Write))
+        events |= POLLOUT;
+    if (has_flag(unblocked_flags, BlockFlags::WritePriority))
+        events |= POLLWRBAND;
+    if (has_flag(unblocked_flags, BlockFlags::ReadHangUp))
+        events |= POLLRDHUP;
+    return events;
+}
+
+static ErrorOr<bool> is_one_shot(short flags)
+{
+    if (flags & ~EVENT_QUEUE_ONESHOT)
+        return EINVAL;
+    return (flags & EVENT_QUEUE_ONESHOT) != 0;
+}
+
+ErrorOr<NonnullRefPtr<EventQueue>> EventQueue::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventQueue);
+}
+
+EventQueue::~EventQueue()
+{
+    (void)close();
+}
+
+ErrorOr<void> EventQueue::close()
+{
+    m_registrations.with([](auto& registrations) {
+        registrations.clear();
+    });
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EventQueue::pseudo_path(OpenFileDescription const&) const
+{
+    return m_registrations.with([](auto& registrations) -> ErrorOr<NonnullOwnPtr<KString>> {
+        return KString::formatted("EventQueue:({})", registrations.size());
+    });
+}
+
+ErrorOr<void> EventQueue::add(u64 id, int fd, NonnullRefPtr<OpenFileDescription> description, short events, short flags)
+{
+    // An event queue never becomes ready itself, and registering one with another could keep both alive forever.
+    if (description->is_event_queue())
+        return EINVAL;
+    bool one_shot = TRY(is_one_shot(flags));
+
+    return m_registrations.with([&](auto& registrations) -> ErrorOr<void> {
+        if (registrations.contains(id))
+            return EEXIST;
+        TRY(registrations.try_set(id, Registration { fd, move(description), block_flags_for_events(events & supported_events), one_shot }));
+        return {};
+    });
+}
+
+ErrorOr<void> EventQueue::modify(u64 id, short events, short flags)
+{
+    bool one_shot = TRY(is_one_shot(flags));
+
+    return m_registrations.with([&](auto& registrations) -> ErrorOr<void> {
+        auto it = registrations.find(id);
+        if (it == registrations.end())
+            return ENOENT;
+        auto& registration = it->value;
+        registration.block_flags = block_flags_for_events(events & supported_events);
+        registration.is_one_shot = one_shot;
+        registration.is_armed = true;
+        ++registration.generation;
+        return {};
+    });
+}
+
+ErrorOr<void> EventQueue::remove(u64 id)
+{
+    return m_registrations.with([&](auto& registrations) -> ErrorOr<void> {
+        if (!registrations.remove(id))
+            return ENOENT;
+        return {};
+    });
+}
+
+ErrorOr<void> EventQueue::wait(Vector<event_queue_event>& events, size_t max_events, Thread::BlockTimeout const& timeout, bool should_block)
+{
+    VERIFY(max_events > 0);
+
+    struct Entry {
+        u64 id;
+        int fd;
+        u32 generation;
+        bool is_one_shot;
+    };
+
+    // Take a snapshot of the armed registrations, since we can't hold the lock while blocking.
+    // Registrations that are changed while we're waiting take effect with the next wait.
+    Thread::SelectBlocker::FDVector fds_info;
+    Vector<Entry> entries;
+    TRY(m_registrations.with([&](auto& registrations) -> ErrorOr<void> {
+        TRY(fds_info.try_ensure_capacity(registrations.size()));
+        TRY(entries.try_ensure_capacity(registrations.size()));
+        for (auto& it : registrations) {
+            auto& registration = it.value;
+            if (!registration.is_armed)
+                continue;
+            fds_info.unchecked_append({ registration.description, registration.block_flags });
+            entries.unchecked_append({ it.key, registration.fd, registration.generation, registration.is_one_shot });
+        }
+        return {};
+    }));
+
+    // Drop the registrations whose fd has been closed (or now refers to something else), so that we don't keep
+    // their descriptions open. We can't look at the fd table while holding our lock, as closing an event queue
+    // takes our lock while the fd table is locked.
+    Vector<size_t> closed_indices;
+    TRY(Process::current().fds().with_shared([&](auto& fds) -> ErrorOr<void> {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            auto description_or_error = fds.open_file_description(entries[i].fd);
+            if (description_or_error.is_error() || description_or_error.value().ptr() != fds_info[i].description.ptr())
+                TRY(closed_indices.try_append(i));
+        }
+        return {};
+    }));
+    if (!closed_indices.is_empty()) {
+        m_registrations.with([&](auto& registrations) {
+            for (auto index : closed_indices) {
+                auto it = registrations.find(entries[index].id);
+                if (it != registrations.end() && it->value.description.ptr() == fds_info[index].description.ptr())
+                    registrations.remove(it);
+            }
+        });
+        for (auto index : closed_indices.in_reverse()) {
+            fds_info.remove(index);
+            entries.remove(index);
+        }
+    }
+
+    bool any_fd_is_ready = false;
+    for (auto& fds_entry : fds_info) {
+        fds_entry.unblocked_flags = fds_entry.description->should_unblock(fds_entry.block_flags);
+        if (fds_entry.unblocked_flags != BlockFlags::None)
+            any_fd_is_ready = true;
+    }
+
+    if (!any_fd_is_ready) {
+        auto* current_thread = Thread::current();
+        if (!should_block) {
+            if (current_thread->has_unmasked_pending_signals())
+                return EINTR;
+            return {};
+        }
+        if (current_thread->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted())
+            return EINTR;
+    }
+
+    if (fds_info.is_empty())
+        return {};
+
+    Vector<size_t> ready_indices;
+    TRY(ready_indices.try_ensure_capacity(min(max_events, fds_info.size())));
+    size_t first_index = m_next_scan_index.load(AK::memory_order_relaxed) % fds_info.size();
+    for (size_t i = 0; i < fds_info.size() && ready_indices.size() < max_events; ++i) {
+        auto index = (first_index + i) % fds_info.size();
+        if (fds_info[index].unblocked_flags != BlockFlags::None)
+            ready_indices.unchecked_append(index);
+    }
+    if (!ready_indices.is_empty())
+        m_next_scan_index.store(ready_indices.last() + 1, AK::memory_order_relaxed);
+
+    TRY(events.try_ensure_capacity(ready_indices.size()));
+    m_registrations.with([&](auto& registrations) {
+        for (auto index : ready_indices) {
+            auto& entry = entries[index];
+            if (entry.is_one_shot) {
+                // Another thread may have reported (or changed) this registration while we were waiting.
+                auto it = registrations.find(entry.id);
+                if (it == registrations.end() || it->value.generation != entry.generation || !it->value.is_armed)
+                    continue;
+                it->value.is_armed = false;
+            }
+            events.unchecked_append({ entry.id, events_for_unblocked_flags(fds_info[index].unblocked_flags), 0 });
+        }
+    });
+    return {};
+}
+
+}
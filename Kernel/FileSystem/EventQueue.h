@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <Kernel/API/POSIX/serenity.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Tasks/Thread.h>
+
+namespace Kernel {
+
+// An event queue is a persistent set of file descriptions to wait on, so that an event loop doesn't have to
+// pass (and the kernel doesn't have to copy and look up) every fd it's interested in on every wait like with poll().
+// Registrations are level-triggered by default, and one-shot registrations are reported only once until modified.
+// Like with epoll, a registration ends when its fd is closed (checked on every wait).
+class EventQueue final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<EventQueue>> try_create();
+    virtual ~EventQueue() override;
+
+    // The queue can only be waited on with event_queue_wait(), it doesn't become readable itself.
+    virtual bool can_read(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EventQueue"sv; }
+    virtual bool is_event_queue() const override { return true; }
+
+    ErrorOr<void> add(u64 id, int fd, NonnullRefPtr<OpenFileDescription>, short events, short flags);
+    ErrorOr<void> modify(u64 id, short events, short flags);
+    ErrorOr<void> remove(u64 id);
+
+    // Appends up to max_events ready registrations to events, blocking until there is at least one if should_block is set.
+    ErrorOr<void> wait(Vector<event_queue_event>& events, size_t max_events, Thread::BlockTimeout const&, bool should_block);
+
+private:
+    EventQueue() = default;
+
+    struct Registration {
+        int fd;
+        NonnullRefPtr<OpenFileDescription> description;
+        Thread::FileBlocker::BlockFlags block_flags;
+        bool is_one_shot { false };
+        bool is_armed { true };
+        // Bumped on every modification, so that a wait doesn't disarm a registration that was re-armed in the meantime.
+        u32 generation { 0 };
+    };
+
+    MutexProtected<HashMap<u64, Registration>> m_registrations;
+
+    // Where the next wait starts looking for ready registrations, so that a full batch doesn't starve the others.
+    Atomic<size_t> m_next_scan_index { 0 };
+};
+
+}
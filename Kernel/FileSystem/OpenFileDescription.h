@@ -80,6 +80,10 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_event_queue() const;
+    EventQueue const* event_queue() const;
+    EventQueue* event_queue();
+
     bool is_mount_file() const;
     MountFile const* mount_file() const;
     MountFile* mount_file();
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/LoopbackDropsPackets.h>
+#include <Kernel/Net/LoopbackAdapter.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSLoopbackDropsPackets::SysFSLoopbackDropsPackets(SysFSDirectory const& parent_directory)
+    : SysFSSystemBooleanVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSLoopbackDropsPackets> SysFSLoopbackDropsPackets::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSLoopbackDropsPackets(parent_directory)).release_nonnull();
+}
+
+bool SysFSLoopbackDropsPackets::value() const
+{
+    return g_loopback_drops_packets;
+}
+
+ErrorOr<void> SysFSLoopbackDropsPackets::set_value(bool new_value)
+{
+    g_loopback_drops_packets = new_value;
+    return {};
+}
+
+}
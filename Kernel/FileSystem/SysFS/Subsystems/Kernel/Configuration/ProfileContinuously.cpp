@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/ProfileContinuously.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PerformanceEventBuffer.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSProfileContinuously::SysFSProfileContinuously(SysFSDirectory const& parent_directory)
+    : SysFSSystemBooleanVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSProfileContinuously> SysFSProfileContinuously::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSProfileContinuously(parent_directory)).release_nonnull();
+}
+
+bool SysFSProfileContinuously::value() const
+{
+    SpinlockLocker locker(m_lock);
+    return g_profile_continuously;
+}
+
+ErrorOr<void> SysFSProfileContinuously::set_value(bool new_value)
+{
+    SpinlockLocker locker(m_lock);
+    g_profile_continuously = new_value;
+    return {};
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/KmallocStatus.h>
+#include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSKmallocStatus::SysFSKmallocStatus(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSKmallocStatus> SysFSKmallocStatus::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSKmallocStatus(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSKmallocStatus::try_generate(KBufferBuilder& builder)
+{
+    kmalloc_slabheap_stats slabheaps[KMALLOC_SLABHEAP_COUNT];
+    get_kmalloc_slabheap_stats(slabheaps);
+
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    for (auto const& slabheap : slabheaps) {
+        auto obj = TRY(array.add_object());
+        TRY(obj.add("slab_size"sv, slabheap.slab_size));
+        TRY(obj.add("block_count"sv, slabheap.block_count));
+        TRY(obj.add("bytes_allocated"sv, slabheap.bytes_allocated));
+        TRY(obj.add("bytes_free"sv, slabheap.bytes_free));
+        TRY(obj.add("bytes_cached"sv, slabheap.bytes_cached));
+        TRY(obj.add("allocation_count"sv, slabheap.allocation_count));
+        TRY(obj.add("deallocation_count"sv, slabheap.deallocation_count));
+        TRY(obj.add("magazine_refill_count"sv, slabheap.magazine_refill_count));
+        TRY(obj.add("magazine_flush_count"sv, slabheap.magazine_flush_count));
+        TRY(obj.finish());
+    }
+    TRY(array.finish());
+    return {};
+}
+
+}
@@ -35,6 +35,10 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_available"sv, system_memory.physical_pages - system_memory.physical_pages_used));
     TRY(json.add("physical_committed"sv, system_memory.physical_pages_committed));
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
+    TRY(json.add("physical_cached"sv, system_memory.physical_pages_cached));
+    TRY(json.add("physical_zeroed"sv, system_memory.physical_pages_zeroed));
+    TRY(json.add("contiguous_2mib_blocks_allocated"sv, system_memory.contiguous_2mib_blocks_allocated));
+    TRY(json.add("contiguous_2mib_block_allocation_failures"sv, system_memory.contiguous_2mib_block_allocation_failures));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
     TRY(json.finish());
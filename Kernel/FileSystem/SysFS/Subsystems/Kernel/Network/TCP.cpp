@@ -41,6 +41,9 @@ ErrorOr<void> SysFSNetworkTCPStats::try_generate(KBufferBuilder& builder)
         TRY(obj.add("bytes_in"sv, socket.bytes_in()));
         TRY(obj.add("packets_out"sv, socket.packets_out()));
         TRY(obj.add("bytes_out"sv, socket.bytes_out()));
+        TRY(obj.add("congestion_window"sv, socket.congestion_window()));
+        TRY(obj.add("round_trip_time_ms"sv, socket.smoothed_round_trip_time().to_milliseconds()));
+        TRY(obj.add("retransmit_timeout_ms"sv, socket.retransmit_timeout().to_milliseconds()));
         auto current_process_credentials = Process::current().credentials();
         if (current_process_credentials->is_superuser() || current_process_credentials->uid() == socket.origin_uid()) {
             TRY(obj.add("origin_pid"sv, socket.origin_pid().value()));
@@ -24,7 +24,10 @@ ErrorOr<void> SysFSProfile::try_generate(KBufferBuilder& builder)
 {
     if (!g_global_perf_events)
         return ENOENT;
-    TRY(g_global_perf_events->to_json(builder));
+    // When profiling continuously, every read only returns the events that were recorded since the previous one.
+    if (g_global_perf_events->is_ring_buffer())
+        return g_global_perf_events->consume_to_perfcore(builder);
+    TRY(g_global_perf_events->to_perfcore(builder));
     return {};
 }
 
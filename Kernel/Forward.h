@@ -28,6 +28,7 @@ class File;
 class FATInode;
 class OpenFileDescription;
 class DisplayConnector;
+class EventQueue;
 class FileSystem;
 class FutexQueue;
 class HostnameContext;
@@ -4,12 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -29,11 +31,6 @@ static_assert(is_power_of_two(CHUNK_SIZE));
 static constexpr size_t INITIAL_KMALLOC_MEMORY_SIZE = 16 * MiB;
 static constexpr size_t KMALLOC_DEFAULT_ALIGNMENT = 16;
 
-enum class CallerHasAcquiredLock {
-    No,
-    Yes,
-};
-
 // Treat the heap as logically separate from .bss
 __attribute__((section(".heap"))) static u8 initial_kmalloc_memory[INITIAL_KMALLOC_MEMORY_SIZE];
 
@@ -44,7 +41,6 @@ nothrow_t const nothrow;
 // FIXME: Figure out whether this can be MemoryManager.
 static Spinlock<LockRank::None> s_lock {};
 
-static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory, CallerHasAcquiredLock caller_has_acquired_lock);
 void kfree_sized_impl(void* ptr, size_t size);
 
 struct KmallocSubheap {
@@ -63,9 +59,10 @@ public:
     static constexpr size_t block_size = 64 * KiB;
     static constexpr FlatPtr block_mask = ~(block_size - 1);
 
-    KmallocSlabBlock(size_t slab_size)
+    KmallocSlabBlock(size_t slab_size, bool is_page_backed)
         : m_slab_size(slab_size)
         , m_slab_count((block_size - sizeof(KmallocSlabBlock)) / slab_size)
+        , m_is_page_backed(is_page_backed)
     {
         for (size_t i = 0; i < m_slab_count; ++i) {
             auto* freelist_entry = (FreelistEntry*)(void*)(&m_data[i * slab_size]);
@@ -103,11 +100,26 @@ public:
         m_freelist = freelist_entry;
     }
 
+    static KmallocSlabBlock& from_slab(void* ptr)
+    {
+        return *(KmallocSlabBlock*)((FlatPtr)ptr & block_mask);
+    }
+
     bool is_full() const
     {
         return m_freelist == nullptr;
     }
 
+    bool is_empty() const
+    {
+        return m_allocated_slabs == 0;
+    }
+
+    size_t slab_size() const { return m_slab_size; }
+
+    // Page-backed blocks own their pages directly, instead of being carved out of a kmalloc subheap.
+    bool is_page_backed() const { return m_is_page_backed; }
+
     size_t allocated_bytes() const
     {
         return m_allocated_slabs * m_slab_size;
@@ -131,10 +143,14 @@ private:
     size_t m_slab_size { 0 };
     size_t m_slab_count { 0 };
     size_t m_allocated_slabs { 0 };
+    bool m_is_page_backed { false };
 
     [[gnu::aligned(16)]] u8 m_data[];
 };
 
+static KmallocSlabBlock* create_slab_block(size_t slab_size);
+static bool destroy_slab_block(KmallocSlabBlock&);
+
 class KmallocSlabheap {
 public:
     KmallocSlabheap(size_t slab_size)
@@ -147,21 +163,10 @@ public:
     void* allocate(size_t requested_size, [[maybe_unused]] CallerWillInitializeMemory caller_will_initialize_memory)
     {
         VERIFY(s_lock.is_locked());
-        if (m_usable_blocks.is_empty()) {
-            // FIXME: This allocation wastes `block_size` bytes due to the implementation of kmalloc_aligned().
-            //        Handle this with a custom VM+page allocator instead of using kmalloc_aligned().
-            auto* slot = kmalloc_impl(KmallocSlabBlock::block_size, KmallocSlabBlock::block_size, CallerWillInitializeMemory::No, CallerHasAcquiredLock::Yes);
-            if (!slot) {
-                dbgln_if(KMALLOC_DEBUG, "OOM while growing slabheap ({})", m_slab_size);
-                return nullptr;
-            }
-            auto* block = new (slot) KmallocSlabBlock(m_slab_size);
-            m_usable_blocks.append(*block);
-        }
-        auto* block = m_usable_blocks.first();
-        auto* ptr = block->allocate(requested_size);
-        if (block->is_full())
-            m_full_blocks.append(*block);
+        auto* ptr = allocate_slab(requested_size);
+        if (!ptr)
+            return nullptr;
+        ++m_allocation_count;
 
 #ifndef HAS_ADDRESS_SANITIZER
         if (caller_will_initialize_memory == CallerWillInitializeMemory::No) {
@@ -176,12 +181,31 @@ public:
 #ifndef HAS_ADDRESS_SANITIZER
         memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
 #endif
+        ++m_deallocation_count;
+        deallocate_slab(ptr);
+    }
 
-        auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
-        bool block_was_full = block->is_full();
-        block->deallocate(ptr);
-        if (block_was_full)
-            m_usable_blocks.append(*block);
+    // Moves up to `count` unscrubbed slabs into a per-CPU magazine and returns how many were moved.
+    size_t refill_magazine(void** slabs, size_t count)
+    {
+        VERIFY(s_lock.is_locked());
+        ++m_magazine_refill_count;
+        size_t refilled = 0;
+        for (; refilled < count; ++refilled) {
+            auto* ptr = allocate_slab(m_slab_size);
+            if (!ptr)
+                break;
+            slabs[refilled] = ptr;
+        }
+        return refilled;
+    }
+
+    void flush_magazine(void* const* slabs, size_t count)
+    {
+        VERIFY(s_lock.is_locked());
+        ++m_magazine_flush_count;
+        for (size_t i = 0; i < count; ++i)
+            deallocate_slab(slabs[i]);
     }
 
     size_t allocated_bytes() const
@@ -200,6 +224,18 @@ public:
         return total;
     }
 
+    void fill_stats(kmalloc_slabheap_stats& stats) const
+    {
+        stats.slab_size = m_slab_size;
+        stats.block_count = m_usable_blocks.size_slow() + m_full_blocks.size_slow();
+        stats.bytes_allocated = allocated_bytes();
+        stats.bytes_free = free_bytes();
+        stats.allocation_count = m_allocation_count;
+        stats.deallocation_count = m_deallocation_count;
+        stats.magazine_refill_count = m_magazine_refill_count;
+        stats.magazine_flush_count = m_magazine_flush_count;
+    }
+
     bool try_purge()
     {
         VERIFY(s_lock.is_locked());
@@ -218,23 +254,65 @@ public:
             auto& block_to_remove = *block;
             ++block;
             block_to_remove.list_node.remove();
-            block_to_remove.~KmallocSlabBlock();
-            kfree_sized_impl(&block_to_remove, KmallocSlabBlock::block_size);
-
-            did_purge = true;
+            if (destroy_slab_block(block_to_remove))
+                did_purge = true;
         }
         return did_purge;
     }
 
 private:
+    void* allocate_slab(size_t requested_size)
+    {
+        if (m_usable_blocks.is_empty()) {
+            auto* block = create_slab_block(m_slab_size);
+            if (!block) {
+                dbgln_if(KMALLOC_DEBUG, "OOM while growing slabheap ({})", m_slab_size);
+                return nullptr;
+            }
+            m_usable_blocks.append(*block);
+        }
+        auto* block = m_usable_blocks.first();
+        auto* ptr = block->allocate(requested_size);
+        if (block->is_full())
+            m_full_blocks.append(*block);
+        return ptr;
+    }
+
+    void deallocate_slab(void* ptr)
+    {
+        auto& block = KmallocSlabBlock::from_slab(ptr);
+        VERIFY(block.slab_size() == m_slab_size);
+        bool block_was_full = block.is_full();
+        block.deallocate(ptr);
+        if (block_was_full)
+            m_usable_blocks.append(block);
+
+        // Page-backed blocks are given back as soon as they're empty, but we keep the last usable one around, so that
+        // a slabheap that hovers around a block boundary doesn't keep creating and destroying blocks.
+        if (block.is_empty() && block.is_page_backed() && m_usable_blocks.first() != m_usable_blocks.last()) {
+            block.list_node.remove();
+            destroy_slab_block(block);
+        }
+    }
+
     size_t m_slab_size { 0 };
 
+    size_t m_allocation_count { 0 };
+    size_t m_deallocation_count { 0 };
+    size_t m_magazine_refill_count { 0 };
+    size_t m_magazine_flush_count { 0 };
+
     KmallocSlabBlock::List m_usable_blocks;
     KmallocSlabBlock::List m_full_blocks;
 };
 
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
+    static constexpr size_t slabheap_count = KMALLOC_SLABHEAP_COUNT;
+    // FIXME: This range can be much bigger on 64-bit, but we need to figure something out for 32-bit.
+    static constexpr size_t expansion_range_size = 64 * MiB;
+    // How many empty slab blocks stay mapped for the next slabheap that grows, before their pages are given back.
+    static constexpr size_t maximum_free_slab_block_count = 16;
 
     KmallocGlobalData(u8* initial_heap, size_t initial_heap_size)
     {
@@ -254,10 +332,8 @@ struct KmallocGlobalData {
         VERIFY(!expansion_in_progress);
         VERIFY(s_lock.is_locked());
 
-        for (auto& slabheap : slabheaps) {
-            if (size <= slabheap.slab_size() && alignment <= slabheap.slab_size())
-                return slabheap.allocate(size, caller_will_initialize_memory);
-        }
+        if (auto index = slabheap_index_for_allocation(size, alignment); index.has_value())
+            return slabheaps[index.value()].allocate(size, caller_will_initialize_memory);
 
         for (auto& subheap : subheaps) {
             if (auto* ptr = subheap.allocator.allocate(size, alignment, caller_will_initialize_memory))
@@ -293,10 +369,8 @@ struct KmallocGlobalData {
         VERIFY(!expansion_in_progress);
         VERIFY(is_valid_kmalloc_address(VirtualAddress { ptr }));
 
-        for (auto& slabheap : slabheaps) {
-            if (size <= slabheap.slab_size())
-                return slabheap.deallocate(ptr);
-        }
+        if (is_slab_allocation_size(size))
+            return slabheap_for_slab(ptr).deallocate(ptr);
 
         for (auto& subheap : subheaps) {
             if (subheap.allocator.contains(ptr)) {
@@ -325,9 +399,164 @@ struct KmallocGlobalData {
             total += subheap.allocator.free_bytes();
         for (auto const& slabheap : slabheaps)
             total += slabheap.free_bytes();
+        total += free_slab_block_count * KmallocSlabBlock::block_size;
         return total;
     }
 
+    Optional<size_t> slabheap_index_for_allocation(size_t size, size_t alignment) const
+    {
+        for (size_t i = 0; i < slabheap_count; ++i) {
+            if (size <= slabheaps[i].slab_size() && alignment <= slabheaps[i].slab_size())
+                return i;
+        }
+        return {};
+    }
+
+    bool is_slab_allocation_size(size_t size) const
+    {
+        return size <= slabheaps[slabheap_count - 1].slab_size();
+    }
+
+    size_t slabheap_index_for_slab(void* ptr) const
+    {
+        // NOTE: We go by the slab size of the containing block rather than the size passed to kfree_sized(),
+        //       as over-aligned allocations are served from a larger slabheap than their size would suggest.
+        auto slab_size = KmallocSlabBlock::from_slab(ptr).slab_size();
+        for (size_t i = 0; i < slabheap_count; ++i) {
+            if (slabheaps[i].slab_size() == slab_size)
+                return i;
+        }
+        PANIC("Bogus slab size {} for kmalloc slab {:p}", slab_size, ptr);
+    }
+
+    KmallocSlabheap& slabheap_for_slab(void* ptr)
+    {
+        return slabheaps[slabheap_index_for_slab(ptr)];
+    }
+
+    KmallocSlabBlock* create_slab_block(size_t slab_size)
+    {
+        if (auto* storage = allocate_slab_block_pages())
+            return new (storage) KmallocSlabBlock(slab_size, true);
+
+        // NOTE: Before kmalloc_enable_expand() has been called (or if we're out of pages to map), we have to carve
+        //       the block out of a subheap instead. This wastes `block_size` bytes due to the implementation of the
+        //       aligned subheap allocation.
+        auto* slot = allocate(KmallocSlabBlock::block_size, KmallocSlabBlock::block_size, CallerWillInitializeMemory::No);
+        if (!slot)
+            return nullptr;
+        return new (slot) KmallocSlabBlock(slab_size, false);
+    }
+
+    // Returns whether the block's memory was given back to the subheaps.
+    bool destroy_slab_block(KmallocSlabBlock& block)
+    {
+        bool is_page_backed = block.is_page_backed();
+        block.~KmallocSlabBlock();
+
+        if (!is_page_backed) {
+            kfree_sized_impl(&block, KmallocSlabBlock::block_size);
+            return true;
+        }
+
+        if (free_slab_block_count < maximum_free_slab_block_count) {
+            auto* free_block = new (&block) FreeSlabBlock;
+            free_block->next = free_slab_blocks;
+            free_slab_blocks = free_block;
+            ++free_slab_block_count;
+            return false;
+        }
+
+        auto block_base = VirtualAddress { &block };
+        unmap_slab_block_pages(block_base);
+        unmapped_slab_blocks[unmapped_slab_block_count++] = block_base;
+        return false;
+    }
+
+    void* allocate_slab_block_pages()
+    {
+        if (free_slab_blocks) {
+            --free_slab_block_count;
+            return exchange(free_slab_blocks, free_slab_blocks->next);
+        }
+
+        if (!expansion_data.has_value())
+            return nullptr;
+
+        if (unmapped_slab_block_count > 0) {
+            auto block_base = unmapped_slab_blocks[unmapped_slab_block_count - 1];
+            if (!map_expansion_pages(block_base, KmallocSlabBlock::block_size)) {
+                dbgln_if(KMALLOC_DEBUG, "Out of physical pages when allocating kmalloc slab block");
+                return nullptr;
+            }
+            --unmapped_slab_block_count;
+            return block_base.as_ptr();
+        }
+
+        // NOTE: Slab blocks have to be naturally aligned, so that we can find a block from any of its slabs.
+        //       Skipping ahead to the next aligned address only wastes address space, not physical memory.
+        auto block_base = expansion_data->next_virtual_address;
+        block_base = VirtualAddress { align_up_to(block_base.get(), KmallocSlabBlock::block_size) };
+        if (!expansion_data->virtual_range.contains(block_base, KmallocSlabBlock::block_size)) {
+            dbgln_if(KMALLOC_DEBUG, "Out of address space when allocating kmalloc slab block");
+            return nullptr;
+        }
+
+        if (!map_expansion_pages(block_base, KmallocSlabBlock::block_size)) {
+            dbgln_if(KMALLOC_DEBUG, "Out of physical pages when allocating kmalloc slab block");
+            return nullptr;
+        }
+        expansion_data->next_virtual_address = block_base.offset(KmallocSlabBlock::block_size);
+        return block_base.as_ptr();
+    }
+
+    bool map_expansion_pages(VirtualAddress base, size_t size)
+    {
+        auto physical_pages_or_error = MM.commit_physical_pages(size / PAGE_SIZE);
+        if (physical_pages_or_error.is_error())
+            return false;
+        auto physical_pages = physical_pages_or_error.release_value();
+
+        auto cpu_supports_nx = Processor::current().has_nx();
+
+        SpinlockLocker pd_locker(MM.kernel_page_directory().get_lock());
+
+        for (auto vaddr = base; !physical_pages.is_empty(); vaddr = vaddr.offset(PAGE_SIZE)) {
+            // FIXME: We currently leak physical memory when mapping it into the kmalloc heap.
+            auto& page = physical_pages.take_one().leak_ref();
+            auto* pte = MM.pte(MM.kernel_page_directory(), vaddr);
+            VERIFY(pte);
+            pte->set_physical_page_base(page.paddr().get());
+            pte->set_global(true);
+            pte->set_user_allowed(false);
+            pte->set_writable(true);
+            if (cpu_supports_nx)
+                pte->set_execute_disabled(true);
+            pte->set_present(true);
+        }
+        return true;
+    }
+
+    void unmap_slab_block_pages(VirtualAddress block_base)
+    {
+        constexpr size_t page_count = KmallocSlabBlock::block_size / PAGE_SIZE;
+        Array<PhysicalAddress, page_count> physical_addresses;
+        {
+            SpinlockLocker pd_locker(MM.kernel_page_directory().get_lock());
+            for (size_t i = 0; i < page_count; ++i) {
+                auto* pte = MM.pte(MM.kernel_page_directory(), block_base.offset(i * PAGE_SIZE));
+                VERIFY(pte && pte->is_present());
+                physical_addresses[i] = PhysicalAddress { pte->physical_page_base() };
+                pte->clear();
+            }
+            MM.flush_tlb(&MM.kernel_page_directory(), block_base, page_count);
+        }
+
+        // NOTE: map_expansion_pages() leaked a reference to every page it mapped, so this frees them.
+        for (auto paddr : physical_addresses)
+            MM.get_physical_page_entry(paddr).allocated.physical_page.unref();
+    }
+
     bool try_expand(size_t allocation_request)
     {
         VERIFY(!expansion_in_progress);
@@ -353,41 +582,20 @@ struct KmallocGlobalData {
             return false;
         }
 
-        auto physical_pages_or_error = MM.commit_physical_pages(new_subheap_size / PAGE_SIZE);
-        if (physical_pages_or_error.is_error()) {
+        if (!map_expansion_pages(new_subheap_base, new_subheap_size)) {
             dbgln_if(KMALLOC_DEBUG, "Out of address space when expanding kmalloc heap");
             return false;
         }
-        auto physical_pages = physical_pages_or_error.release_value();
 
         expansion_data->next_virtual_address = expansion_data->next_virtual_address.offset(new_subheap_size);
 
-        auto cpu_supports_nx = Processor::current().has_nx();
-
-        SpinlockLocker pd_locker(MM.kernel_page_directory().get_lock());
-
-        for (auto vaddr = new_subheap_base; !physical_pages.is_empty(); vaddr = vaddr.offset(PAGE_SIZE)) {
-            // FIXME: We currently leak physical memory when mapping it into the kmalloc heap.
-            auto& page = physical_pages.take_one().leak_ref();
-            auto* pte = MM.pte(MM.kernel_page_directory(), vaddr);
-            VERIFY(pte);
-            pte->set_physical_page_base(page.paddr().get());
-            pte->set_global(true);
-            pte->set_user_allowed(false);
-            pte->set_writable(true);
-            if (cpu_supports_nx)
-                pte->set_execute_disabled(true);
-            pte->set_present(true);
-        }
-
         add_subheap(new_subheap_base.as_ptr(), new_subheap_size);
         return true;
     }
 
     void enable_expansion()
     {
-        // FIXME: This range can be much bigger on 64-bit, but we need to figure something out for 32-bit.
-        auto reserved_region = MUST(MM.allocate_unbacked_region_anywhere(64 * MiB, 1 * MiB));
+        auto reserved_region = MUST(MM.allocate_unbacked_region_anywhere(expansion_range_size, 1 * MiB));
 
         expansion_data = KmallocGlobalData::ExpansionData {
             .virtual_range = reserved_region->range(),
@@ -423,7 +631,17 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    KmallocSlabheap slabheaps[slabheap_count] = { 16, 32, 64, 128, 256, 512 };
+
+    struct FreeSlabBlock {
+        FreeSlabBlock* next { nullptr };
+    };
+    FreeSlabBlock* free_slab_blocks { nullptr };
+    size_t free_slab_block_count { 0 };
+
+    // The addresses of slab blocks whose pages were given back, so that the next slab blocks can be mapped there.
+    Array<VirtualAddress, expansion_range_size / KmallocSlabBlock::block_size> unmapped_slab_blocks;
+    size_t unmapped_slab_block_count { 0 };
 
     bool expansion_in_progress { false };
 };
@@ -436,9 +654,46 @@ static size_t g_kfree_call_count;
 static size_t g_nested_kfree_calls;
 bool g_dump_kmalloc_stacks;
 
+static KmallocSlabBlock* create_slab_block(size_t slab_size)
+{
+    return g_kmalloc_global->create_slab_block(slab_size);
+}
+
+static bool destroy_slab_block(KmallocSlabBlock& block)
+{
+    return g_kmalloc_global->destroy_slab_block(block);
+}
+
+// Every CPU keeps a small stack ("magazine") of free slabs for each slabheap, so that most small
+// allocations and deallocations don't have to take s_lock. Magazines are refilled from (and flushed
+// back to) their slabheap in batches.
+struct KmallocMagazine {
+    static constexpr size_t capacity = 32;
+    static constexpr size_t batch_size = capacity / 2;
+
+    size_t count { 0 };
+    size_t allocation_count { 0 };
+    size_t deallocation_count { 0 };
+    void* slabs[capacity];
+};
+
+struct KmallocPerCPUCache {
+    KmallocMagazine magazines[KmallocGlobalData::slabheap_count];
+};
+
+static KmallocPerCPUCache s_per_cpu_caches[MAX_CPU_COUNT];
+
+// NOTE: We can only rely on Processor::current_id() once the processors have been set up,
+//       which is guaranteed by the time the MemoryManager enables kmalloc heap expansion.
+//       AddressSanitizer needs to see every allocation, so we don't cache slabs at all in that case.
+READONLY_AFTER_INIT static bool s_per_cpu_caches_enabled;
+
 void kmalloc_enable_expand()
 {
     g_kmalloc_global->enable_expansion();
+#ifndef HAS_ADDRESS_SANITIZER
+    s_per_cpu_caches_enabled = true;
+#endif
 }
 
 UNMAP_AFTER_INIT void kmalloc_init()
@@ -450,7 +705,61 @@ UNMAP_AFTER_INIT void kmalloc_init()
     s_lock.initialize();
 }
 
-static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory, CallerHasAcquiredLock caller_has_acquired_lock)
+static void* try_allocate_from_per_cpu_cache(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    if (!s_per_cpu_caches_enabled)
+        return nullptr;
+
+    auto index = g_kmalloc_global->slabheap_index_for_allocation(size, alignment);
+    if (!index.has_value())
+        return nullptr;
+    auto& slabheap = g_kmalloc_global->slabheaps[index.value()];
+
+    void* ptr = nullptr;
+    {
+        // NOTE: Disabling interrupts keeps us on this CPU, and keeps interrupt handlers from using the magazine under our feet.
+        InterruptDisabler disabler;
+        auto& magazine = s_per_cpu_caches[Processor::current_id()].magazines[index.value()];
+        if (magazine.count == 0) {
+            SpinlockLocker lock(s_lock);
+            magazine.count = slabheap.refill_magazine(magazine.slabs, KmallocMagazine::batch_size);
+            if (magazine.count == 0)
+                return nullptr;
+        }
+        ++magazine.allocation_count;
+        ptr = magazine.slabs[--magazine.count];
+    }
+
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+}
+
+static bool try_deallocate_into_per_cpu_cache(void* ptr, size_t size)
+{
+    if (!s_per_cpu_caches_enabled || !g_kmalloc_global->is_slab_allocation_size(size))
+        return false;
+
+    VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+    auto index = g_kmalloc_global->slabheap_index_for_slab(ptr);
+    auto& slabheap = g_kmalloc_global->slabheaps[index];
+    memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+
+    InterruptDisabler disabler;
+    auto& magazine = s_per_cpu_caches[Processor::current_id()].magazines[index];
+    if (magazine.count == KmallocMagazine::capacity) {
+        // Give back the slabs that have been sitting in the magazine the longest, and keep the cache-hot ones.
+        SpinlockLocker lock(s_lock);
+        slabheap.flush_magazine(magazine.slabs, KmallocMagazine::batch_size);
+        magazine.count -= KmallocMagazine::batch_size;
+        memmove(magazine.slabs, &magazine.slabs[KmallocMagazine::batch_size], magazine.count * sizeof(void*));
+    }
+    ++magazine.deallocation_count;
+    magazine.slabs[magazine.count++] = ptr;
+    return true;
+}
+
+static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
 {
     // Catch bad callers allocating under spinlock.
     if constexpr (KMALLOC_VERIFY_NO_SPINLOCK_HELD) {
@@ -460,18 +769,17 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    Optional<SpinlockLocker<Spinlock<Kernel::LockRank::None>>> maybe_lock = {};
-    if (caller_has_acquired_lock == CallerHasAcquiredLock::No)
-        maybe_lock = SpinlockLocker(s_lock);
-
-    ++g_kmalloc_call_count;
-
     if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
         dbgln("kmalloc({})", size);
         Kernel::dump_backtrace();
     }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    void* ptr = try_allocate_from_per_cpu_cache(size, alignment, caller_will_initialize_memory);
+    if (!ptr) {
+        SpinlockLocker lock(s_lock);
+        ++g_kmalloc_call_count;
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -488,7 +796,7 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
 
 void* kmalloc(size_t size)
 {
-    return kmalloc_impl(size, KMALLOC_DEFAULT_ALIGNMENT, CallerWillInitializeMemory::No, CallerHasAcquiredLock::No);
+    return kmalloc_impl(size, KMALLOC_DEFAULT_ALIGNMENT, CallerWillInitializeMemory::No);
 }
 
 void* kcalloc(size_t count, size_t size)
@@ -496,7 +804,7 @@ void* kcalloc(size_t count, size_t size)
     if (Checked<size_t>::multiplication_would_overflow(count, size))
         return nullptr;
     size_t new_size = count * size;
-    auto* ptr = kmalloc_impl(new_size, KMALLOC_DEFAULT_ALIGNMENT, CallerWillInitializeMemory::Yes, CallerHasAcquiredLock::No);
+    auto* ptr = kmalloc_impl(new_size, KMALLOC_DEFAULT_ALIGNMENT, CallerWillInitializeMemory::Yes);
     if (ptr)
         memset(ptr, 0, new_size);
     return ptr;
@@ -534,6 +842,17 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
+    if (ptr && try_deallocate_into_per_cpu_cache(ptr, size)) {
+        Thread* current_thread = Thread::current();
+        if (!current_thread)
+            current_thread = Processor::idle_thread();
+        if (current_thread) {
+            VERIFY(current_thread->is_allocation_enabled());
+            PerformanceManager::add_kfree_perf_event(*current_thread, 0, (FlatPtr)ptr);
+        }
+        return;
+    }
+
     SpinlockLocker lock(s_lock);
     kfree_sized_impl(ptr, size);
 }
@@ -551,7 +870,7 @@ size_t kmalloc_good_size(size_t size)
 
 void* kmalloc_aligned(size_t size, size_t alignment)
 {
-    return kmalloc_impl(size, alignment, CallerWillInitializeMemory::No, CallerHasAcquiredLock::No);
+    return kmalloc_impl(size, alignment, CallerWillInitializeMemory::No);
 }
 
 void* operator new(size_t size)
@@ -617,6 +936,18 @@ void operator delete[](void* ptr, size_t size) noexcept
     return kfree_sized(ptr, size);
 }
 
+static void add_per_cpu_cache_stats(size_t slabheap_index, kmalloc_slabheap_stats& stats)
+{
+    // NOTE: The magazines of other CPUs keep changing while we look at them, so this is only a snapshot.
+    auto slab_size = g_kmalloc_global->slabheaps[slabheap_index].slab_size();
+    for (auto const& cache : s_per_cpu_caches) {
+        auto const& magazine = cache.magazines[slabheap_index];
+        stats.bytes_cached += magazine.count * slab_size;
+        stats.allocation_count += magazine.allocation_count;
+        stats.deallocation_count += magazine.deallocation_count;
+    }
+}
+
 void get_kmalloc_stats(kmalloc_stats& stats)
 {
     SpinlockLocker lock(s_lock);
@@ -624,4 +955,25 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     stats.bytes_free = g_kmalloc_global->free_bytes();
     stats.kmalloc_call_count = g_kmalloc_call_count;
     stats.kfree_call_count = g_kfree_call_count;
+
+    for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+        kmalloc_slabheap_stats cache_stats {};
+        add_per_cpu_cache_stats(i, cache_stats);
+        // Slabs sitting in a magazine are free, even though their slabheap considers them allocated.
+        stats.bytes_allocated -= cache_stats.bytes_cached;
+        stats.bytes_free += cache_stats.bytes_cached;
+        stats.kmalloc_call_count += cache_stats.allocation_count;
+        stats.kfree_call_count += cache_stats.deallocation_count;
+    }
+}
+
+void get_kmalloc_slabheap_stats(kmalloc_slabheap_stats (&stats)[KMALLOC_SLABHEAP_COUNT])
+{
+    SpinlockLocker lock(s_lock);
+    for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+        stats[i] = {};
+        g_kmalloc_global->slabheaps[i].fill_stats(stats[i]);
+        add_per_cpu_cache_stats(i, stats[i]);
+        stats[i].bytes_allocated -= stats[i].bytes_cached;
+    }
 }
@@ -267,6 +267,13 @@ NonnullRefPtr<PhysicalRAMPage> AnonymousVMObject::allocate_committed_page(Badge<
     return m_unused_committed_pages->take_one();
 }
 
+void AnonymousVMObject::uncommit_committed_pages(Badge<Region>, size_t page_count)
+{
+    if (page_count == 0)
+        return;
+    m_unused_committed_pages->uncommit(page_count);
+}
+
 void AnonymousVMObject::reset_cow_map()
 {
     for (size_t i = 0; i < page_count(); ++i) {
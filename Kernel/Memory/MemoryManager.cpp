@@ -29,6 +29,7 @@
 #include <Kernel/Prekernel/Prekernel.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Security/AddressSanitizer.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Userland/Libraries/LibDeviceTree/FlattenedDeviceTree.h>
 
@@ -49,6 +50,27 @@ extern size_t multiboot_copy_boot_modules_count;
 
 namespace Kernel::Memory {
 
+// Every processor keeps a small cache of free physical pages, so that most page allocations and
+// deallocations don't have to take the global MM lock. Cached pages are accounted as used (so they
+// can't be committed to), and are refilled from (and flushed back to) the physical regions in batches.
+// The page zeroing task keeps some of them zeroed ahead of time, which makes zero-filled allocations cheap.
+struct PhysicalPageCache {
+    static constexpr size_t capacity = 64;
+    static constexpr size_t batch_size = capacity / 2;
+    static constexpr size_t zeroed_capacity = 32;
+
+    Spinlock<LockRank::None> lock {};
+    size_t count { 0 };
+    size_t zeroed_count { 0 };
+    PhysicalAddress pages[capacity];
+    PhysicalAddress zeroed_pages[zeroed_capacity];
+};
+
+static PhysicalPageCache s_per_cpu_page_caches[MAX_CPU_COUNT];
+
+// NOTE: We can only rely on Processor::current_id() once the processors have been set up.
+READONLY_AFTER_INIT static bool s_per_cpu_page_caches_enabled;
+
 ErrorOr<FlatPtr> page_round_up(FlatPtr x)
 {
     if (x > (explode_byte(0xFF) & ~0xFFF)) {
@@ -1051,6 +1073,7 @@ UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
     if (cpu == 0) {
         new MemoryManager;
         kmalloc_enable_expand();
+        s_per_cpu_page_caches_enabled = true;
 
         s_mm_initialized.set();
     }
@@ -1281,16 +1304,25 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_kernel_region_with_vmobje
 ErrorOr<CommittedPhysicalPageSet> MemoryManager::commit_physical_pages(size_t page_count)
 {
     VERIFY(page_count > 0);
-    auto result = m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
-        if (global_data.system_memory_info.physical_pages_uncommitted < page_count) {
-            dbgln("MM: Unable to commit {} pages, have only {}", page_count, global_data.system_memory_info.physical_pages_uncommitted);
-            return ENOMEM;
-        }
+    auto try_commit = [&](bool should_log_failure) {
+        return m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
+            if (global_data.system_memory_info.physical_pages_uncommitted < page_count) {
+                if (should_log_failure)
+                    dbgln("MM: Unable to commit {} pages, have only {}", page_count, global_data.system_memory_info.physical_pages_uncommitted);
+                return ENOMEM;
+            }
 
-        global_data.system_memory_info.physical_pages_uncommitted -= page_count;
-        global_data.system_memory_info.physical_pages_committed += page_count;
-        return CommittedPhysicalPageSet { {}, page_count };
-    });
+            global_data.system_memory_info.physical_pages_uncommitted -= page_count;
+            global_data.system_memory_info.physical_pages_committed += page_count;
+            return CommittedPhysicalPageSet { {}, page_count };
+        });
+    };
+    auto result = try_commit(false);
+    if (result.is_error()) {
+        // The pages sitting in the per-CPU caches are free, they just can't be committed to while they're cached.
+        drain_per_cpu_page_caches();
+        result = try_commit(true);
+    }
     if (result.is_error()) {
         Process::for_each_ignoring_process_lists([&](Process const& process) {
             size_t amount_resident = 0;
@@ -1328,24 +1360,187 @@ void MemoryManager::uncommit_physical_pages(Badge<CommittedPhysicalPageSet>, siz
 }
 
 void MemoryManager::deallocate_physical_page(PhysicalAddress paddr)
+{
+    if (try_deallocate_physical_page_into_per_cpu_cache(paddr))
+        return;
+    m_global_data.with([&](auto& global_data) {
+        return_free_physical_page(paddr, global_data);
+    });
+}
+
+void MemoryManager::return_free_physical_page(PhysicalAddress paddr, GlobalData& global_data)
+{
+    // Are we returning a user page?
+    for (auto& region : global_data.physical_regions) {
+        if (!region->contains(paddr))
+            continue;
+
+        region->return_page(paddr);
+        --global_data.system_memory_info.physical_pages_used;
+
+        // Always return pages to the uncommitted pool. Pages that were
+        // committed and allocated are only freed upon request. Once
+        // returned there is no guarantee being able to get them back.
+        ++global_data.system_memory_info.physical_pages_uncommitted;
+        return;
+    }
+    PANIC("MM: deallocate_physical_page couldn't figure out region for page @ {}", paddr);
+}
+
+size_t MemoryManager::take_free_physical_pages_for_cache(Span<PhysicalAddress> pages)
 {
     return m_global_data.with([&](auto& global_data) {
-        // Are we returning a user page?
+        // We need to make sure we don't touch pages that we have committed to
+        auto page_count = min(pages.size(), static_cast<size_t>(global_data.system_memory_info.physical_pages_uncommitted));
+        size_t taken = 0;
         for (auto& region : global_data.physical_regions) {
-            if (!region->contains(paddr))
-                continue;
+            if (taken == page_count)
+                break;
+            taken += region->take_free_pages(pages.slice(taken, page_count - taken));
+        }
+        global_data.system_memory_info.physical_pages_uncommitted -= taken;
+        global_data.system_memory_info.physical_pages_used += taken;
+        return taken;
+    });
+}
 
-            region->return_page(paddr);
-            --global_data.system_memory_info.physical_pages_used;
+void MemoryManager::return_physical_pages_from_cache(ReadonlySpan<PhysicalAddress> pages)
+{
+    if (pages.is_empty())
+        return;
+    m_global_data.with([&](auto& global_data) {
+        for (auto paddr : pages)
+            return_free_physical_page(paddr, global_data);
+    });
+}
 
-            // Always return pages to the uncommitted pool. Pages that were
-            // committed and allocated are only freed upon request. Once
-            // returned there is no guarantee being able to get them back.
-            ++global_data.system_memory_info.physical_pages_uncommitted;
-            return;
+RefPtr<PhysicalRAMPage> MemoryManager::try_allocate_physical_page_from_per_cpu_cache(ShouldZeroFill should_zero_fill, MemoryType memory_type_for_zero_fill)
+{
+    if (!s_per_cpu_page_caches_enabled)
+        return nullptr;
+
+    // NOTE: The page zeroing task zeroes pages through a normal memory mapping, see the FIXME in allocate_committed_physical_page.
+    bool wants_zeroed_page = should_zero_fill == ShouldZeroFill::Yes && memory_type_for_zero_fill == MemoryType::Normal;
+    bool page_is_zeroed = false;
+    bool should_notify_page_zeroing_task = false;
+    PhysicalAddress paddr;
+    {
+        auto& cache = s_per_cpu_page_caches[Processor::current_id()];
+        SpinlockLocker locker(cache.lock);
+        if (wants_zeroed_page && cache.zeroed_count > 0) {
+            paddr = cache.zeroed_pages[--cache.zeroed_count];
+            page_is_zeroed = true;
+            should_notify_page_zeroing_task = cache.zeroed_count == PhysicalPageCache::zeroed_capacity / 2;
+        } else {
+            if (cache.count == 0)
+                cache.count = take_free_physical_pages_for_cache({ cache.pages, PhysicalPageCache::batch_size });
+            if (cache.count > 0) {
+                paddr = cache.pages[--cache.count];
+            } else if (cache.zeroed_count > 0) {
+                paddr = cache.zeroed_pages[--cache.zeroed_count];
+                page_is_zeroed = true;
+            } else {
+                return nullptr;
+            }
+            should_notify_page_zeroing_task = wants_zeroed_page;
         }
-        PANIC("MM: deallocate_physical_page couldn't figure out region for page @ {}", paddr);
-    });
+    }
+
+    if (should_notify_page_zeroing_task)
+        PageZeroingTask::notify();
+
+    auto page = PhysicalRAMPage::create(paddr);
+    if (should_zero_fill == ShouldZeroFill::Yes && !page_is_zeroed) {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(*page, memory_type_for_zero_fill);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
+    return page;
+}
+
+bool MemoryManager::try_deallocate_physical_page_into_per_cpu_cache(PhysicalAddress paddr)
+{
+    if (!s_per_cpu_page_caches_enabled)
+        return false;
+
+    auto& cache = s_per_cpu_page_caches[Processor::current_id()];
+    SpinlockLocker locker(cache.lock);
+    if (cache.count == PhysicalPageCache::capacity) {
+        // Give back the pages that have been sitting in the cache the longest, and keep the cache-hot ones.
+        return_physical_pages_from_cache({ cache.pages, PhysicalPageCache::batch_size });
+        cache.count -= PhysicalPageCache::batch_size;
+        memmove(cache.pages, &cache.pages[PhysicalPageCache::batch_size], cache.count * sizeof(PhysicalAddress));
+    }
+    cache.pages[cache.count++] = paddr;
+    return true;
+}
+
+size_t MemoryManager::drain_per_cpu_page_caches()
+{
+    if (!s_per_cpu_page_caches_enabled)
+        return 0;
+
+    size_t drained_page_count = 0;
+    // NOTE: The processor count is never written on some architectures, but there's always at least one.
+    auto processor_count = max(Processor::count(), 1u);
+    for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+        auto& cache = s_per_cpu_page_caches[cpu];
+        // NOTE: Another processor may be waiting for the global lock while holding its cache lock,
+        //       so we must never hold a cache lock while returning the pages.
+        PhysicalAddress pages[PhysicalPageCache::capacity + PhysicalPageCache::zeroed_capacity];
+        size_t page_count = 0;
+        {
+            SpinlockLocker locker(cache.lock);
+            for (size_t i = 0; i < cache.count; ++i)
+                pages[page_count++] = cache.pages[i];
+            for (size_t i = 0; i < cache.zeroed_count; ++i)
+                pages[page_count++] = cache.zeroed_pages[i];
+            cache.count = 0;
+            cache.zeroed_count = 0;
+        }
+        return_physical_pages_from_cache({ pages, page_count });
+        drained_page_count += page_count;
+    }
+    return drained_page_count;
+}
+
+void MemoryManager::refill_zeroed_page_caches()
+{
+    // NOTE: The processor count is never written on some architectures, but there's always at least one.
+    auto processor_count = max(Processor::count(), 1u);
+    for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+        auto& cache = s_per_cpu_page_caches[cpu];
+        while (true) {
+            PhysicalAddress paddr;
+            {
+                SpinlockLocker locker(cache.lock);
+                if (cache.zeroed_count == PhysicalPageCache::zeroed_capacity)
+                    break;
+                if (cache.count > 0)
+                    paddr = cache.pages[--cache.count];
+            }
+            if (paddr.is_null() && take_free_physical_pages_for_cache({ &paddr, 1 }) == 0)
+                return;
+
+            {
+                InterruptDisabler disabler;
+                auto* ptr = quickmap_page(paddr);
+                memset(ptr, 0, PAGE_SIZE);
+                unquickmap_page();
+            }
+
+            SpinlockLocker locker(cache.lock);
+            if (cache.zeroed_count < PhysicalPageCache::zeroed_capacity) {
+                cache.zeroed_pages[cache.zeroed_count++] = paddr;
+            } else if (cache.count < PhysicalPageCache::capacity) {
+                cache.pages[cache.count++] = paddr;
+            } else {
+                locker.unlock();
+                return_physical_pages_from_cache({ &paddr, 1 });
+            }
+        }
+    }
 }
 
 RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed, GlobalData& global_data)
@@ -1377,8 +1572,34 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed, G
     return page;
 }
 
+RefPtr<PhysicalRAMPage> MemoryManager::take_freed_physical_page()
+{
+    // Pages that were just freed go into this processor's cache first, which we've drained before freeing anything.
+    // NOTE: We must not hold the global lock here, see drain_per_cpu_page_caches(). If we migrate to another processor
+    //       in the meantime, we just look at the wrong cache and fall back to the physical regions.
+    if (s_per_cpu_page_caches_enabled) {
+        auto& cache = s_per_cpu_page_caches[Processor::current_id()];
+        SpinlockLocker locker(cache.lock);
+        if (cache.count > 0)
+            return PhysicalRAMPage::create(cache.pages[--cache.count]);
+    }
+    return m_global_data.with([&](auto& global_data) {
+        return find_free_physical_page(false, global_data);
+    });
+}
+
 NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
 {
+    if (auto page = try_allocate_physical_page_from_per_cpu_cache(should_zero_fill, MemoryType::Normal)) {
+        // The cached page was taken out of the uncommitted pool, so it now replaces one of our committed pages.
+        m_global_data.with([&](auto& global_data) {
+            VERIFY(global_data.system_memory_info.physical_pages_committed > 0);
+            global_data.system_memory_info.physical_pages_committed--;
+            global_data.system_memory_info.physical_pages_uncommitted++;
+        });
+        return page.release_nonnull();
+    }
+
     auto page = m_global_data.with([&](auto& global_data) {
         return find_free_physical_page(true, global_data);
     });
@@ -1396,59 +1617,76 @@ NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(B
 
 ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge, MemoryType memory_type_for_zero_fill)
 {
-    return m_global_data.with([&](auto& global_data) -> ErrorOr<NonnullRefPtr<PhysicalRAMPage>> {
-        auto page = find_free_physical_page(false, global_data);
-        bool purged_pages = false;
-
-        if (!page) {
-            // We didn't have a single free physical page. Let's try to free something up!
-            // First, we look for a purgeable VMObject in the volatile state.
-            for_each_vmobject([&](auto& vmobject) {
-                if (!vmobject.is_anonymous())
-                    return IterationDecision::Continue;
-                auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject);
-                if (!anonymous_vmobject.is_purgeable() || !anonymous_vmobject.is_volatile())
-                    return IterationDecision::Continue;
-                if (auto purged_page_count = anonymous_vmobject.purge()) {
-                    dbgln("MM: Purge saved the day! Purged {} pages from AnonymousVMObject", purged_page_count);
-                    page = find_free_physical_page(false, global_data);
-                    purged_pages = true;
-                    VERIFY(page);
-                    return IterationDecision::Break;
-                }
+    if (auto page = try_allocate_physical_page_from_per_cpu_cache(should_zero_fill, memory_type_for_zero_fill)) {
+        if (did_purge)
+            *did_purge = false;
+        return page.release_nonnull();
+    }
+
+    // We couldn't refill our cache, so we're running low on memory.
+    // The pages sitting in the other processors' caches are cheaper to get back than purging anything.
+    auto page = m_global_data.with([&](auto& global_data) {
+        return find_free_physical_page(false, global_data);
+    });
+    if (!page && drain_per_cpu_page_caches() > 0) {
+        page = m_global_data.with([&](auto& global_data) {
+            return find_free_physical_page(false, global_data);
+        });
+    }
+
+    // NOTE: Purging frees pages through deallocate_physical_page(), which takes the per-CPU cache locks and then
+    //       the global lock. So we must not hold the global lock while purging or taking the freed pages.
+    bool purged_pages = false;
+    if (!page) {
+        // We didn't have a single free physical page. Let's try to free something up!
+        // First, we look for a purgeable VMObject in the volatile state.
+        for_each_vmobject([&](auto& vmobject) {
+            if (!vmobject.is_anonymous())
                 return IterationDecision::Continue;
-            });
-        }
-        if (!page) {
-            // Second, we look for a file-backed VMObject with clean pages.
-            for_each_vmobject([&](auto& vmobject) {
-                if (!vmobject.is_inode())
-                    return IterationDecision::Continue;
-                auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject);
-                if (auto released_page_count = inode_vmobject.try_release_clean_pages(1)) {
-                    dbgln("MM: Clean inode release saved the day! Released {} pages from InodeVMObject", released_page_count);
-                    page = find_free_physical_page(false, global_data);
-                    VERIFY(page);
+            auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject);
+            if (!anonymous_vmobject.is_purgeable() || !anonymous_vmobject.is_volatile())
+                return IterationDecision::Continue;
+            if (auto purged_page_count = anonymous_vmobject.purge()) {
+                dbgln("MM: Purge saved the day! Purged {} pages from AnonymousVMObject", purged_page_count);
+                // Another processor may have taken the purged pages before us, in which case we keep looking.
+                page = take_freed_physical_page();
+                purged_pages = true;
+                if (page)
                     return IterationDecision::Break;
-                }
+            }
+            return IterationDecision::Continue;
+        });
+    }
+    if (!page) {
+        // Second, we look for a file-backed VMObject with clean pages.
+        for_each_vmobject([&](auto& vmobject) {
+            if (!vmobject.is_inode())
                 return IterationDecision::Continue;
-            });
-        }
-        if (!page) {
-            dmesgln("MM: no physical pages available");
-            return ENOMEM;
-        }
+            auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject);
+            if (auto released_page_count = inode_vmobject.try_release_clean_pages(1)) {
+                dbgln("MM: Clean inode release saved the day! Released {} pages from InodeVMObject", released_page_count);
+                page = take_freed_physical_page();
+                if (page)
+                    return IterationDecision::Break;
+            }
+            return IterationDecision::Continue;
+        });
+    }
+    if (!page) {
+        dmesgln("MM: no physical pages available");
+        return ENOMEM;
+    }
 
-        if (should_zero_fill == ShouldZeroFill::Yes) {
-            auto* ptr = quickmap_page(*page, memory_type_for_zero_fill);
-            memset(ptr, 0, PAGE_SIZE);
-            unquickmap_page();
-        }
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(*page, memory_type_for_zero_fill);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
 
-        if (did_purge)
-            *did_purge = purged_pages;
-        return page.release_nonnull();
-    });
+    if (did_purge)
+        *did_purge = purged_pages;
+    return page.release_nonnull();
 }
 
 ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_contiguous_physical_pages(size_t size, MemoryType memory_type_for_zero_fill)
@@ -1482,6 +1720,54 @@ ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_contiguo
     return physical_pages;
 }
 
+ErrorOr<void> MemoryManager::allocate_physical_huge_page(Span<RefPtr<PhysicalRAMPage>> pages, ShouldZeroFill should_zero_fill)
+{
+    constexpr size_t page_count = PhysicalZone::HUGE_PAGE_SIZE / PAGE_SIZE;
+    VERIFY(pages.size() == page_count);
+
+    auto try_take_huge_page = [&] {
+        return m_global_data.with([&](auto& global_data) -> ErrorOr<PhysicalAddress> {
+            // We need to make sure we don't touch pages that we have committed to
+            if (global_data.system_memory_info.physical_pages_uncommitted >= page_count) {
+                for (auto& physical_region : global_data.physical_regions) {
+                    auto page_base = physical_region->take_free_huge_page();
+                    if (!page_base.has_value())
+                        continue;
+                    global_data.system_memory_info.physical_pages_uncommitted -= page_count;
+                    global_data.system_memory_info.physical_pages_used += page_count;
+                    ++global_data.system_memory_info.contiguous_2mib_blocks_allocated;
+                    return page_base.value();
+                }
+            }
+            return ENOMEM;
+        });
+    };
+    auto page_base_or_error = try_take_huge_page();
+    if (page_base_or_error.is_error() && drain_per_cpu_page_caches() > 0) {
+        // Freed pages of earlier blocks may be sitting in the per-CPU caches, which keeps the buddy allocator
+        // from merging them back together. Once they're returned, we may find a free block after all.
+        page_base_or_error = try_take_huge_page();
+    }
+    if (page_base_or_error.is_error()) {
+        m_global_data.with([](auto& global_data) { ++global_data.system_memory_info.contiguous_2mib_block_allocation_failures; });
+        return page_base_or_error.release_error();
+    }
+    auto page_base = page_base_or_error.release_value();
+
+    // NOTE: The pages are handed out (and later freed) one by one, the buddy allocator merges them back together once they're all free.
+    for (size_t i = 0; i < page_count; ++i) {
+        auto page = PhysicalRAMPage::create(page_base.offset(i * PAGE_SIZE));
+        if (should_zero_fill == ShouldZeroFill::Yes) {
+            InterruptDisabler disabler;
+            auto* ptr = quickmap_page(*page);
+            memset(ptr, 0, PAGE_SIZE);
+            unquickmap_page();
+        }
+        pages[i] = move(page);
+    }
+    return {};
+}
+
 void MemoryManager::enter_process_address_space(Process& process)
 {
     process.address_space().with([](auto& space) {
@@ -1654,6 +1940,15 @@ void CommittedPhysicalPageSet::uncommit_one()
     MM.uncommit_physical_pages({}, 1);
 }
 
+void CommittedPhysicalPageSet::uncommit(size_t page_count)
+{
+    if (page_count == 0)
+        return;
+    VERIFY(m_page_count >= page_count);
+    m_page_count -= page_count;
+    MM.uncommit_physical_pages({}, page_count);
+}
+
 void MemoryManager::copy_physical_page(PhysicalRAMPage& physical_page, u8 page_buffer[PAGE_SIZE])
 {
     auto* quickmapped_page = quickmap_page(physical_page);
@@ -1683,7 +1978,13 @@ MemoryManager::SystemMemoryInfo MemoryManager::get_system_memory_info()
     return m_global_data.with([&](auto& global_data) {
         auto physical_pages_unused = global_data.system_memory_info.physical_pages_committed + global_data.system_memory_info.physical_pages_uncommitted;
         VERIFY(global_data.system_memory_info.physical_pages == (global_data.system_memory_info.physical_pages_used + physical_pages_unused));
-        return global_data.system_memory_info;
+        auto system_memory_info = global_data.system_memory_info;
+        // NOTE: These are only a snapshot, the caches are not protected by the global lock.
+        for (auto const& cache : s_per_cpu_page_caches) {
+            system_memory_info.physical_pages_cached += cache.count + cache.zeroed_count;
+            system_memory_info.physical_pages_zeroed += cache.zeroed_count;
+        }
+        return system_memory_info;
     });
 }
 }
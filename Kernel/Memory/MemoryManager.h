@@ -117,6 +117,7 @@ public:
 
     [[nodiscard]] NonnullRefPtr<PhysicalRAMPage> take_one();
     void uncommit_one();
+    void uncommit(size_t page_count);
 
     void operator=(CommittedPhysicalPageSet&&) = delete;
 
@@ -168,6 +169,7 @@ public:
     NonnullRefPtr<PhysicalRAMPage> allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
     ErrorOr<NonnullRefPtr<PhysicalRAMPage>> allocate_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr, MemoryType memory_type_for_zero_fill = MemoryType::Normal);
     ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_contiguous_physical_pages(size_t size, MemoryType memory_type_for_zero_fill);
+    ErrorOr<void> allocate_physical_huge_page(Span<RefPtr<PhysicalRAMPage>>, ShouldZeroFill = ShouldZeroFill::Yes);
     void deallocate_physical_page(PhysicalAddress);
 
     ErrorOr<NonnullOwnPtr<Region>> allocate_contiguous_kernel_region(size_t, StringView name, Region::Access access, MemoryType = MemoryType::Normal);
@@ -187,10 +189,17 @@ public:
         PhysicalSize physical_pages_used { 0 };
         PhysicalSize physical_pages_committed { 0 };
         PhysicalSize physical_pages_uncommitted { 0 };
+        PhysicalSize physical_pages_cached { 0 };
+        PhysicalSize physical_pages_zeroed { 0 };
+        // MADV_HUGEPAGE regions are backed by physically contiguous 2 MiB blocks, which are still mapped with 4 KiB pages.
+        u64 contiguous_2mib_blocks_allocated { 0 };
+        u64 contiguous_2mib_block_allocation_failures { 0 };
     };
 
     SystemMemoryInfo get_system_memory_info();
 
+    void refill_zeroed_page_caches();
+
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -268,6 +277,14 @@ private:
     static void flush_tlb(PageDirectory const*, VirtualAddress, size_t page_count = 1);
 
     RefPtr<PhysicalRAMPage> find_free_physical_page(bool, GlobalData&);
+    RefPtr<PhysicalRAMPage> take_freed_physical_page();
+    void return_free_physical_page(PhysicalAddress, GlobalData&);
+
+    RefPtr<PhysicalRAMPage> try_allocate_physical_page_from_per_cpu_cache(ShouldZeroFill, MemoryType memory_type_for_zero_fill);
+    bool try_deallocate_physical_page_into_per_cpu_cache(PhysicalAddress);
+    size_t take_free_physical_pages_for_cache(Span<PhysicalAddress>);
+    void return_physical_pages_from_cache(ReadonlySpan<PhysicalAddress>);
+    size_t drain_per_cpu_page_caches();
 
     ALWAYS_INLINE u8* quickmap_page(PhysicalRAMPage& page, MemoryType memory_type = Memory::MemoryType::Normal)
     {
@@ -103,6 +103,22 @@ Vector<NonnullRefPtr<PhysicalRAMPage>> PhysicalRegion::take_contiguous_free_page
     return physical_pages;
 }
 
+Optional<PhysicalAddress> PhysicalRegion::take_free_huge_page()
+{
+    // NOTE: Only the large zones are big enough to hold a huge page.
+    for (auto& zone : m_usable_zones) {
+        auto page_base = zone.allocate_huge_page();
+        if (!page_base.has_value())
+            continue;
+        if (zone.is_empty()) {
+            // We've exhausted this zone, move it to the full zones list.
+            m_full_zones.append(zone);
+        }
+        return page_base;
+    }
+    return {};
+}
+
 RefPtr<PhysicalRAMPage> PhysicalRegion::take_free_page()
 {
     if (m_usable_zones.is_empty())
@@ -120,6 +136,23 @@ RefPtr<PhysicalRAMPage> PhysicalRegion::take_free_page()
     return PhysicalRAMPage::create(page.value());
 }
 
+size_t PhysicalRegion::take_free_pages(Span<PhysicalAddress> pages)
+{
+    size_t count = 0;
+    while (count < pages.size() && !m_usable_zones.is_empty()) {
+        auto& zone = *m_usable_zones.first();
+        auto page = zone.allocate_block(0);
+        VERIFY(page.has_value());
+        pages[count++] = page.value();
+
+        if (zone.is_empty()) {
+            // We've exhausted this zone, move it to the full zones list.
+            m_full_zones.append(zone);
+        }
+    }
+    return count;
+}
+
 void PhysicalRegion::return_page(PhysicalAddress paddr)
 {
     auto large_zone_base = lower().get();
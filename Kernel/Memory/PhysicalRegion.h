@@ -35,7 +35,9 @@ public:
     OwnPtr<PhysicalRegion> try_take_pages_from_beginning(size_t);
 
     RefPtr<PhysicalRAMPage> take_free_page();
+    size_t take_free_pages(Span<PhysicalAddress>);
     Vector<NonnullRefPtr<PhysicalRAMPage>> take_contiguous_free_pages(size_t count);
+    Optional<PhysicalAddress> take_free_huge_page();
     void return_page(PhysicalAddress);
 
 private:
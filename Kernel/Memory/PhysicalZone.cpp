@@ -64,6 +64,15 @@ Optional<PhysicalAddress> PhysicalZone::allocate_block(size_t order)
     return m_base_address.offset(result.value() * ZONE_CHUNK_SIZE);
 }
 
+Optional<PhysicalAddress> PhysicalZone::allocate_huge_page()
+{
+    // Blocks are only aligned to their size relative to the zone base,
+    // so a huge page is only physically aligned if the zone base is.
+    if (!can_allocate_huge_pages())
+        return {};
+    return allocate_block(HUGE_PAGE_ORDER);
+}
+
 Optional<PhysicalZone::ChunkIndex> PhysicalZone::allocate_block_impl(size_t order)
 {
     if (order > max_order)
@@ -24,11 +24,18 @@ public:
     static constexpr size_t ZONE_CHUNK_SIZE = PAGE_SIZE / 2;
     using ChunkIndex = i16;
 
+    // A huge page is a naturally aligned block of 512 contiguous pages (2 MiB).
+    static constexpr size_t HUGE_PAGE_ORDER = 9;
+    static constexpr size_t HUGE_PAGE_SIZE = PAGE_SIZE << HUGE_PAGE_ORDER;
+
     PhysicalZone(PhysicalAddress base, size_t page_count);
 
     Optional<PhysicalAddress> allocate_block(size_t order);
     void deallocate_block(PhysicalAddress, size_t order);
 
+    Optional<PhysicalAddress> allocate_huge_page();
+    bool can_allocate_huge_pages() const { return m_base_address.get() % HUGE_PAGE_SIZE == 0 && m_page_count >= HUGE_PAGE_SIZE / PAGE_SIZE; }
+
     void dump() const;
     size_t available() const { return m_page_count - (m_used_chunks / 2); }
 
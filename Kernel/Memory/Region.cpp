@@ -143,6 +143,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
     }
     clone_region->set_syscall_region(is_syscall_region());
     clone_region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
+    clone_region->set_wants_huge_pages(m_wants_huge_pages);
     return clone_region;
 }
 
@@ -509,6 +510,11 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
 
     auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
 
+    // NOTE: This is declared before the locker, so that an unused huge page is freed after the lock has been released.
+    Vector<RefPtr<PhysicalRAMPage>> huge_page;
+    if (m_wants_huge_pages && !m_shared)
+        (void)try_allocate_huge_page(page_index_in_region, anonymous_vmobject, huge_page);
+
     SpinlockLocker locker(anonymous_vmobject.m_lock);
 
     auto& page_slot = physical_page_slot(page_index_in_region);
@@ -528,6 +534,9 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     if (current_thread != nullptr)
         current_thread->did_zero_fault();
 
+    if (!huge_page.is_empty() && try_populate_huge_page(page_index_in_region, anonymous_vmobject, huge_page))
+        return PageFaultResponse::Continue;
+
     RefPtr<PhysicalRAMPage> new_physical_page;
 
     if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
@@ -559,6 +568,91 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     return PageFaultResponse::Continue;
 }
 
+Optional<size_t> Region::first_page_index_of_huge_page_chunk(size_t page_index_in_region) const
+{
+    // We can only back the faulting page with a huge page if the whole naturally aligned 2 MiB chunk around it lies within this region.
+    auto chunk_base = vaddr_from_page_index(page_index_in_region).get() & ~(PhysicalZone::HUGE_PAGE_SIZE - 1);
+    if (chunk_base < vaddr().get() || chunk_base + PhysicalZone::HUGE_PAGE_SIZE > vaddr().get() + size())
+        return {};
+    return (chunk_base - vaddr().get()) / PAGE_SIZE;
+}
+
+// Returns how many pages of the chunk are lazily committed, or nothing if any of them has already been faulted in.
+static Optional<size_t> count_lazy_committed_pages_in_unpopulated_chunk(Span<RefPtr<PhysicalRAMPage>> pages)
+{
+    size_t lazy_committed_page_count = 0;
+    for (auto& page : pages) {
+        if (page.is_null())
+            return {};
+        if (page->is_lazy_committed_page())
+            ++lazy_committed_page_count;
+        else if (!page->is_shared_zero_page())
+            return {};
+    }
+    return lazy_committed_page_count;
+}
+
+bool Region::try_allocate_huge_page(size_t page_index_in_region, AnonymousVMObject& anonymous_vmobject, Vector<RefPtr<PhysicalRAMPage>>& huge_page)
+{
+    constexpr size_t pages_per_huge_page = PhysicalZone::HUGE_PAGE_SIZE / PAGE_SIZE;
+
+    auto first_page_index_in_region = first_page_index_of_huge_page_chunk(page_index_in_region);
+    if (!first_page_index_in_region.has_value())
+        return false;
+
+    {
+        // Don't bother if any page in the chunk has already been faulted in, we'd have to throw it away.
+        SpinlockLocker locker(anonymous_vmobject.m_lock);
+        auto pages = anonymous_vmobject.physical_pages().slice(translate_to_vmobject_page(first_page_index_in_region.value()), pages_per_huge_page);
+        if (!count_lazy_committed_pages_in_unpopulated_chunk(pages).has_value())
+            return false;
+    }
+
+    // NOTE: Zeroing 2 MiB takes a while, so we have to do it before taking the VMObject lock for good, as holding that
+    //       keeps interrupts disabled. try_populate_huge_page() checks again whether the chunk is still unpopulated.
+    if (huge_page.try_resize(pages_per_huge_page).is_error())
+        return false;
+    if (MM.allocate_physical_huge_page(huge_page.span()).is_error()) {
+        huge_page.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Region::try_populate_huge_page(size_t page_index_in_region, AnonymousVMObject& anonymous_vmobject, Span<RefPtr<PhysicalRAMPage>> huge_page)
+{
+    VERIFY(anonymous_vmobject.m_lock.is_locked());
+
+    constexpr size_t pages_per_huge_page = PhysicalZone::HUGE_PAGE_SIZE / PAGE_SIZE;
+    VERIFY(huge_page.size() == pages_per_huge_page);
+
+    auto first_page_index_in_region = first_page_index_of_huge_page_chunk(page_index_in_region).value();
+    auto pages = anonymous_vmobject.physical_pages().slice(translate_to_vmobject_page(first_page_index_in_region), pages_per_huge_page);
+
+    // Another thread may have faulted in some of the chunk while we were allocating the huge page.
+    auto lazy_committed_page_count = count_lazy_committed_pages_in_unpopulated_chunk(pages);
+    if (!lazy_committed_page_count.has_value())
+        return false;
+
+    // The huge page was taken from the uncommitted pool, so give back what was committed for this chunk.
+    anonymous_vmobject.uncommit_committed_pages({}, lazy_committed_page_count.value());
+
+    for (size_t i = 0; i < pages_per_huge_page; ++i)
+        pages[i] = move(huge_page[i]);
+
+    auto chunk_base = vaddr_from_page_index(first_page_index_in_region);
+    dbgln_if(PAGE_FAULT_DEBUG, "      >> ALLOCATED HUGE PAGE {} for {}", pages[0]->paddr(), chunk_base);
+
+    // NOTE: If we fail to map some of the pages here, they will simply be mapped when they fault.
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    for (size_t i = 0; i < pages_per_huge_page; ++i) {
+        if (!map_individual_page_impl(first_page_index_in_region + i, pages[i], ShouldLockVMObject::No))
+            break;
+    }
+    MemoryManager::flush_tlb(m_page_directory, chunk_base, pages_per_huge_page);
+    return true;
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     auto current_thread = Thread::current();
@@ -85,6 +85,9 @@ public:
     [[nodiscard]] bool is_stack() const { return m_stack; }
     void set_stack(bool stack) { m_stack = stack; }
 
+    [[nodiscard]] bool wants_huge_pages() const { return m_wants_huge_pages; }
+    void set_wants_huge_pages(bool wants_huge_pages) { m_wants_huge_pages = wants_huge_pages; }
+
     [[nodiscard]] bool is_immutable() const { return m_immutable.was_set(); }
     void set_immutable() { m_immutable.set(); }
 
@@ -252,6 +255,9 @@ private:
     [[nodiscard]] PageFaultResponse handle_cow_fault(size_t page_index);
     [[nodiscard]] PageFaultResponse handle_inode_fault(size_t page_index, bool mark_page_dirty = false);
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index, PhysicalRAMPage& page_in_slot_at_time_of_fault);
+    [[nodiscard]] Optional<size_t> first_page_index_of_huge_page_chunk(size_t page_index) const;
+    [[nodiscard]] bool try_allocate_huge_page(size_t page_index, AnonymousVMObject&, Vector<RefPtr<PhysicalRAMPage>>& huge_page);
+    [[nodiscard]] bool try_populate_huge_page(size_t page_index, AnonymousVMObject&, Span<RefPtr<PhysicalRAMPage>> huge_page);
     [[nodiscard]] PageFaultResponse handle_inode_write_fault(size_t page_index);
 
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, ShouldLockVMObject);
@@ -272,6 +278,7 @@ private:
     bool m_stack : 1 { false };
     bool m_mmap : 1 { false };
     bool m_syscall_region : 1 { false };
+    bool m_wants_huge_pages : 1 { false };
     bool m_mmapped_from_readable : 1 { false };
     bool m_mmapped_from_writable : 1 { false };
 
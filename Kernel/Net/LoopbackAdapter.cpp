@@ -11,6 +11,10 @@ namespace Kernel {
 
 static bool s_loopback_initialized = false;
 
+bool g_loopback_drops_packets;
+// Dropping frames at a fixed interval keeps the tests that rely on this reproducible.
+static constexpr u32 dropped_frame_interval = 64;
+
 ErrorOr<NonnullRefPtr<LoopbackAdapter>> LoopbackAdapter::try_create()
 {
     return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) LoopbackAdapter("loop"sv)));
@@ -25,6 +29,8 @@ LoopbackAdapter::LoopbackAdapter(StringView interface_name)
     // so all packets are pre-pended with an Ethernet Frame header. Since the MTU must not include any overhead added
     // by the data-link (Ethernet in this case) or physical layers, we need to subtract it from the MTU.
     set_mtu(65536 - sizeof(EthernetFrameHeader));
+    // Packets sent over loopback never leave memory, so there is nothing for a checksum to protect against.
+    set_tcp_checksum_offload(true);
     set_mac_address({ 19, 85, 2, 9, 0x55, 0xaa });
 }
 
@@ -32,6 +38,10 @@ LoopbackAdapter::~LoopbackAdapter() = default;
 
 void LoopbackAdapter::send_raw(ReadonlyBytes payload)
 {
+    if (g_loopback_drops_packets && m_sent_frame_count.fetch_add(1, AK::memory_order_relaxed) % dropped_frame_interval == dropped_frame_interval - 1) {
+        dbgln_if(LOOPBACK_DEBUG, "LoopbackAdapter: Dropping {} byte(s).", payload.size());
+        return;
+    }
     dbgln_if(LOOPBACK_DEBUG, "LoopbackAdapter: Sending {} byte(s) to myself.", payload.size());
     did_receive(payload);
 }
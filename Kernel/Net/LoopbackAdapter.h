@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <Kernel/Net/NetworkAdapter.h>
 
 namespace Kernel {
@@ -26,6 +27,12 @@ public:
     virtual bool link_up() override { return true; }
     virtual bool link_full_duplex() override { return true; }
     virtual int link_speed() override { return 1000; }
+
+private:
+    Atomic<u32> m_sent_frame_count { 0 };
 };
 
+// For testing how the protocols deal with packet loss, see the loopback_drops_packets sysctl.
+extern bool g_loopback_drops_packets;
+
 }
@@ -99,6 +99,12 @@ public:
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
 
+    // If set, outgoing TCP packets only carry the pseudo-header checksum, and the adapter computes the full checksum.
+    bool has_tcp_checksum_offload() const { return m_has_tcp_checksum_offload; }
+    // If set, the adapter accepts IPv4 TCP packets larger than the MTU and splits them into MTU-sized segments itself.
+    bool has_tcp_segmentation_offload() const { return m_has_tcp_segmentation_offload; }
+    u32 maximum_ipv4_tcp_packet_size() const { return m_has_tcp_segmentation_offload ? NumericLimits<u16>::max() : m_mtu; }
+
     u32 packets_in() const { return m_packets_in; }
     u32 bytes_in() const { return m_bytes_in; }
     u32 packets_out() const { return m_packets_out; }
@@ -119,6 +125,8 @@ public:
 protected:
     NetworkAdapter(StringView);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
+    void set_tcp_checksum_offload(bool enabled) { m_has_tcp_checksum_offload = enabled; }
+    void set_tcp_segmentation_offload(bool enabled) { m_has_tcp_segmentation_offload = enabled; }
     void did_receive(ReadonlyBytes);
     virtual void send_raw(ReadonlyBytes) = 0;
     void autoconfigure_link_local_ipv6();
@@ -145,6 +153,8 @@ private:
     u32 m_packets_out { 0 };
     u32 m_bytes_out { 0 };
     u32 m_mtu { 1500 };
+    bool m_has_tcp_checksum_offload { false };
+    bool m_has_tcp_segmentation_offload { false };
     u32 m_packets_dropped { 0 };
 };
 
@@ -526,7 +526,7 @@ void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, Re
     rst_packet.set_ack_number(tcp_packet.sequence_number() + 1);
     rst_packet.set_data_offset(tcp_header_size / sizeof(u32));
     rst_packet.set_flags(TCPFlags::RST | TCPFlags::ACK);
-    rst_packet.set_checksum(TCPSocket::compute_tcp_checksum(ipv4_packet.source(), ipv4_packet.destination(), rst_packet, 0));
+    TCPSocket::fill_in_tcp_checksum(*routing_decision.adapter, ipv4_packet.destination(), ipv4_packet.source(), rst_packet, 0);
 
     routing_decision.adapter->send_packet(packet->bytes());
     routing_decision.adapter->release_packet_buffer(*packet);
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StdLibExtras.h>
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+void TCPCongestionControl::grow_congestion_window(size_t bytes)
+{
+    m_congestion_window = min<u64>(static_cast<u64>(m_congestion_window) + bytes, maximum_congestion_window);
+}
+
+void TCPCongestionControl::did_acknowledge_new_data(u32 ack_number, size_t acknowledged_bytes)
+{
+    m_duplicate_acks_received = 0;
+
+    if (m_in_time_out_recovery && !tcp_sequence_number_less_than(ack_number, m_recovery_point))
+        m_in_time_out_recovery = false;
+
+    if (m_in_fast_recovery) {
+        if (!tcp_sequence_number_less_than(ack_number, m_recovery_point)) {
+            // RFC 6582 (3.2, step 3): Full acknowledgment, deflate the window and leave fast recovery.
+            m_congestion_window = min(m_slow_start_threshold, static_cast<u32>(maximum_congestion_window));
+            m_in_fast_recovery = false;
+        } else {
+            // Partial acknowledgment: Deflate the window by the amount of new data acknowledged,
+            // then add back one segment for the segment we are about to retransmit.
+            m_congestion_window -= min<u32>(acknowledged_bytes, m_congestion_window);
+            grow_congestion_window(m_maximum_segment_size);
+        }
+        return;
+    }
+
+    if (m_congestion_window < m_slow_start_threshold) {
+        // RFC 5681 (3.1): Slow start.
+        grow_congestion_window(min<size_t>(acknowledged_bytes, m_maximum_segment_size));
+    } else {
+        // RFC 5681 (3.1): Congestion avoidance, grow by roughly one segment per round trip.
+        grow_congestion_window(max<u64>(1, static_cast<u64>(m_maximum_segment_size) * m_maximum_segment_size / m_congestion_window));
+    }
+}
+
+bool TCPCongestionControl::did_receive_duplicate_ack(size_t bytes_in_flight, u32 next_sequence_number)
+{
+    ++m_duplicate_acks_received;
+
+    if (m_in_fast_recovery) {
+        // RFC 6582 (3.2, step 4): Inflate the window for every additional segment that has left the network.
+        grow_congestion_window(m_maximum_segment_size);
+        return false;
+    }
+
+    if (m_duplicate_acks_received != duplicate_ack_threshold)
+        return false;
+
+    // RFC 6582 (4.1): Duplicate ACKs for segments that were sent before a timeout don't indicate a new loss.
+    if (m_in_time_out_recovery)
+        return false;
+
+    // RFC 5681 (3.2) and RFC 6582 (3.2, step 2): Fast retransmit, then enter fast recovery.
+    m_slow_start_threshold = max<u32>(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+    m_congestion_window = m_slow_start_threshold;
+    grow_congestion_window(duplicate_ack_threshold * m_maximum_segment_size);
+    m_in_fast_recovery = true;
+    m_recovery_point = next_sequence_number;
+    return true;
+}
+
+void TCPCongestionControl::did_time_out(size_t bytes_in_flight, u32 next_sequence_number)
+{
+    // RFC 5681 (3.1), equation (4): After a retransmission timeout, restart from slow start.
+    m_slow_start_threshold = max<u32>(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+    m_congestion_window = m_maximum_segment_size;
+    m_in_fast_recovery = false;
+    m_duplicate_acks_received = 0;
+    m_in_time_out_recovery = true;
+    m_recovery_point = next_sequence_number;
+}
+
+void TCPRetransmitTimer::did_measure_round_trip_time(Duration round_trip_time)
+{
+    // RFC 6298 (2.2) and (2.3), with alpha = 1/8 and beta = 1/4.
+    if (!m_has_round_trip_time_sample) {
+        m_smoothed_round_trip_time = round_trip_time;
+        m_round_trip_time_variance = Duration::from_nanoseconds(round_trip_time.to_nanoseconds() / 2);
+        m_has_round_trip_time_sample = true;
+    } else {
+        auto deviation = m_smoothed_round_trip_time.to_nanoseconds() - round_trip_time.to_nanoseconds();
+        if (deviation < 0)
+            deviation = -deviation;
+        m_round_trip_time_variance = Duration::from_nanoseconds((3 * m_round_trip_time_variance.to_nanoseconds() + deviation) / 4);
+        m_smoothed_round_trip_time = Duration::from_nanoseconds((7 * m_smoothed_round_trip_time.to_nanoseconds() + round_trip_time.to_nanoseconds()) / 8);
+    }
+
+    // NOTE: RFC 6298 recommends a lower bound of one second, but like most stacks in use today
+    //       we allow a smaller RTO so that losses on fast links are recovered from quickly.
+    auto retransmit_timeout = m_smoothed_round_trip_time + Duration::from_nanoseconds(4 * m_round_trip_time_variance.to_nanoseconds());
+    m_retransmit_timeout = clamp(retransmit_timeout, minimum_retransmit_timeout, maximum_retransmit_timeout);
+}
+
+void TCPRetransmitTimer::did_time_out(MonotonicTime now)
+{
+    if (!m_first_retransmit_time.has_value())
+        m_first_retransmit_time = now;
+
+    // RFC 6298 (5.5): Back off the timer.
+    m_retransmit_timeout = min(m_retransmit_timeout + m_retransmit_timeout, maximum_retransmit_timeout);
+}
+
+bool TCPRetransmitTimer::should_give_up(MonotonicTime now, bool is_connecting) const
+{
+    // RFC 1122 (4.2.3.5): We give up after retransmitting for some time rather than after a number of attempts,
+    // since the attempts get further apart as the timer backs off.
+    if (!m_first_retransmit_time.has_value())
+        return false;
+    auto maximum_duration = is_connecting ? maximum_connect_retransmit_duration : maximum_retransmit_duration;
+    return now - m_first_retransmit_time.value() >= maximum_duration;
+}
+
+}
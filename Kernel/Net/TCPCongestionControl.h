@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Sequence numbers wrap around, so they have to be compared modulo 2^32 (RFC 793, 3.3).
+constexpr bool tcp_sequence_number_less_than(u32 a, u32 b) { return static_cast<i32>(a - b) < 0; }
+constexpr bool tcp_sequence_number_less_than_or_equal(u32 a, u32 b) { return static_cast<i32>(a - b) <= 0; }
+
+// RFC 5681: TCP Congestion Control, RFC 6582: The NewReno Modification to TCP's Fast Recovery Algorithm
+// This only keeps track of the congestion window, TCPSocket decides what to (re)send with it.
+class TCPCongestionControl {
+public:
+    static constexpr u32 duplicate_ack_threshold = 3;
+    // RFC 6928: Increasing TCP's Initial Window
+    static constexpr u32 initial_congestion_window = 14600;
+    // The largest window a peer can advertise with window scaling (RFC 7323, 2.3). The congestion window is never
+    // useful beyond that, and capping it keeps it from wrapping around on long transfers without any loss.
+    static constexpr u32 maximum_congestion_window = 1 * GiB;
+
+    u32 maximum_segment_size() const { return m_maximum_segment_size; }
+    void set_maximum_segment_size(u32 maximum_segment_size) { m_maximum_segment_size = maximum_segment_size; }
+
+    u32 congestion_window() const { return m_congestion_window; }
+    u32 slow_start_threshold() const { return m_slow_start_threshold; }
+    u32 duplicate_acks_received() const { return m_duplicate_acks_received; }
+    bool is_in_fast_recovery() const { return m_in_fast_recovery; }
+    // After a retransmission timeout, the segments up to the recovery point are resent as the congestion window opens.
+    bool is_in_time_out_recovery() const { return m_in_time_out_recovery; }
+    u32 recovery_point() const { return m_recovery_point; }
+
+    void did_acknowledge_new_data(u32 ack_number, size_t acknowledged_bytes);
+    // Returns true if the first unacknowledged segment should be retransmitted right away.
+    bool did_receive_duplicate_ack(size_t bytes_in_flight, u32 next_sequence_number);
+    void did_time_out(size_t bytes_in_flight, u32 next_sequence_number);
+    void did_acknowledge_everything() { m_in_time_out_recovery = false; }
+
+private:
+    void grow_congestion_window(size_t bytes);
+
+    u32 m_maximum_segment_size { 536 };
+    u32 m_congestion_window { initial_congestion_window };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+    u32 m_duplicate_acks_received { 0 };
+    bool m_in_fast_recovery { false };
+    bool m_in_time_out_recovery { false };
+    u32 m_recovery_point { 0 };
+};
+
+// RFC 6298: Computing TCP's Retransmission Timer
+class TCPRetransmitTimer {
+public:
+    static constexpr Duration initial_retransmit_timeout = Duration::from_seconds(1);
+    static constexpr Duration minimum_retransmit_timeout = Duration::from_milliseconds(200);
+    static constexpr Duration maximum_retransmit_timeout = Duration::from_seconds(60);
+    // RFC 1122 (4.2.3.5): R2 has to correspond to at least 100 seconds, and to at least 3 minutes for a SYN.
+    static constexpr Duration maximum_retransmit_duration = Duration::from_seconds(100);
+    static constexpr Duration maximum_connect_retransmit_duration = Duration::from_seconds(180);
+
+    Duration retransmit_timeout() const { return m_retransmit_timeout; }
+    Duration smoothed_round_trip_time() const { return m_smoothed_round_trip_time; }
+
+    void did_measure_round_trip_time(Duration round_trip_time);
+    void did_acknowledge_new_data() { m_first_retransmit_time.clear(); }
+    void did_time_out(MonotonicTime now);
+    bool should_give_up(MonotonicTime now, bool is_connecting) const;
+
+private:
+    bool m_has_round_trip_time_sample { false };
+    Duration m_smoothed_round_trip_time;
+    Duration m_round_trip_time_variance;
+    Duration m_retransmit_timeout { initial_retransmit_timeout };
+    // When we first had to retransmit since data was last acknowledged.
+    Optional<MonotonicTime> m_first_retransmit_time;
+};
+
+}
@@ -233,8 +233,16 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    m_congestion_control.set_maximum_segment_size(mss);
 
-    data_length = min(data_length, mss);
+    // Never send more than both the peer and the network can take, see can_write().
+    auto usable_window = usable_send_window();
+    if (usable_window == 0)
+        return EAGAIN;
+
+    // With segmentation offload, we can hand the adapter one large segment instead of many MSS-sized ones.
+    size_t maximum_segment_size = routing_decision.adapter->maximum_ipv4_tcp_packet_size() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    data_length = min(data_length, min(maximum_segment_size, usable_window));
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -313,13 +321,17 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     if ((options_size % 4) != 0)
         *next_option = to_underlying(TCPOptionKind::End);
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    fill_in_tcp_checksum(*routing_decision.adapter, local_address(), peer_address(), tcp_packet, payload_size);
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            auto now = TimeManagement::the().monotonic_time();
+            // RFC 6298 (5.1): Start the retransmission timer if it isn't already running.
+            if (unacked_packets.packets.is_empty())
+                m_last_retransmit_time = now;
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, now });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
@@ -348,23 +360,45 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
+        // RFC 793 (3.9): Only take the window from segments that are newer than the one it was last taken from,
+        //              so that a reordered old segment can't shrink it.
+        auto sequence_number = packet.sequence_number();
+        if (!m_has_send_window_update || packet.has_syn()
+            || tcp_sequence_number_less_than(m_send_window_update_sequence_number, sequence_number)
+            || (m_send_window_update_sequence_number == sequence_number && tcp_sequence_number_less_than_or_equal(m_send_window_update_ack_number, ack_number))) {
+            m_has_send_window_update = true;
+            m_send_window_update_sequence_number = sequence_number;
+            m_send_window_update_ack_number = ack_number;
+
+            // The window in a SYN segment is never scaled (RFC 7323, 2.2).
+            auto send_window_size = packet.has_syn() ? packet.window_size() : packet.window_size() << m_send_window_scale;
+            if (m_send_window_size != send_window_size) {
+                m_send_window_size = send_window_size;
+                evaluate_block_conditions();
+            }
+        }
+
+        auto now = TimeManagement::the().monotonic_time();
+        Optional<Duration> round_trip_time;
+        size_t acknowledged_bytes = 0;
+
         int removed = 0;
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
             while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
+                auto& unacked_packet = unacked_packets.packets.first();
 
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", unacked_packet.ack_number);
 
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
+                if (tcp_sequence_number_less_than_or_equal(unacked_packet.ack_number, ack_number)) {
+                    auto old_adapter = unacked_packet.adapter.strong_ref();
                     if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    if (m_send_window_size != tcp_packet.window_size()) {
-                        m_send_window_size = tcp_packet.window_size() << m_send_window_scale;
-                    }
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
+                        old_adapter->release_packet_buffer(*unacked_packet.buffer);
+                    auto payload_size = outgoing_packet_payload_size(unacked_packet);
                     unacked_packets.size -= payload_size;
+                    acknowledged_bytes += payload_size;
+                    // Karn's algorithm: Only segments that were never retransmitted yield unambiguous RTT samples.
+                    if (unacked_packet.tx_counter == 0)
+                        round_trip_time = now - unacked_packet.sent_time;
                     evaluate_block_conditions();
                     unacked_packets.packets.take_first();
                     removed++;
@@ -373,19 +407,62 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
                 }
             }
 
+            if (removed > 0) {
+                if (round_trip_time.has_value())
+                    m_retransmit_timer.did_measure_round_trip_time(round_trip_time.value());
+                // RFC 6298 (5.3): Restart the retransmission timer when new data is acknowledged.
+                m_last_retransmit_time = now;
+                m_retransmit_timer.did_acknowledge_new_data();
+                m_congestion_control.did_acknowledge_new_data(ack_number, acknowledged_bytes);
+                if (m_congestion_control.is_in_time_out_recovery()) {
+                    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+                    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+                    if (!routing_decision.is_zero())
+                        retransmit_after_time_out(unacked_packets, routing_decision);
+                } else if (m_congestion_control.is_in_fast_recovery() && !unacked_packets.packets.is_empty()) {
+                    // RFC 6582 (3.2, step 3): A partial acknowledgment means the next segment was lost as well.
+                    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+                    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+                    if (!routing_decision.is_zero())
+                        retransmit_packet(unacked_packets.packets.first(), routing_decision);
+                }
+            } else if (ack_number == m_last_ack_number_received && size == packet.header_size()
+                && !packet.has_syn() && !packet.has_fin() && !unacked_packets.packets.is_empty()) {
+                auto should_retransmit = m_congestion_control.did_receive_duplicate_ack(m_sequence_number - m_last_ack_number_received, m_sequence_number);
+                // A duplicate ACK during fast recovery inflates the congestion window, which may let us send again.
+                evaluate_block_conditions();
+                if (should_retransmit) {
+                    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: {} duplicate ACKs, fast retransmitting {}", m_congestion_control.duplicate_acks_received(), ack_number);
+                    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+                    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+                    if (!routing_decision.is_zero())
+                        retransmit_packet(unacked_packets.packets.first(), routing_decision);
+                }
+            }
+
             if (unacked_packets.packets.is_empty()) {
-                m_retransmit_attempts = 0;
+                m_congestion_control.did_acknowledge_everything();
+                m_retransmit_timer.did_acknowledge_new_data();
                 dequeue_for_retransmit();
             }
 
             dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
         });
+
+        if (tcp_sequence_number_less_than(m_last_ack_number_received, ack_number))
+            m_last_ack_number_received = ack_number;
     }
 
     m_packets_in++;
     m_bytes_in += packet.header_size() + size;
 }
 
+size_t TCPSocket::outgoing_packet_payload_size(OutgoingPacket const& packet)
+{
+    auto const& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+    return packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8 const*)tcp_packet.payload();
+}
+
 bool TCPSocket::should_delay_next_ack() const
 {
     // FIXME: We don't know the MSS here so make a reasonable guess.
@@ -402,7 +479,7 @@ bool TCPSocket::should_delay_next_ack() const
     return true;
 }
 
-NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size)
+static u32 compute_tcp_pseudo_header_checksum(IPv4Address const& source, IPv4Address const& destination, u16 tcp_packet_size)
 {
     union PseudoHeader {
         struct [[gnu::packed]] {
@@ -416,11 +493,7 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
     };
     static_assert(sizeof(PseudoHeader) == 12);
 
-    Checked<u16> packet_size = packet.header_size();
-    packet_size += payload_size;
-    VERIFY(!packet_size.has_overflow());
-
-    PseudoHeader pseudo_header { .header = { source, destination, 0, (u8)TransportProtocol::TCP, packet_size.value() } };
+    PseudoHeader pseudo_header { .header = { source, destination, 0, (u8)TransportProtocol::TCP, tcp_packet_size } };
 
     u32 checksum = 0;
     auto* raw_pseudo_header = pseudo_header.raw;
@@ -429,6 +502,31 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
         if (checksum > 0xffff)
             checksum = (checksum >> 16) + (checksum & 0xffff);
     }
+    return checksum;
+}
+
+void TCPSocket::fill_in_tcp_checksum(NetworkAdapter const& adapter, IPv4Address const& source, IPv4Address const& destination, TCPPacket& packet, u16 payload_size)
+{
+    packet.set_checksum(0);
+    if (!adapter.has_tcp_checksum_offload()) {
+        packet.set_checksum(compute_tcp_checksum(source, destination, packet, payload_size));
+        return;
+    }
+
+    // The adapter will sum up the TCP header and payload on top of this, and store the complement.
+    Checked<u16> packet_size = packet.header_size();
+    packet_size += payload_size;
+    VERIFY(!packet_size.has_overflow());
+    packet.set_checksum(compute_tcp_pseudo_header_checksum(source, destination, packet_size.value()));
+}
+
+NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size)
+{
+    Checked<u16> packet_size = packet.header_size();
+    packet_size += payload_size;
+    VERIFY(!packet_size.has_overflow());
+
+    u32 checksum = compute_tcp_pseudo_header_checksum(source, destination, packet_size.value());
     auto* raw_packet = bit_cast<u16*>(&packet);
     for (size_t i = 0; i < packet.header_size() / sizeof(u16); ++i) {
         checksum += AK::convert_between_host_and_network_endian(raw_packet[i]);
@@ -674,21 +772,16 @@ void TCPSocket::retransmit_packets()
 {
     auto now = TimeManagement::the().monotonic_time();
 
-    // RFC6298 says we should have at least one second between retransmits. According to
-    // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
-
-    if (m_last_retransmit_time > now - Duration::from_seconds(retransmit_interval))
+    // The retransmit timeout is estimated from the round trip time as per RFC 6298, and backed off
+    // exponentially on every timeout. According to RFC1122 we must do this even for SYN packets.
+    if (m_last_retransmit_time > now - m_retransmit_timer.retransmit_timeout())
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
 
     m_last_retransmit_time = now;
-    ++m_retransmit_attempts;
 
-    if (m_retransmit_attempts > maximum_retransmits) {
+    if (m_retransmit_timer.should_give_up(now, m_state == State::SynSent || m_state == State::SynReceived)) {
         set_state(TCPSocket::State::Closed);
         set_error(TCPSocket::Error::RetransmitTimeout);
         set_setup_state(Socket::SetupState::Completed);
@@ -701,56 +794,134 @@ void TCPSocket::retransmit_packets()
         return;
 
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-        for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
-            }
+        m_retransmit_timer.did_time_out(now);
+        m_congestion_control.did_time_out(unacked_packets.size, m_sequence_number);
+        m_retransmitted_until = m_last_ack_number_received;
+        retransmit_after_time_out(unacked_packets, routing_decision);
+    });
+}
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+void TCPSocket::retransmit_after_time_out(UnackedPackets& unacked_packets, RoutingDecision const& routing_decision)
+{
+    // RFC 5681 (3.1): The congestion window is one segment after a timeout, so we start by resending the first
+    // unacknowledged segment only. Every ACK after that opens the window and lets us resend some more.
+    size_t bytes_in_flight = 0;
+    for (auto& packet : unacked_packets.packets) {
+        if (tcp_sequence_number_less_than(m_congestion_control.recovery_point(), packet.ack_number))
+            break;
+        auto payload_size = outgoing_packet_payload_size(packet);
+        if (!tcp_sequence_number_less_than(m_retransmitted_until, packet.ack_number)) {
+            bytes_in_flight += payload_size;
+            continue;
+        }
+        if (bytes_in_flight > 0 && bytes_in_flight + payload_size > m_congestion_control.congestion_window())
+            break;
+        retransmit_packet(packet, routing_decision);
+        bytes_in_flight += payload_size;
+        m_retransmitted_until = packet.ack_number;
+    }
+}
+
+void TCPSocket::retransmit_packet(OutgoingPacket& packet, RoutingDecision const& routing_decision)
+{
+    packet.tx_counter++;
 
-            auto packet_buffer = packet.buffer->bytes();
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
+
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+
+    if (packet_buffer.size() - routing_decision.adapter->layer3_payload_offset() > routing_decision.adapter->maximum_ipv4_tcp_packet_size()) {
+        // The packet was built for an adapter with segmentation offload, but the route has changed since.
+        retransmit_packet_in_segments(packet, routing_decision);
+        return;
+    }
+
+    // NOTE: The route may have changed since the packet was built, and the new adapter may not offload checksums.
+    auto& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+    auto payload_size = packet_buffer.size() - packet.ipv4_payload_offset - tcp_packet.header_size();
+    fill_in_tcp_checksum(*routing_decision.adapter, local_address(), peer_address(), tcp_packet, payload_size);
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                TransportProtocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        TransportProtocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    routing_decision.adapter->send_packet(packet_buffer);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
+}
+
+void TCPSocket::retransmit_packet_in_segments(OutgoingPacket const& packet, RoutingDecision const& routing_decision)
+{
+    auto& adapter = *routing_decision.adapter;
+    auto const& original_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+    auto const* payload = (u8 const*)original_packet.payload();
+    auto payload_size = outgoing_packet_payload_size(packet);
+    size_t header_size = original_packet.header_size();
+    size_t segment_size = adapter.maximum_ipv4_tcp_packet_size() - sizeof(IPv4Packet) - header_size;
+    auto ipv4_payload_offset = adapter.ipv4_payload_offset();
+
+    // NOTE: The segments are only sent, the original packet stays in the retransmit queue until all of it is acknowledged.
+    for (size_t offset = 0; offset < payload_size; offset += segment_size) {
+        auto size = min(segment_size, payload_size - offset);
+        auto segment = adapter.acquire_packet_buffer(ipv4_payload_offset + header_size + size);
+        if (!segment) {
+            dbgln("TCPSocket({}): Out of packet buffers while retransmitting over {}", this, adapter.name());
+            return;
         }
-    });
+
+        auto& tcp_packet = *(TCPPacket*)(segment->buffer->data() + ipv4_payload_offset);
+        memcpy(&tcp_packet, &original_packet, header_size);
+        memcpy(tcp_packet.payload(), payload + offset, size);
+        tcp_packet.set_sequence_number(original_packet.sequence_number() + offset);
+        if (offset + size < payload_size)
+            tcp_packet.set_flags(original_packet.flags() & ~(TCPFlags::PSH | TCPFlags::FIN));
+        fill_in_tcp_checksum(adapter, local_address(), peer_address(), tcp_packet, size);
+
+        adapter.fill_in_ipv4_header(*segment, local_address(), routing_decision.next_hop, peer_address(),
+            TransportProtocol::TCP, header_size + size, type_of_service(), ttl());
+        adapter.send_packet(segment->bytes());
+        m_packets_out++;
+        m_bytes_out += segment->bytes().size();
+        adapter.release_packet_buffer(*segment);
+    }
 }
 
-bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
+bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 offset) const
 {
-    if (!IPv4Socket::can_write(file_description, size))
+    if (!IPv4Socket::can_write(file_description, offset))
         return false;
 
     if (m_state == State::SynSent || m_state == State::SynReceived)
         return false;
 
-    if (!file_description.is_blocking())
-        return true;
+    // Never have more data in flight than both the peer and the network can take.
+    return usable_send_window() > 0;
+}
 
-    return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+size_t TCPSocket::usable_send_window() const
+{
+    size_t window_size = min(m_send_window_size, m_congestion_control.congestion_window());
+    return m_unacked_packets.with_shared([&](auto& unacked_packets) -> size_t {
+        return unacked_packets.size < window_size ? window_size - unacked_packets.size : 0;
     });
 }
 }
@@ -15,6 +15,7 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IP/Socket.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 #include <Kernel/Time/TimerQueue.h>
 
 namespace Kernel {
@@ -167,11 +168,16 @@ public:
 
     void retransmit_packets();
 
+    u32 congestion_window() const { return m_congestion_control.congestion_window(); }
+    Duration smoothed_round_trip_time() const { return m_retransmit_timer.smoothed_round_trip_time(); }
+    Duration retransmit_timeout() const { return m_retransmit_timer.retransmit_timeout(); }
+
     virtual ErrorOr<void> close() override;
 
     virtual bool can_write(OpenFileDescription const&, u64) const override;
 
     static NetworkOrdered<u16> compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const&, u16 payload_size);
+    static void fill_in_tcp_checksum(NetworkAdapter const&, IPv4Address const& source, IPv4Address const& destination, TCPPacket&, u16 payload_size);
 
     virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
@@ -198,6 +204,14 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    struct OutgoingPacket;
+    struct UnackedPackets;
+    void retransmit_packet(OutgoingPacket&, RoutingDecision const&);
+    void retransmit_packet_in_segments(OutgoingPacket const&, RoutingDecision const&);
+    void retransmit_after_time_out(UnackedPackets&, RoutingDecision const&);
+    static size_t outgoing_packet_payload_size(OutgoingPacket const&);
+    size_t usable_send_window() const;
+
     static constexpr size_t receive_window_scale()
     {
         auto buffer_size_bit_length = AK::log2(receive_buffer_size) + 1;
@@ -224,6 +238,7 @@ private:
         RefPtr<PacketWithTimestamp> buffer;
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
+        MonotonicTime sent_time;
         int tx_counter { 0 };
     };
 
@@ -241,14 +256,21 @@ private:
 
     static constexpr Duration maximum_segment_lifetime = Duration::from_seconds(120);
 
-    // FIXME: Make this configurable (sysctl)
-    static constexpr u32 maximum_retransmits = 5;
     MonotonicTime m_last_retransmit_time;
-    u32 m_retransmit_attempts { 0 };
+    TCPRetransmitTimer m_retransmit_timer;
+
+    TCPCongestionControl m_congestion_control;
+    u32 m_last_ack_number_received { 0 };
+    // After a retransmission timeout, the segments up to the recovery point are resent as the congestion window opens.
+    u32 m_retransmitted_until { 0 };
 
     // Default to maximum window size. receive_tcp_packet() will update from the
     // peer's advertised window size.
     u32 m_send_window_size { 64 * KiB };
+    // SND.WL1 and SND.WL2 from RFC 793: The sequence and acknowledgment numbers of the segment the window was taken from.
+    bool m_has_send_window_update { false };
+    u32 m_send_window_update_sequence_number { 0 };
+    u32 m_send_window_update_ack_number { 0 };
     bool m_window_scaling_supported { false };
     size_t m_send_window_scale { 0 };
 
@@ -7,6 +7,7 @@
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/TCP.h>
 #include <Kernel/Net/VirtIO/VirtIONetworkAdapter.h>
 
 namespace Kernel {
@@ -48,8 +49,8 @@ static constexpr u16 VIRTIO_NET_S_LINK_UP = 1;
 static constexpr u16 VIRTIO_NET_S_ANNOUNCE = 2;
 
 static constexpr u8 VIRTIO_NET_HDR_F_NEEDS_CSUM = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 1;
+static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 2;
+static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 4;
 static constexpr u8 VIRTIO_NET_HDR_GSO_NONE = 0;
 static constexpr u8 VIRTIO_NET_HDR_GSO_TCPV4 = 1;
 static constexpr u8 VIRTIO_NET_HDR_GSO_UDP = 3;
@@ -84,6 +85,8 @@ struct [[gnu::packed]] VirtIONetHdr {
 
 using namespace VirtIO;
 
+static constexpr u16 TCP_CHECKSUM_OFFSET = 16; // Offset of the checksum field within the TCP header.
+
 static constexpr u16 RECEIVEQ = 0;
 static constexpr u16 TRANSMITQ = 1;
 
@@ -137,9 +140,20 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
             negotiated |= VIRTIO_NET_F_SPEED_DUPLEX;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MTU))
             negotiated |= VIRTIO_NET_F_MTU;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CSUM)) {
+            negotiated |= VIRTIO_NET_F_CSUM;
+            // Segmentation offload requires checksum offload.
+            if (is_feature_set(supported_features, VIRTIO_NET_F_HOST_TSO4))
+                negotiated |= VIRTIO_NET_F_HOST_TSO4;
+        }
+        // NOTE: We don't negotiate VIRTIO_NET_F_GUEST_CSUM, as incoming packets are handed to raw and packet sockets
+        //       as they are, so they have to arrive with their checksums completed.
         return negotiated;
     }));
 
+    set_tcp_checksum_offload(is_feature_accepted(VIRTIO_NET_F_CSUM));
+    set_tcp_segmentation_offload(is_feature_accepted(VIRTIO_NET_F_HOST_TSO4));
+
     TRY(handle_device_config_change());
     TRY(setup_queues(2)); // receive & transmit
 
@@ -234,6 +248,38 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
     }
 }
 
+static void fill_in_offload_header(NetworkAdapter const& adapter, VirtIONetHdr& hdr, ReadonlyBytes frame)
+{
+    if (!adapter.has_tcp_checksum_offload())
+        return;
+
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return;
+    auto const& ethernet = *reinterpret_cast<EthernetFrameHeader const*>(frame.data());
+    if (ethernet.ether_type() != EtherType::IPv4)
+        return;
+    auto const& ipv4 = *reinterpret_cast<IPv4Packet const*>(ethernet.payload());
+    if (ipv4.protocol() != to_underlying(TransportProtocol::TCP))
+        return;
+
+    size_t tcp_offset = sizeof(EthernetFrameHeader) + ipv4.internet_header_length() * sizeof(u32);
+    if (frame.size() < tcp_offset + sizeof(TCPPacket))
+        return;
+    auto const& tcp = *reinterpret_cast<TCPPacket const*>(frame.offset(tcp_offset));
+
+    // The TCP stack has only put the pseudo-header checksum into the packet, the device sums up the rest.
+    hdr.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+    hdr.csum_start = tcp_offset;
+    hdr.csum_offset = TCP_CHECKSUM_OFFSET;
+
+    size_t headers_size = tcp_offset + tcp.header_size();
+    if (adapter.has_tcp_segmentation_offload() && frame.size() - sizeof(EthernetFrameHeader) > adapter.mtu()) {
+        hdr.gso_type = VIRTIO_NET_HDR_GSO_TCPV4;
+        hdr.hdr_len = headers_size;
+        hdr.gso_size = adapter.mtu() - (headers_size - sizeof(EthernetFrameHeader));
+    }
+}
+
 static bool copy_data_to_chain(VirtIO::QueueChain& chain, Memory::RingBuffer& ring, u8 const* data, size_t length)
 {
     UserOrKernelBuffer buf = UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>(data));
@@ -270,6 +316,7 @@ void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
 
     // FIXME: Handle errors from pushing to the chain and rewind the RingBuffer.
     VirtIONetHdr hdr {};
+    fill_in_offload_header(*this, hdr, payload);
     VERIFY(copy_data_to_chain(chain, *m_tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
     VERIFY(copy_data_to_chain(chain, *m_tx_buffers, payload.data(), payload.size()));
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/POSIX/serenity.h>
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$create_event_queue(u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EVENT_QUEUE_CLOEXEC)
+        return EINVAL;
+
+    auto event_queue = TRY(EventQueue::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(event_queue)));
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & EVENT_QUEUE_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$event_queue_ctl(Userspace<Syscall::SC_event_queue_ctl_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto queue_description = TRY(open_file_description(params.queue_fd));
+    if (!queue_description->is_event_queue())
+        return EBADF;
+    auto* event_queue = queue_description->event_queue();
+    event_queue_event event;
+    TRY(copy_from_user(&event, params.event));
+
+    switch (params.operation) {
+    case EVENT_QUEUE_CTL_ADD: {
+        auto description = TRY(open_file_description(params.fd));
+        TRY(event_queue->add(event.id, params.fd, move(description), event.events, event.flags));
+        return 0;
+    }
+    case EVENT_QUEUE_CTL_MODIFY:
+        TRY(event_queue->modify(event.id, event.events, event.flags));
+        return 0;
+    case EVENT_QUEUE_CTL_REMOVE:
+        TRY(event_queue->remove(event.id));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$event_queue_wait(Userspace<Syscall::SC_event_queue_wait_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.max_events == 0 || params.max_events >= OpenFileDescriptions::max_open())
+        return EINVAL;
+
+    Thread::BlockTimeout timeout;
+    bool should_block = true;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        timeout = Thread::BlockTimeout(false, &timeout_time);
+        should_block = !timeout_time.is_zero();
+    }
+
+    auto queue_description = TRY(open_file_description(params.queue_fd));
+    if (!queue_description->is_event_queue())
+        return EBADF;
+
+    Vector<event_queue_event> events;
+    TRY(queue_description->event_queue()->wait(events, params.max_events, timeout, should_block));
+
+    if (!events.is_empty())
+        TRY(copy_n_to_user(params.events, events.data(), events.size()));
+    return events.size();
+}
+
+}
@@ -377,6 +377,13 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
             TRY(vmobject.set_volatile(advice == MADV_SET_VOLATILE, was_purged));
             return was_purged ? 1 : 0;
         }
+        if (advice == MADV_HUGEPAGE || advice == MADV_NOHUGEPAGE) {
+            // NOTE: This only affects pages that haven't been faulted in yet.
+            if (!region->vmobject().is_anonymous() || region->is_shared())
+                return EINVAL;
+            region->set_wants_huge_pages(advice == MADV_HUGEPAGE);
+            return 0;
+        }
         return EINVAL;
     });
 }
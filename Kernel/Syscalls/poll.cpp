@@ -26,9 +26,11 @@ ErrorOr<FlatPtr> Process::sys$poll(Userspace<Syscall::SC_poll_params const*> use
         return ENOBUFS;
 
     Thread::BlockTimeout timeout;
+    bool should_block = true;
     if (params.timeout) {
         auto timeout_time = TRY(copy_time_from_user(params.timeout));
         timeout = Thread::BlockTimeout(false, &timeout_time);
+        should_block = !timeout_time.is_zero();
     }
 
     sigset_t sigmask = {};
@@ -84,8 +86,26 @@ ErrorOr<FlatPtr> Process::sys$poll(Userspace<Syscall::SC_poll_params const*> use
     if constexpr (IO_DEBUG || POLL_SELECT_DEBUG)
         dbgln("polling on {} fds, timeout={}", fds_info.size(), params.timeout);
 
-    if (current_thread->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted())
+    // NOTE: A poll with a zero timeout never blocks, which is how busy event loops check for more work.
+    //       There's no point in taking the scheduler lock and registering with (and immediately unregistering
+    //       from) the blocker set of every fd in that case, so we just collect the flags of the ready fds.
+    //       Like block() would, we only report a pending signal if no fd is ready.
+    if (!should_block) {
+        bool any_fd_is_ready = false;
+        for (auto& fds_entry : fds_info) {
+            if (!fds_entry.description) {
+                any_fd_is_ready = true;
+                continue;
+            }
+            fds_entry.unblocked_flags = fds_entry.description->should_unblock(fds_entry.block_flags);
+            if (fds_entry.unblocked_flags != BlockFlags::None)
+                any_fd_is_ready = true;
+        }
+        if (!any_fd_is_ready && current_thread->has_unmasked_pending_signals())
+            return EINTR;
+    } else if (current_thread->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted()) {
         return EINTR;
+    }
 
     int fds_with_revents = 0;
 
@@ -13,6 +13,7 @@
 namespace Kernel {
 
 bool g_profiling_all_threads;
+bool g_profile_continuously;
 PerformanceEventBuffer* g_global_perf_events;
 u64 g_profiling_event_mask;
 
@@ -44,9 +45,11 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
                 return ENOMEM;
             }
         }
+        g_global_perf_events->set_ring_buffer(g_profile_continuously);
 
         SpinlockLocker lock(g_profiling_lock);
-        if (!TimeManagement::the().enable_profile_timer())
+        auto ticks_per_second = g_profile_continuously ? CONTINUOUS_PROFILE_TICKS_PER_SECOND_RATE : OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE;
+        if (!TimeManagement::the().enable_profile_timer(ticks_per_second))
             return ENOTSUP;
         g_profiling_all_threads = true;
         PerformanceManager::add_process_created_event(*Scheduler::colonel());
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// NOTE: This is the largest amount of data we move through the bounce buffer at once.
+//       It matches the default send buffer size of our TCP sockets, so a single chunk
+//       can usually be handed to a socket without blocking.
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+static ErrorOr<void> wait_until_writable(OpenFileDescription& description, bool should_block)
+{
+    while (!description.can_write()) {
+        if (!should_block)
+            return EAGAIN;
+        auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+        if (Thread::current()->block<Thread::WriteBlocker>({}, description, unblock_flags).was_interrupted())
+            return EINTR;
+    }
+    return {};
+}
+
+ErrorOr<FlatPtr> Process::sys$sendfile(int out_fd, int in_fd, Userspace<off_t*> userspace_offset, size_t count)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    if (count == 0)
+        return 0;
+    if (count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$sendfile({}, {}, {}, {})", out_fd, in_fd, userspace_offset.ptr(), count);
+
+    auto in_description = TRY(open_file_description(in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+
+    auto out_description = TRY(open_file_description(out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    // NOTE: If an offset is given, we read from there and leave the file offset of in_fd alone (like pread).
+    //       Otherwise, we read from (and advance) the current file offset of in_fd.
+    Optional<off_t> offset;
+    if (userspace_offset.ptr()) {
+        if (!in_description->file().is_seekable())
+            return ESPIPE;
+        off_t initial_offset;
+        TRY(copy_from_user(&initial_offset, userspace_offset));
+        if (initial_offset < 0)
+            return EINVAL;
+        offset = initial_offset;
+    }
+
+    if (in_description->is_blocking() && !in_description->can_read()) {
+        auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+        if (Thread::current()->block<Thread::ReadBlocker>({}, *in_description, unblock_flags).was_interrupted())
+            return EINTR;
+        if (!has_flag(unblock_flags, Thread::FileBlocker::BlockFlags::Read))
+            return EAGAIN;
+    }
+
+    // The data never leaves the kernel: each chunk is read from in_fd straight into a kernel
+    // bounce buffer and handed to out_fd from there, without copying through userspace.
+    auto chunk = TRY(KBuffer::try_create_with_size("sendfile"sv, min(count, sendfile_chunk_size), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+    auto chunk_buffer = UserOrKernelBuffer::for_kernel_buffer(chunk->data());
+
+    // NOTE: Bytes that were read but not written have to go back to the source. That's only possible if we can
+    //       seek in it; bytes read from a pipe or a socket are gone, so once we've read them, we deliver all of them.
+    bool can_rewind_source = offset.has_value() || in_description->file().is_seekable();
+
+    // Bytes read from a source that can't be rewound would be lost if they weren't written, so this waits for the
+    // destination to accept all of them, even if it's non-blocking. Only an error or a signal can make it return early.
+    auto write_all_read_bytes = [this](OpenFileDescription& description, UserOrKernelBuffer const& data, size_t size) -> ErrorOr<FlatPtr> {
+        size_t total_nwritten = 0;
+        while (total_nwritten < size) {
+            auto nwritten_or_error = do_write(description, data.offset(total_nwritten), size - total_nwritten);
+            if (nwritten_or_error.is_error()) {
+                if (nwritten_or_error.error().code() != EAGAIN) {
+                    if (total_nwritten > 0)
+                        return total_nwritten;
+                    return nwritten_or_error.release_error();
+                }
+            } else {
+                total_nwritten += nwritten_or_error.value();
+            }
+            if (total_nwritten < size) {
+                if (auto result = wait_until_writable(description, true); result.is_error()) {
+                    if (total_nwritten > 0)
+                        return total_nwritten;
+                    return result.release_error();
+                }
+            }
+        }
+        return total_nwritten;
+    };
+
+    size_t total_sent = 0;
+    while (total_sent < count) {
+        if (!can_rewind_source) {
+            // Don't take anything out of the source unless the destination is ready for it.
+            auto result = wait_until_writable(*out_description, out_description->is_blocking());
+            if (result.is_error()) {
+                if (total_sent > 0)
+                    break;
+                return result.release_error();
+            }
+        }
+
+        auto chunk_size = min(count - total_sent, chunk->size());
+        auto nread_or_error = offset.has_value()
+            ? in_description->read(chunk_buffer, offset.value() + total_sent, chunk_size)
+            : in_description->read(chunk_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_sent > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = can_rewind_source
+            ? do_write(*out_description, chunk_buffer, nread)
+            : write_all_read_bytes(*out_description, chunk_buffer, nread);
+        size_t nwritten = nwritten_or_error.is_error() ? 0 : nwritten_or_error.value();
+        total_sent += nwritten;
+
+        if (nwritten < nread && can_rewind_source && !offset.has_value()) {
+            // The destination didn't accept everything we read, so put the rest back for the next call.
+            auto result = in_description->seek(static_cast<off_t>(nwritten) - static_cast<off_t>(nread), SEEK_CUR);
+            if (result.is_error() && total_sent == 0)
+                return result.release_error();
+        }
+
+        if (nwritten_or_error.is_error()) {
+            if (total_sent > 0)
+                break;
+            return nwritten_or_error.release_error();
+        }
+        if (nwritten < nread)
+            break;
+
+        // Don't block on a source that has run dry after we've already moved some data.
+        if (!in_description->can_read())
+            break;
+    }
+
+    if (offset.has_value()) {
+        off_t new_offset = offset.value() + total_sent;
+        TRY(copy_to_user(userspace_offset, &new_offset));
+    }
+
+    return total_sent;
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WaitQueue.h>
+
+namespace Kernel {
+
+static constexpr StringView page_zeroing_task_name = "Page Zeroing Task"sv;
+
+READONLY_AFTER_INIT static WaitQueue* s_page_zeroing_wait_queue;
+static SpinlockProtected<bool, LockRank::None> s_page_zeroing_has_work;
+
+static void page_zeroing_task(void*)
+{
+    Thread::current()->set_priority(THREAD_PRIORITY_LOW);
+    while (!Process::current().is_dying()) {
+        MUST(s_page_zeroing_wait_queue->wait_until(s_page_zeroing_has_work, [](bool& has_work) -> bool {
+            if (!has_work)
+                return false;
+            has_work = false;
+            return true;
+        }));
+        MM.refill_zeroed_page_caches();
+    }
+    Process::current().sys$exit(0);
+    VERIFY_NOT_REACHED();
+}
+
+UNMAP_AFTER_INIT void PageZeroingTask::spawn()
+{
+    s_page_zeroing_wait_queue = new WaitQueue;
+    MUST(Process::create_kernel_process(page_zeroing_task_name, page_zeroing_task, nullptr));
+    notify();
+}
+
+void PageZeroingTask::notify()
+{
+    if (!s_page_zeroing_wait_queue)
+        return;
+    bool already_had_work = s_page_zeroing_has_work.with([](auto& has_work) { return exchange(has_work, true); });
+    if (!already_had_work)
+        s_page_zeroing_wait_queue->notify_all();
+}
+
+}
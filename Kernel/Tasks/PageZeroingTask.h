@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+namespace Kernel {
+
+class PageZeroingTask {
+public:
+    static void spawn();
+    static void notify();
+};
+
+}
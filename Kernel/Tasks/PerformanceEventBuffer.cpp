@@ -5,10 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <AK/JsonArraySerializer.h>
 #include <AK/JsonObjectSerializer.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StackUnwinder.h>
+#include <Kernel/API/Perfcore.h>
 #include <Kernel/Arch/RegisterState.h>
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/FileSystem/Custody.h>
@@ -84,7 +86,7 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
 ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, ThreadID tid,
     FlatPtr ip, FlatPtr bp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FilesystemEvent filesystem_event)
 {
-    if (count() >= capacity())
+    if (count() >= capacity() && !m_is_ring_buffer)
         return ENOBUFS;
 
     if ((g_profiling_event_mask & type) == 0)
@@ -182,6 +184,14 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     event.pid = pid.value();
     event.tid = tid.value();
     event.timestamp = TimeManagement::the().uptime_ms();
+
+    SpinlockLocker locker(m_lock);
+    if (m_count >= capacity()) {
+        if (!m_is_ring_buffer)
+            return ENOBUFS;
+        m_first_index = (m_first_index + 1) % capacity();
+        --m_count;
+    }
     at(m_count++) = event;
     return {};
 }
@@ -190,7 +200,7 @@ PerformanceEvent& PerformanceEventBuffer::at(size_t index)
 {
     VERIFY(index < capacity());
     auto* events = reinterpret_cast<PerformanceEvent*>(m_buffer->data());
-    return events[index];
+    return events[(m_first_index + index) % capacity()];
 }
 
 template<typename Serializer>
@@ -374,6 +384,269 @@ ErrorOr<void> PerformanceEventBuffer::to_json(KBufferBuilder& builder) const
     return to_json_impl(object);
 }
 
+namespace {
+
+class PerfcoreWriter {
+public:
+    explicit PerfcoreWriter(KBufferBuilder& builder)
+        : m_builder(builder)
+    {
+    }
+
+    ErrorOr<void> write_record_type(Perfcore::RecordType type)
+    {
+        return m_builder.append(static_cast<char>(type));
+    }
+
+    ErrorOr<void> write_unsigned(u64 value)
+    {
+        u8 buffer[Perfcore::max_leb128_size];
+        auto size = Perfcore::encode_unsigned(value, buffer);
+        return m_builder.append_bytes({ buffer, size });
+    }
+
+    ErrorOr<void> write_signed(i64 value)
+    {
+        u8 buffer[Perfcore::max_leb128_size];
+        auto size = Perfcore::encode_signed(value, buffer);
+        return m_builder.append_bytes({ buffer, size });
+    }
+
+    ErrorOr<void> write_string(StringView string)
+    {
+        TRY(write_unsigned(string.length()));
+        return m_builder.append(string);
+    }
+
+private:
+    KBufferBuilder& m_builder;
+};
+
+// A backtrace as it will appear in the perfcore file, used to write every distinct backtrace only once.
+struct PerfcoreStack {
+    FlatPtr const* frames { nullptr };
+    size_t frame_count { 0 };
+    bool hide_kernel_addresses { false };
+
+    FlatPtr frame(size_t index) const
+    {
+        auto address = frames[index];
+        if (hide_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
+            return 0xdeadc0de;
+        return address;
+    }
+};
+
+struct PerfcoreStackTraits : public DefaultTraits<PerfcoreStack> {
+    static unsigned hash(PerfcoreStack const& stack)
+    {
+        unsigned hash = stack.frame_count;
+        for (size_t i = 0; i < stack.frame_count; ++i)
+            hash = pair_int_hash(hash, Traits<FlatPtr>::hash(stack.frame(i)));
+        return hash;
+    }
+
+    static bool equals(PerfcoreStack const& a, PerfcoreStack const& b)
+    {
+        if (a.frame_count != b.frame_count)
+            return false;
+        for (size_t i = 0; i < a.frame_count; ++i) {
+            if (a.frame(i) != b.frame(i))
+                return false;
+        }
+        return true;
+    }
+};
+
+}
+
+ErrorOr<void> PerformanceEventBuffer::to_perfcore(KBufferBuilder& builder) const
+{
+    auto const* events = reinterpret_cast<PerformanceEvent const*>(m_buffer->data());
+    auto events_until_wrap = min(m_count, capacity() - m_first_index);
+    auto string_count = m_strings.with([](auto& strings) { return strings.size(); });
+    return to_perfcore_impl(builder, { events + m_first_index, events_until_wrap }, { events, m_count - events_until_wrap }, 0, string_count);
+}
+
+ErrorOr<void> PerformanceEventBuffer::consume_to_perfcore(KBufferBuilder& builder)
+{
+    auto snapshot = TRY(KBuffer::try_create_with_size("Performance events snapshot"sv, m_buffer->size(), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+    auto* snapshot_events = reinterpret_cast<PerformanceEvent*>(snapshot->data());
+
+    // NOTE: Events keep being appended (and, once the ring is full, overwritten) while we serialize,
+    //       so we copy the events we are about to return out of the ring while holding the lock.
+    size_t count;
+    {
+        SpinlockLocker locker(m_lock);
+        auto const* events = reinterpret_cast<PerformanceEvent const*>(m_buffer->data());
+        count = m_count;
+        auto events_until_wrap = min(count, capacity() - m_first_index);
+        memcpy(snapshot_events, events + m_first_index, events_until_wrap * sizeof(PerformanceEvent));
+        memcpy(snapshot_events + events_until_wrap, events, (count - events_until_wrap) * sizeof(PerformanceEvent));
+        m_first_index = (m_first_index + count) % capacity();
+        m_count = 0;
+    }
+
+    // Strings are registered before the events that refer to them are appended, so every string that the
+    // copied events refer to is known by now. Only the ones we haven't returned from a previous read are emitted.
+    size_t first_string_index;
+    size_t string_count;
+    m_strings.with([&](auto& strings) {
+        first_string_index = m_first_unconsumed_string_index;
+        string_count = strings.size();
+        m_first_unconsumed_string_index = string_count;
+    });
+
+    return to_perfcore_impl(builder, { snapshot_events, count }, {}, first_string_index, string_count);
+}
+
+ErrorOr<void> PerformanceEventBuffer::to_perfcore_impl(KBufferBuilder& builder, ReadonlySpan<PerformanceEvent> events, ReadonlySpan<PerformanceEvent> wrapped_events, size_t first_string_index, size_t string_count) const
+{
+    PerfcoreWriter writer { builder };
+    TRY(builder.append_bytes({ Perfcore::magic, sizeof(Perfcore::magic) }));
+    TRY(writer.write_unsigned(Perfcore::version));
+
+    TRY(m_strings.with([&](auto& strings) -> ErrorOr<void> {
+        Vector<KString const*> strings_sorted_by_index;
+        TRY(strings_sorted_by_index.try_resize(string_count - first_string_index));
+        for (auto& entry : strings) {
+            if (entry.value >= first_string_index && entry.value < string_count)
+                strings_sorted_by_index[entry.value - first_string_index] = entry.key.ptr();
+        }
+        for (auto const* string : strings_sorted_by_index) {
+            TRY(writer.write_record_type(Perfcore::RecordType::String));
+            TRY(writer.write_string(string->view()));
+        }
+        return {};
+    }));
+
+    auto current_process_credentials = Process::current().credentials();
+    bool show_kernel_addresses = current_process_credentials->is_superuser();
+    HashMap<PerfcoreStack, u32, PerfcoreStackTraits> stack_ids;
+    u64 previous_timestamp = 0;
+    bool seen_first_sample = false;
+    for (size_t i = 0; i < events.size() + wrapped_events.size(); ++i) {
+        auto const& event = i < events.size() ? events[i] : wrapped_events[i - events.size()];
+
+        if (!show_kernel_addresses) {
+            if (event.type == PERF_EVENT_KMALLOC || event.type == PERF_EVENT_KFREE)
+                continue;
+        }
+
+        u32 stack_id = 0;
+        if (event.stack_size > 0) {
+            PerfcoreStack stack { event.stack, event.stack_size, !show_kernel_addresses };
+            if (auto it = stack_ids.find(stack); it != stack_ids.end()) {
+                stack_id = it->value;
+            } else {
+                stack_id = stack_ids.size() + 1;
+                TRY(stack_ids.try_set(stack, stack_id));
+
+                TRY(writer.write_record_type(Perfcore::RecordType::Stack));
+                TRY(writer.write_unsigned(stack.frame_count));
+                TRY(writer.write_unsigned(stack.frame(0)));
+                for (size_t j = 1; j < stack.frame_count; ++j)
+                    TRY(writer.write_signed(static_cast<i64>(stack.frame(j) - stack.frame(j - 1))));
+            }
+        }
+
+        TRY(writer.write_record_type(Perfcore::RecordType::Event));
+        TRY(writer.write_unsigned(event.type));
+        TRY(writer.write_unsigned(event.pid));
+        TRY(writer.write_unsigned(event.tid));
+        TRY(writer.write_signed(static_cast<i64>(event.timestamp - previous_timestamp)));
+        TRY(writer.write_unsigned(seen_first_sample ? event.lost_samples : 0));
+        TRY(writer.write_unsigned(stack_id));
+        previous_timestamp = event.timestamp;
+        if (event.type == PERF_EVENT_SAMPLE)
+            seen_first_sample = true;
+
+        switch (event.type) {
+        case PERF_EVENT_MALLOC:
+            TRY(writer.write_unsigned(event.data.malloc.size));
+            TRY(writer.write_unsigned(event.data.malloc.ptr));
+            break;
+        case PERF_EVENT_FREE:
+            TRY(writer.write_unsigned(event.data.free.size));
+            TRY(writer.write_unsigned(event.data.free.ptr));
+            break;
+        case PERF_EVENT_MMAP:
+            TRY(writer.write_unsigned(event.data.mmap.size));
+            TRY(writer.write_unsigned(event.data.mmap.ptr));
+            TRY(writer.write_string({ event.data.mmap.name, strlen(event.data.mmap.name) }));
+            break;
+        case PERF_EVENT_MUNMAP:
+            TRY(writer.write_unsigned(event.data.munmap.size));
+            TRY(writer.write_unsigned(event.data.munmap.ptr));
+            break;
+        case PERF_EVENT_PROCESS_CREATE:
+            TRY(writer.write_signed(event.data.process_create.parent_pid));
+            TRY(writer.write_string({ event.data.process_create.executable, strlen(event.data.process_create.executable) }));
+            break;
+        case PERF_EVENT_PROCESS_EXEC:
+            TRY(writer.write_string({ event.data.process_exec.executable, strlen(event.data.process_exec.executable) }));
+            break;
+        case PERF_EVENT_THREAD_CREATE:
+            TRY(writer.write_signed(event.data.thread_create.parent_tid));
+            break;
+        case PERF_EVENT_CONTEXT_SWITCH:
+            TRY(writer.write_signed(event.data.context_switch.next_pid));
+            TRY(writer.write_unsigned(event.data.context_switch.next_tid));
+            break;
+        case PERF_EVENT_KMALLOC:
+            TRY(writer.write_unsigned(event.data.kmalloc.size));
+            TRY(writer.write_unsigned(event.data.kmalloc.ptr));
+            break;
+        case PERF_EVENT_KFREE:
+            TRY(writer.write_unsigned(event.data.kfree.size));
+            TRY(writer.write_unsigned(event.data.kfree.ptr));
+            break;
+        case PERF_EVENT_SIGNPOST:
+            TRY(writer.write_unsigned(event.data.signpost.arg1));
+            TRY(writer.write_unsigned(event.data.signpost.arg2));
+            break;
+        case PERF_EVENT_FILESYSTEM: {
+            auto const& filesystem = event.data.filesystem;
+            static_assert(to_underlying(FilesystemEventType::Pread) == to_underlying(Perfcore::FilesystemEventType::Pread));
+            TRY(builder.append(static_cast<char>(filesystem.type)));
+            TRY(writer.write_unsigned(filesystem.durationNs));
+            switch (filesystem.type) {
+            case FilesystemEventType::Open:
+                TRY(writer.write_signed(filesystem.data.open.dirfd));
+                TRY(writer.write_unsigned(filesystem.data.open.filename_index));
+                TRY(writer.write_signed(filesystem.data.open.options));
+                TRY(writer.write_unsigned(filesystem.data.open.mode));
+                break;
+            case FilesystemEventType::Close:
+                TRY(writer.write_signed(filesystem.data.close.fd));
+                TRY(writer.write_unsigned(filesystem.data.close.filename_index));
+                break;
+            case FilesystemEventType::Preadv:
+                TRY(writer.write_signed(filesystem.data.preadv.fd));
+                TRY(writer.write_unsigned(filesystem.data.preadv.filename_index));
+                TRY(writer.write_signed(filesystem.data.preadv.offset));
+                break;
+            case FilesystemEventType::Read:
+                TRY(writer.write_signed(filesystem.data.read.fd));
+                TRY(writer.write_unsigned(filesystem.data.read.filename_index));
+                break;
+            case FilesystemEventType::Pread:
+                TRY(writer.write_signed(filesystem.data.pread.fd));
+                TRY(writer.write_unsigned(filesystem.data.pread.filename_index));
+                TRY(writer.write_unsigned(filesystem.data.pread.buffer_ptr));
+                TRY(writer.write_unsigned(filesystem.data.pread.size));
+                TRY(writer.write_signed(filesystem.data.pread.offset));
+                break;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return {};
+}
+
 OwnPtr<PerformanceEventBuffer> PerformanceEventBuffer::try_create_with_size(size_t buffer_size)
 {
     auto buffer_or_error = KBuffer::try_create_with_size("Performance events"sv, buffer_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
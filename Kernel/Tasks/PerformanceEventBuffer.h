@@ -9,6 +9,7 @@
 
 #include <AK/Error.h>
 #include <Kernel/Library/KBuffer.h>
+#include <Kernel/Locking/Spinlock.h>
 
 namespace Kernel {
 
@@ -180,9 +181,17 @@ public:
 
     void clear()
     {
+        m_first_index = 0;
         m_count = 0;
     }
 
+    // In ring buffer mode, the oldest events are overwritten once the buffer is full instead of
+    // dropping new ones, and consume_to_perfcore() removes the events it returns from the buffer.
+    // Each consume_to_perfcore() only emits the strings registered since the previous one, so readers
+    // have to keep the strings of earlier reads around to resolve the string indices of later events.
+    bool is_ring_buffer() const { return m_is_ring_buffer; }
+    void set_ring_buffer(bool is_ring_buffer) { m_is_ring_buffer = is_ring_buffer; }
+
     size_t capacity() const { return m_buffer->size() / sizeof(PerformanceEvent); }
     size_t count() const { return m_count; }
     PerformanceEvent const& at(size_t index) const
@@ -191,6 +200,8 @@ public:
     }
 
     ErrorOr<void> to_json(KBufferBuilder&) const;
+    ErrorOr<void> to_perfcore(KBufferBuilder&) const;
+    ErrorOr<void> consume_to_perfcore(KBufferBuilder&);
 
     ErrorOr<void> add_process(Process const&, ProcessEventType event_type);
 
@@ -202,15 +213,24 @@ private:
     template<typename Serializer>
     ErrorOr<void> to_json_impl(Serializer&) const;
 
+    ErrorOr<void> to_perfcore_impl(KBufferBuilder&, ReadonlySpan<PerformanceEvent> events, ReadonlySpan<PerformanceEvent> wrapped_events, size_t first_string_index, size_t string_count) const;
+
     PerformanceEvent& at(size_t index);
 
+    // Index of the slot holding the oldest event, this only moves in ring buffer mode.
+    size_t m_first_index { 0 };
     size_t m_count { 0 };
+    bool m_is_ring_buffer { false };
     NonnullOwnPtr<KBuffer> m_buffer;
+    Spinlock<LockRank::None> m_lock {};
 
     RecursiveSpinlockProtected<HashMap<NonnullOwnPtr<KString>, size_t>, LockRank::None> m_strings;
+    // Strings below this index have already been returned by consume_to_perfcore(), this is protected by the lock of m_strings.
+    size_t m_first_unconsumed_string_index { 0 };
 };
 
 extern bool g_profiling_all_threads;
+extern bool g_profile_continuously;
 extern PerformanceEventBuffer* g_global_perf_events;
 extern u64 g_profiling_event_mask;
 
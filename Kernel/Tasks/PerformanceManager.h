@@ -134,7 +134,7 @@ public:
     {
         static UnixDateTime last_wakeup;
         auto now = kgettimeofday();
-        constexpr auto ideal_interval = Duration::from_microseconds(1000'000 / OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE);
+        auto ideal_interval = Duration::from_microseconds(1000'000 / TimeManagement::the().profile_ticks_per_second());
         auto expected_wakeup = last_wakeup + ideal_interval;
         auto delay = (now > expected_wakeup) ? now - expected_wakeup : Duration::from_microseconds(0);
         last_wakeup = now;
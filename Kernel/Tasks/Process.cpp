@@ -873,15 +873,15 @@ ErrorOr<void> Process::dump_perfcore()
     }
 
     auto builder = TRY(KBufferBuilder::try_create());
-    TRY(m_perf_event_buffer->to_json(builder));
+    TRY(m_perf_event_buffer->to_perfcore(builder));
 
-    auto json = builder.build();
-    if (!json) {
+    auto perfcore = builder.build();
+    if (!perfcore) {
         dbgln("Failed to generate perfcore for pid {}: Could not allocate buffer.", pid().value());
         return ENOMEM;
     }
-    auto json_buffer = UserOrKernelBuffer::for_kernel_buffer(json->data());
-    TRY(description->write(json_buffer, json->size()));
+    auto perfcore_buffer = UserOrKernelBuffer::for_kernel_buffer(perfcore->data());
+    TRY(description->write(perfcore_buffer, perfcore->size()));
 
     dbgln("Wrote perfcore for pid {} to {}", pid().value(), perfcore_filename);
     return {};
@@ -599,12 +599,15 @@ void TimeManagement::system_timer_tick()
     Scheduler::timer_tick();
 }
 
-bool TimeManagement::enable_profile_timer()
+bool TimeManagement::enable_profile_timer(u32 ticks_per_second)
 {
     if (!m_profile_timer)
         return false;
-    if (m_profile_enable_count.fetch_add(1) == 0)
-        return m_profile_timer->try_to_set_frequency(m_profile_timer->calculate_nearest_possible_frequency(OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE));
+    // NOTE: While the timer is shared by several profilers, it runs at the highest rate any of them asked for.
+    if (m_profile_enable_count.fetch_add(1) == 0 || ticks_per_second > m_profile_ticks_per_second) {
+        m_profile_ticks_per_second = ticks_per_second;
+        return m_profile_timer->try_to_set_frequency(m_profile_timer->calculate_nearest_possible_frequency(ticks_per_second));
+    }
     return true;
 }
 
@@ -22,6 +22,7 @@ namespace Kernel {
 
 #define OPTIMAL_TICKS_PER_SECOND_RATE 250
 #define OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE 1000
+#define CONTINUOUS_PROFILE_TICKS_PER_SECOND_RATE 97
 
 class HardwareTimerBase;
 
@@ -63,8 +64,9 @@ public:
 
     static bool is_hpet_periodic_mode_allowed();
 
-    bool enable_profile_timer();
+    bool enable_profile_timer(u32 ticks_per_second = OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE);
     bool disable_profile_timer();
+    u32 profile_ticks_per_second() const { return m_profile_ticks_per_second; }
 
     u64 uptime_ms() const;
     static UnixDateTime now();
@@ -116,6 +118,7 @@ private:
     LockRefPtr<HardwareTimerBase> m_time_keeper_timer;
 
     Atomic<u32> m_profile_enable_count { 0 };
+    Atomic<u32> m_profile_ticks_per_second { OPTIMAL_PROFILE_TICKS_PER_SECOND_RATE };
     LockRefPtr<HardwareTimerBase> m_profile_timer;
 
     NonnullOwnPtr<Memory::Region> m_time_page_region;
@@ -9,8 +9,10 @@
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ParallelFor.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
@@ -20,5 +22,8 @@ ErrorOr<int> serenity_main(Main::Arguments)
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
 
+    // Let decoders split up the work for large images.
+    Threading::set_parallel_worker_count(Core::System::hardware_concurrency() - 1);
+
     return event_loop.exec();
 }
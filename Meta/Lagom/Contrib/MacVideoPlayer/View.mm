@@ -7,6 +7,7 @@
 #import "View.h"
 
 #include <LibMedia/PlaybackManager.h>
+#include <LibMedia/VideoFrame.h>
 
 @interface View ()
 {
@@ -51,7 +52,17 @@ static NSBitmapImageRep* ns_from_gfx(RefPtr<Gfx::Bitmap> bitmap_p)
     _manager->on_video_frame = [weak_self](auto frame) {
         View* strong_self = weak_self;
         if (strong_self) {
-            auto* ns_frame = ns_from_gfx(move(frame));
+            if (!frame)
+                return;
+            auto bitmap = frame->to_bitmap();
+            if (bitmap.is_error()) {
+                auto error_string = bitmap.error().description();
+                strong_self->_currentFrame = nil;
+                strong_self->_errorMessage = [NSString stringWithFormat:@"Failed to convert frame: %.*s", (int)error_string.length(), error_string.characters_without_null_termination()];
+                [strong_self setNeedsDisplay:YES];
+                return;
+            }
+            auto* ns_frame = ns_from_gfx(bitmap.release_value());
             strong_self->_currentFrame = ns_frame;
             strong_self->_errorMessage = nil;
             [strong_self setNeedsDisplay:YES];
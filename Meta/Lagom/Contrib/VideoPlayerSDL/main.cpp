@@ -10,6 +10,7 @@
 #include <LibCore/MappedFile.h>
 #include <LibMain/Main.h>
 #include <LibMedia/PlaybackManager.h>
+#include <LibMedia/VideoFrame.h>
 #include <SDL2/SDL.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
@@ -37,7 +38,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     SDL_Window* window = NULL;
 
     auto playback_manager = load_file_result.release_value();
-    playback_manager->on_video_frame = [&texture, &renderer, &window](RefPtr<Gfx::Bitmap> frame) {
+    playback_manager->on_video_frame = [&texture, &renderer, &window](RefPtr<Media::VideoFrame> video_frame) {
+        if (!video_frame)
+            return;
+        auto frame_or_error = video_frame->to_bitmap();
+        if (frame_or_error.is_error()) {
+            warnln("Failed to convert frame: {}", frame_or_error.error().description());
+            return;
+        }
+        auto frame = frame_or_error.release_value();
+
         // Delete texture if it doesn't match the frame size and resize window
         if (texture != NULL) {
             int width, height;
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <poll.h>
+#include <serenity.h>
+
+static ErrorOr<void> add(int queue_fd, int fd, u64 id, short events, short flags = 0)
+{
+    event_queue_event event { .id = id, .events = events, .flags = flags };
+    return Core::System::event_queue_ctl(queue_fd, EVENT_QUEUE_CTL_ADD, fd, event);
+}
+
+TEST_CASE(level_triggered)
+{
+    auto queue_fd = MUST(Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC));
+    auto pipe_fds = MUST(Core::System::pipe2(0));
+    MUST(add(queue_fd, pipe_fds[0], 42, POLLIN));
+
+    Array<event_queue_event, 4> events;
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 0);
+
+    MUST(Core::System::write(pipe_fds[1], "x"sv.bytes()));
+
+    // The pipe stays readable until we read from it, so it's reported every time.
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, -1)), 1);
+        EXPECT_EQ(events[0].id, 42u);
+        EXPECT_EQ(events[0].events, static_cast<short>(POLLIN));
+    }
+
+    char buffer[1];
+    MUST(Core::System::read(pipe_fds[0], { buffer, sizeof(buffer) }));
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 0);
+
+    MUST(Core::System::close(pipe_fds[0]));
+    MUST(Core::System::close(pipe_fds[1]));
+    MUST(Core::System::close(queue_fd));
+}
+
+TEST_CASE(one_shot)
+{
+    auto queue_fd = MUST(Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC));
+    auto pipe_fds = MUST(Core::System::pipe2(0));
+    MUST(add(queue_fd, pipe_fds[1], 1, POLLOUT, EVENT_QUEUE_ONESHOT));
+
+    Array<event_queue_event, 4> events;
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 1);
+    EXPECT_EQ(events[0].id, 1u);
+    EXPECT_EQ(events[0].events, static_cast<short>(POLLOUT));
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 0);
+
+    // Modifying the registration arms it again.
+    event_queue_event event { .id = 1, .events = POLLOUT, .flags = EVENT_QUEUE_ONESHOT };
+    MUST(Core::System::event_queue_ctl(queue_fd, EVENT_QUEUE_CTL_MODIFY, -1, event));
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 1);
+
+    MUST(Core::System::close(pipe_fds[0]));
+    MUST(Core::System::close(pipe_fds[1]));
+    MUST(Core::System::close(queue_fd));
+}
+
+TEST_CASE(batches_are_limited_and_fair)
+{
+    auto queue_fd = MUST(Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC));
+    Array<Array<int, 2>, 3> pipes;
+    for (size_t i = 0; i < pipes.size(); ++i) {
+        pipes[i] = MUST(Core::System::pipe2(0));
+        MUST(add(queue_fd, pipes[i][1], i + 1, POLLOUT));
+    }
+
+    // With room for two events at a time, every writable pipe is reported within two waits.
+    Array<event_queue_event, 2> events;
+    u64 reported_ids = 0;
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 2);
+        for (auto& event : events)
+            reported_ids |= 1u << event.id;
+    }
+    EXPECT_EQ(reported_ids, 0b1110u);
+
+    for (auto& pipe_fds : pipes) {
+        MUST(Core::System::close(pipe_fds[0]));
+        MUST(Core::System::close(pipe_fds[1]));
+    }
+    MUST(Core::System::close(queue_fd));
+}
+
+TEST_CASE(closing_the_fd_ends_the_registration)
+{
+    auto queue_fd = MUST(Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC));
+    auto pipe_fds = MUST(Core::System::pipe2(0));
+    MUST(add(queue_fd, pipe_fds[1], 1, POLLOUT));
+    MUST(Core::System::close(pipe_fds[1]));
+
+    Array<event_queue_event, 4> events;
+    EXPECT_EQ(MUST(Core::System::event_queue_wait(queue_fd, events, 0)), 0);
+
+    event_queue_event event { .id = 1, .events = 0, .flags = 0 };
+    auto result = Core::System::event_queue_ctl(queue_fd, EVENT_QUEUE_CTL_REMOVE, -1, event);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), ENOENT);
+
+    MUST(Core::System::close(pipe_fds[0]));
+    MUST(Core::System::close(queue_fd));
+}
+
+TEST_CASE(invalid_registrations)
+{
+    auto queue_fd = MUST(Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC));
+    auto pipe_fds = MUST(Core::System::pipe2(0));
+    MUST(add(queue_fd, pipe_fds[0], 1, POLLIN));
+
+    auto expect_error = [](ErrorOr<void> result, int code) {
+        EXPECT(result.is_error());
+        if (result.is_error())
+            EXPECT_EQ(result.error().code(), code);
+    };
+
+    expect_error(add(queue_fd, pipe_fds[1], 1, POLLOUT), EEXIST);
+    expect_error(add(queue_fd, pipe_fds[1], 2, POLLOUT, 0x100), EINVAL);
+    expect_error(add(queue_fd, queue_fd, 3, POLLIN), EINVAL);
+    expect_error(add(pipe_fds[0], pipe_fds[1], 4, POLLOUT), EBADF);
+    expect_error(add(queue_fd, -1, 5, POLLIN), EBADF);
+
+    MUST(Core::System::close(pipe_fds[0]));
+    MUST(Core::System::close(pipe_fds[1]));
+    MUST(Core::System::close(queue_fd));
+}
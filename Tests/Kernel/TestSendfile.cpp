@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <string.h>
+
+static int create_file_with_contents(StringView contents)
+{
+    char pattern[] = "/tmp/sendfile.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, strlen(pattern) }));
+    EXPECT_EQ(static_cast<size_t>(MUST(Core::System::write(fd, contents.bytes()))), contents.length());
+    MUST(Core::System::lseek(fd, 0, SEEK_SET));
+    return fd;
+}
+
+TEST_CASE(sendfile_to_pipe)
+{
+    auto fd = create_file_with_contents("Well hello friends!"sv);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    auto nsent = MUST(Core::System::sendfile(pipefds[1], fd, nullptr, 100));
+    EXPECT_EQ(nsent, 19u);
+
+    // The file offset of in_fd has been advanced.
+    EXPECT_EQ(MUST(Core::System::lseek(fd, 0, SEEK_CUR)), 19);
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], fd, nullptr, 100)), 0u);
+
+    char buffer[32] {};
+    auto nread = MUST(Core::System::read(pipefds[0], { buffer, sizeof(buffer) }));
+    EXPECT_EQ(StringView(buffer, static_cast<size_t>(nread)), "Well hello friends!"sv);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(fd));
+}
+
+TEST_CASE(sendfile_with_offset)
+{
+    auto fd = create_file_with_contents("Well hello friends!"sv);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    off_t offset = 5;
+    auto nsent = MUST(Core::System::sendfile(pipefds[1], fd, &offset, 5));
+    EXPECT_EQ(nsent, 5u);
+    EXPECT_EQ(offset, 10);
+
+    // The file offset of in_fd has not moved.
+    EXPECT_EQ(MUST(Core::System::lseek(fd, 0, SEEK_CUR)), 0);
+
+    char buffer[32] {};
+    auto nread = MUST(Core::System::read(pipefds[0], { buffer, sizeof(buffer) }));
+    EXPECT_EQ(StringView(buffer, static_cast<size_t>(nread)), "hello"sv);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(fd));
+}
+
+TEST_CASE(sendfile_errors)
+{
+    auto fd = create_file_with_contents("Well hello friends!"sv);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    {
+        // in_fd is not seekable, but an offset is given.
+        off_t offset = 0;
+        auto result = Core::System::sendfile(fd, pipefds[0], &offset, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), ESPIPE);
+    }
+
+    {
+        // out_fd is not writable.
+        auto result = Core::System::sendfile(pipefds[0], fd, nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EBADF);
+    }
+
+    {
+        // Negative offset.
+        off_t offset = -1;
+        auto result = Core::System::sendfile(pipefds[1], fd, &offset, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EINVAL);
+    }
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(fd));
+}
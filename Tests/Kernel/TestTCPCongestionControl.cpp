@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Net/TCPCongestionControl.h>
+#include <LibTest/TestCase.h>
+
+#include <Kernel/Net/TCPCongestionControl.cpp>
+
+using Kernel::TCPCongestionControl;
+using Kernel::TCPRetransmitTimer;
+
+static constexpr u32 mss = 1460;
+
+static TCPCongestionControl make_congestion_control()
+{
+    TCPCongestionControl congestion_control;
+    congestion_control.set_maximum_segment_size(mss);
+    return congestion_control;
+}
+
+TEST_CASE(sequence_numbers_compare_across_wraparound)
+{
+    EXPECT(Kernel::tcp_sequence_number_less_than(1, 2));
+    EXPECT(!Kernel::tcp_sequence_number_less_than(2, 2));
+    EXPECT(Kernel::tcp_sequence_number_less_than_or_equal(2, 2));
+    EXPECT(Kernel::tcp_sequence_number_less_than(0xfffffff0, 0x10));
+    EXPECT(!Kernel::tcp_sequence_number_less_than(0x10, 0xfffffff0));
+}
+
+TEST_CASE(slow_start_grows_by_one_segment_per_ack)
+{
+    auto congestion_control = make_congestion_control();
+    EXPECT_EQ(congestion_control.congestion_window(), TCPCongestionControl::initial_congestion_window);
+
+    congestion_control.did_acknowledge_new_data(mss, mss);
+    EXPECT_EQ(congestion_control.congestion_window(), TCPCongestionControl::initial_congestion_window + mss);
+
+    // A stretch ACK still only opens the window by one segment.
+    congestion_control.did_acknowledge_new_data(5 * mss, 4 * mss);
+    EXPECT_EQ(congestion_control.congestion_window(), TCPCongestionControl::initial_congestion_window + 2 * mss);
+}
+
+TEST_CASE(congestion_avoidance_grows_by_one_segment_per_window)
+{
+    auto congestion_control = make_congestion_control();
+    congestion_control.did_time_out(20 * mss, 20 * mss);
+    EXPECT_EQ(congestion_control.slow_start_threshold(), 10 * mss);
+
+    u32 ack_number = 20 * mss;
+    while (congestion_control.congestion_window() < congestion_control.slow_start_threshold()) {
+        ack_number += mss;
+        congestion_control.did_acknowledge_new_data(ack_number, mss);
+    }
+    auto window = congestion_control.congestion_window();
+    EXPECT_EQ(window, 10 * mss);
+
+    for (u32 i = 0; i < window / mss; ++i) {
+        ack_number += mss;
+        congestion_control.did_acknowledge_new_data(ack_number, mss);
+    }
+    EXPECT(congestion_control.congestion_window() > window);
+    EXPECT(congestion_control.congestion_window() <= window + mss);
+}
+
+TEST_CASE(congestion_window_saturates)
+{
+    auto congestion_control = make_congestion_control();
+    u32 ack_number = 0;
+    for (size_t i = 0; i < (TCPCongestionControl::maximum_congestion_window / mss) + 16; ++i) {
+        ack_number += mss;
+        congestion_control.did_acknowledge_new_data(ack_number, mss);
+    }
+    EXPECT_EQ(congestion_control.congestion_window(), TCPCongestionControl::maximum_congestion_window);
+
+    congestion_control.did_acknowledge_new_data(ack_number + mss, mss);
+    EXPECT_EQ(congestion_control.congestion_window(), TCPCongestionControl::maximum_congestion_window);
+}
+
+TEST_CASE(third_duplicate_ack_enters_fast_recovery)
+{
+    auto congestion_control = make_congestion_control();
+    u32 const bytes_in_flight = 10 * mss;
+    u32 const next_sequence_number = 10 * mss;
+
+    EXPECT(!congestion_control.did_receive_duplicate_ack(bytes_in_flight, next_sequence_number));
+    EXPECT(!congestion_control.did_receive_duplicate_ack(bytes_in_flight, next_sequence_number));
+    EXPECT(congestion_control.did_receive_duplicate_ack(bytes_in_flight, next_sequence_number));
+
+    EXPECT(congestion_control.is_in_fast_recovery());
+    EXPECT_EQ(congestion_control.recovery_point(), next_sequence_number);
+    EXPECT_EQ(congestion_control.slow_start_threshold(), 5 * mss);
+    EXPECT_EQ(congestion_control.congestion_window(), 8 * mss);
+
+    // Every further duplicate ACK inflates the window, but doesn't trigger another retransmission.
+    EXPECT(!congestion_control.did_receive_duplicate_ack(bytes_in_flight, next_sequence_number));
+    EXPECT_EQ(congestion_control.congestion_window(), 9 * mss);
+}
+
+TEST_CASE(fast_recovery_partial_and_full_acknowledgments)
+{
+    auto congestion_control = make_congestion_control();
+    for (int i = 0; i < 3; ++i)
+        (void)congestion_control.did_receive_duplicate_ack(10 * mss, 10 * mss);
+    EXPECT_EQ(congestion_control.congestion_window(), 8 * mss);
+
+    // A partial ACK deflates the window by the acknowledged data, plus one segment for the retransmission.
+    congestion_control.did_acknowledge_new_data(2 * mss, 2 * mss);
+    EXPECT(congestion_control.is_in_fast_recovery());
+    EXPECT_EQ(congestion_control.congestion_window(), 7 * mss);
+
+    // A full ACK leaves fast recovery with the window set to the slow start threshold.
+    congestion_control.did_acknowledge_new_data(10 * mss, 8 * mss);
+    EXPECT(!congestion_control.is_in_fast_recovery());
+    EXPECT_EQ(congestion_control.congestion_window(), 5 * mss);
+}
+
+TEST_CASE(time_out_restarts_slow_start)
+{
+    auto congestion_control = make_congestion_control();
+    congestion_control.did_time_out(10 * mss, 10 * mss);
+
+    EXPECT_EQ(congestion_control.congestion_window(), mss);
+    EXPECT_EQ(congestion_control.slow_start_threshold(), 5 * mss);
+    EXPECT(congestion_control.is_in_time_out_recovery());
+
+    // Duplicate ACKs for segments sent before the timeout don't start fast recovery.
+    for (int i = 0; i < 3; ++i)
+        EXPECT(!congestion_control.did_receive_duplicate_ack(mss, 10 * mss));
+    EXPECT(!congestion_control.is_in_fast_recovery());
+
+    congestion_control.did_acknowledge_new_data(10 * mss, mss);
+    EXPECT(!congestion_control.is_in_time_out_recovery());
+}
+
+TEST_CASE(retransmit_timeout_follows_round_trip_time)
+{
+    TCPRetransmitTimer timer;
+    EXPECT_EQ(timer.retransmit_timeout(), TCPRetransmitTimer::initial_retransmit_timeout);
+
+    // First sample: SRTT = R, RTTVAR = R/2, RTO = SRTT + 4 * RTTVAR.
+    timer.did_measure_round_trip_time(Duration::from_milliseconds(100));
+    EXPECT_EQ(timer.smoothed_round_trip_time(), Duration::from_milliseconds(100));
+    EXPECT_EQ(timer.retransmit_timeout(), Duration::from_milliseconds(300));
+
+    // A very fast link is clamped to the minimum.
+    for (int i = 0; i < 64; ++i)
+        timer.did_measure_round_trip_time(Duration::from_microseconds(10));
+    EXPECT_EQ(timer.retransmit_timeout(), TCPRetransmitTimer::minimum_retransmit_timeout);
+
+    // A very slow one is clamped to the maximum.
+    timer.did_measure_round_trip_time(Duration::from_seconds(120));
+    EXPECT_EQ(timer.retransmit_timeout(), TCPRetransmitTimer::maximum_retransmit_timeout);
+}
+
+TEST_CASE(retransmit_timeout_backs_off)
+{
+    TCPRetransmitTimer timer;
+    auto now = MonotonicTime::now();
+
+    timer.did_time_out(now);
+    EXPECT_EQ(timer.retransmit_timeout(), Duration::from_seconds(2));
+    timer.did_time_out(now);
+    EXPECT_EQ(timer.retransmit_timeout(), Duration::from_seconds(4));
+
+    for (int i = 0; i < 16; ++i)
+        timer.did_time_out(now);
+    EXPECT_EQ(timer.retransmit_timeout(), TCPRetransmitTimer::maximum_retransmit_timeout);
+}
+
+TEST_CASE(retransmissions_give_up_after_some_time)
+{
+    TCPRetransmitTimer timer;
+    auto start = MonotonicTime::now();
+    EXPECT(!timer.should_give_up(start + Duration::from_seconds(1000), false));
+
+    timer.did_time_out(start);
+    EXPECT(!timer.should_give_up(start + Duration::from_seconds(99), false));
+    EXPECT(timer.should_give_up(start + TCPRetransmitTimer::maximum_retransmit_duration, false));
+
+    // Connection attempts are retried for longer.
+    EXPECT(!timer.should_give_up(start + Duration::from_seconds(179), true));
+    EXPECT(timer.should_give_up(start + TCPRetransmitTimer::maximum_connect_retransmit_duration, true));
+
+    // Later timeouts don't move the start of the retransmission period.
+    timer.did_time_out(start + Duration::from_seconds(50));
+    EXPECT(timer.should_give_up(start + Duration::from_seconds(100), false));
+
+    // Acknowledged data ends it.
+    timer.did_acknowledge_new_data();
+    EXPECT(!timer.should_give_up(start + Duration::from_seconds(1000), false));
+}
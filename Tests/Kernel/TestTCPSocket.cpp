@@ -5,6 +5,7 @@
  */
 
 #include <AK/JsonArray.h>
+#include <AK/ScopeGuard.h>
 #include <LibCore/File.h>
 #include <LibTest/TestCase.h>
 #include <netinet/in.h>
@@ -170,3 +171,116 @@ TEST_CASE(socket_connect_after_bind)
     unlink("/tmp/tmp-client.test");
     unlink("/tmp/tmp.test");
 }
+
+struct LoopbackTransfer {
+    u16 port { 0 };
+    size_t byte_count { 0 };
+    sem_t listen_semaphore;
+    size_t bytes_received { 0 };
+    bool data_is_intact { true };
+};
+
+static u8 transfer_byte_at(size_t offset)
+{
+    return static_cast<u8>((offset * 7) ^ (offset >> 11));
+}
+
+static void* receive_loopback_transfer(void* argument)
+{
+    auto& transfer = *reinterpret_cast<LoopbackTransfer*>(argument);
+
+    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    VERIFY(server_fd >= 0);
+
+    sockaddr_in sin {};
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(transfer.port);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    VERIFY(bind(server_fd, (sockaddr*)(&sin), sizeof(sin)) == 0);
+    VERIFY(listen(server_fd, 1) == 0);
+    VERIFY(sem_post(&transfer.listen_semaphore) == 0);
+
+    int client_fd = accept(server_fd, nullptr, nullptr);
+    VERIFY(client_fd >= 0);
+
+    u8 buffer[16 * KiB];
+    while (true) {
+        auto nread = recv(client_fd, buffer, sizeof(buffer), 0);
+        VERIFY(nread >= 0);
+        if (nread == 0)
+            break;
+        for (ssize_t i = 0; i < nread; ++i) {
+            if (buffer[i] != transfer_byte_at(transfer.bytes_received + i))
+                transfer.data_is_intact = false;
+        }
+        transfer.bytes_received += nread;
+    }
+
+    VERIFY(close(client_fd) == 0);
+    VERIFY(close(server_fd) == 0);
+    return nullptr;
+}
+
+// Sends byte_count bytes over a loopback TCP connection, and checks that they all arrive in order.
+static void transfer_over_loopback(u16 transfer_port, size_t byte_count)
+{
+    LoopbackTransfer transfer;
+    transfer.port = transfer_port;
+    transfer.byte_count = byte_count;
+    VERIFY(sem_init(&transfer.listen_semaphore, 0, 0) == 0);
+
+    pthread_t receiver;
+    VERIFY(pthread_create(&receiver, nullptr, receive_loopback_transfer, &transfer) == 0);
+    VERIFY(sem_wait(&transfer.listen_semaphore) == 0);
+
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(client_fd >= 0);
+
+    sockaddr_in dst {};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(transfer_port);
+    dst.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(connect(client_fd, (sockaddr*)(&dst), sizeof(dst)), 0);
+
+    u8 buffer[64 * KiB];
+    size_t bytes_sent = 0;
+    while (bytes_sent < byte_count) {
+        auto chunk_size = min(sizeof(buffer), byte_count - bytes_sent);
+        for (size_t i = 0; i < chunk_size; ++i)
+            buffer[i] = transfer_byte_at(bytes_sent + i);
+        size_t chunk_sent = 0;
+        while (chunk_sent < chunk_size) {
+            auto nwritten = send(client_fd, buffer + chunk_sent, chunk_size - chunk_sent, 0);
+            VERIFY(nwritten > 0);
+            chunk_sent += nwritten;
+        }
+        bytes_sent += chunk_size;
+    }
+
+    EXPECT_EQ(close(client_fd), 0);
+    EXPECT_EQ(pthread_join(receiver, nullptr), 0);
+    EXPECT_EQ(sem_destroy(&transfer.listen_semaphore), 0);
+
+    EXPECT_EQ(transfer.bytes_received, byte_count);
+    EXPECT(transfer.data_is_intact);
+}
+
+static void set_loopback_drops_packets(bool drops_packets)
+{
+    auto file = MUST(Core::File::open("/sys/kernel/conf/loopback_drops_packets"sv, Core::File::OpenMode::Write));
+    MUST(file->write_until_depleted(drops_packets ? "1"sv.bytes() : "0"sv.bytes()));
+}
+
+TEST_CASE(tcp_transfer_recovers_from_packet_loss)
+{
+    // The loopback adapter drops every 64th frame, so both fast retransmit and retransmission timeouts get exercised.
+    set_loopback_drops_packets(true);
+    ScopeGuard restore_loopback = [] { set_loopback_drops_packets(false); };
+
+    transfer_over_loopback(port + 2, 4 * MiB);
+}
+
+BENCHMARK_CASE(tcp_loopback_throughput)
+{
+    transfer_over_loopback(port + 3, 256 * MiB);
+}
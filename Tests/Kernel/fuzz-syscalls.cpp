@@ -45,6 +45,7 @@ static bool is_bad_idea(int fn, size_t const* direct_sc_args, size_t const* fake
         return direct_sc_args[0] == 1;
     case SC_write:
     case SC_pwritev:
+    case SC_sendfile:
         // FIXME: Known bug: https://github.com/SerenityOS/serenity/issues/5328
         return direct_sc_args[0] == 0;
     case SC_pledge:
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibAudio/Queue.h>
+#include <LibAudio/Resampler.h>
+#include <LibTest/TestCase.h>
+
+static Vector<Audio::Sample> make_sine(u32 sample_rate, double frequency, size_t length)
+{
+    Vector<Audio::Sample> samples;
+    for (size_t i = 0; i < length; ++i) {
+        auto value = static_cast<float>(0.5 * AK::sin(2 * AK::Pi<double> * frequency * static_cast<double>(i) / sample_rate));
+        samples.append({ value, -value });
+    }
+    return samples;
+}
+
+// Returns the signal-to-noise ratio in dB of a resampled sine, ignoring the edges where the filter sees silence.
+static double sine_snr(ReadonlySpan<Audio::Sample> samples, u32 sample_rate, double frequency)
+{
+    double signal = 0;
+    double noise = 0;
+    for (size_t i = 100; i + 100 < samples.size(); ++i) {
+        auto expected = 0.5 * AK::sin(2 * AK::Pi<double> * frequency * static_cast<double>(i) / sample_rate);
+        signal += expected * expected;
+        noise += (samples[i].left - expected) * (samples[i].left - expected);
+        EXPECT_EQ(samples[i].left, -samples[i].right);
+    }
+    return 10 * AK::log10(signal / noise);
+}
+
+static Vector<Audio::Sample> resample_all(Audio::SincResampler& resampler, ReadonlySpan<Audio::Sample> input, size_t chunk_size)
+{
+    Vector<Audio::Sample> output;
+    for (size_t i = 0; i < input.size(); i += chunk_size)
+        MUST(resampler.try_resample_into_end(output, input.slice(i, min(chunk_size, input.size() - i))));
+    MUST(resampler.try_flush_into_end(output));
+    return output;
+}
+
+TEST_CASE(output_length_follows_ratio)
+{
+    auto input = make_sine(44100, 1000, 44100);
+
+    auto upsampler = MUST(Audio::SincResampler::create(44100, 48000));
+    EXPECT_EQ(resample_all(upsampler, input, 50).size(), 48000u);
+
+    auto downsampler = MUST(Audio::SincResampler::create(44100, 22050));
+    EXPECT_EQ(resample_all(downsampler, input, 50).size(), 22050u);
+
+    // Not a ratio of small integers, so the phases are interpolated.
+    auto odd_resampler = MUST(Audio::SincResampler::create(44100, 48001));
+    EXPECT_EQ(resample_all(odd_resampler, input, 50).size(), 48001u);
+}
+
+TEST_CASE(chunk_size_does_not_change_output)
+{
+    auto input = make_sine(44100, 440, 10000);
+
+    auto resampler = MUST(Audio::SincResampler::create(44100, 48000));
+    auto in_one_go = resample_all(resampler, input, input.size());
+    auto in_small_chunks = resample_all(resampler, input, 7);
+    EXPECT_EQ(in_one_go.size(), in_small_chunks.size());
+    for (size_t i = 0; i < in_one_go.size(); ++i) {
+        EXPECT_EQ(in_one_go[i].left, in_small_chunks[i].left);
+        EXPECT_EQ(in_one_go[i].right, in_small_chunks[i].right);
+    }
+}
+
+TEST_CASE(sine_is_reproduced_accurately)
+{
+    struct Conversion {
+        u32 source;
+        u32 target;
+    };
+    for (auto conversion : Array { Conversion { 44100, 48000 }, Conversion { 48000, 44100 }, Conversion { 8000, 44100 }, Conversion { 44100, 48001 } }) {
+        auto input = make_sine(conversion.source, 1000, conversion.source / 4);
+        auto resampler = MUST(Audio::SincResampler::create(conversion.source, conversion.target));
+        auto output = resample_all(resampler, input, 128);
+        EXPECT(sine_snr(output, conversion.target, 1000) > 80);
+    }
+}
+
+TEST_CASE(content_above_target_nyquist_is_removed)
+{
+    // 20 kHz can't be represented at 32 kHz, and must not alias down to 12 kHz.
+    auto input = make_sine(48000, 20000, 48000);
+    auto resampler = MUST(Audio::SincResampler::create(48000, 32000));
+    auto output = resample_all(resampler, input, 256);
+
+    double energy = 0;
+    for (size_t i = 100; i + 100 < output.size(); ++i)
+        energy += output[i].left * output[i].left;
+    auto rms = AK::sqrt(energy / static_cast<double>(output.size() - 200));
+    EXPECT(rms < 0.001);
+}
+
+BENCHMARK_CASE(resample_cd_audio_to_48k)
+{
+    auto input = make_sine(44100, 1000, 44100 * 10);
+    auto resampler = MUST(Audio::SincResampler::create(44100, 48000));
+    Vector<Audio::Sample> output;
+    // Chunks of the size that AudioServer receives from its clients.
+    for (size_t i = 0; i < input.size(); i += Audio::AUDIO_BUFFER_SIZE) {
+        output.clear_with_capacity();
+        MUST(resampler.try_resample_into_end(output, input.span().slice(i, min(Audio::AUDIO_BUFFER_SIZE, input.size() - i))));
+    }
+}
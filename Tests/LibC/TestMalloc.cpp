@@ -6,9 +6,13 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Array.h>
+#include <AK/Random.h>
 #include <errno.h>
 #include <mallocdefs.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
 TEST_CASE(malloc_limits)
 {
@@ -38,3 +42,101 @@ TEST_CASE(malloc_limits)
         return Test::Crash::Failure::DidNotCrash;
     });
 }
+
+static constexpr size_t stress_thread_count = 8;
+static constexpr size_t stress_iterations_per_thread = 20000;
+static constexpr size_t stress_live_allocations_per_thread = 64;
+
+static void* malloc_stress_thread(void* argument)
+{
+    auto pattern = static_cast<u8>(reinterpret_cast<FlatPtr>(argument));
+    Array<u8*, stress_live_allocations_per_thread> allocations {};
+    Array<size_t, stress_live_allocations_per_thread> sizes {};
+
+    for (size_t i = 0; i < stress_iterations_per_thread; ++i) {
+        auto slot = get_random_uniform(stress_live_allocations_per_thread);
+        if (allocations[slot]) {
+            for (size_t j = 0; j < sizes[slot]; ++j) {
+                if (allocations[slot][j] != pattern)
+                    return reinterpret_cast<void*>(1);
+            }
+            free(allocations[slot]);
+        }
+        // Mostly small allocations that are served by the thread cache, with the occasional larger one.
+        sizes[slot] = (i % 16 == 0) ? 1 + get_random_uniform(64 * KiB) : 1 + get_random_uniform(1024);
+        allocations[slot] = static_cast<u8*>(malloc(sizes[slot]));
+        if (!allocations[slot])
+            return reinterpret_cast<void*>(1);
+        memset(allocations[slot], pattern, sizes[slot]);
+    }
+
+    for (auto* allocation : allocations)
+        free(allocation);
+    return nullptr;
+}
+
+TEST_CASE(malloc_multithreaded_stress)
+{
+    Array<pthread_t, stress_thread_count> threads;
+    for (size_t i = 0; i < stress_thread_count; ++i)
+        EXPECT_EQ(pthread_create(&threads[i], nullptr, malloc_stress_thread, reinterpret_cast<void*>(i + 1)), 0);
+
+    for (auto thread : threads) {
+        void* result = nullptr;
+        EXPECT_EQ(pthread_join(thread, &result), 0);
+        EXPECT_EQ(result, nullptr);
+    }
+}
+
+static constexpr size_t cross_thread_allocation_count = 1000;
+static Array<void*, cross_thread_allocation_count> s_cross_thread_allocations;
+
+static void* allocate_for_other_thread(void*)
+{
+    for (size_t i = 0; i < cross_thread_allocation_count; ++i) {
+        s_cross_thread_allocations[i] = malloc(16 + (i % 64) * 16);
+        memset(s_cross_thread_allocations[i], 0x42, 16);
+    }
+    return nullptr;
+}
+
+TEST_CASE(malloc_free_from_other_thread)
+{
+    serenity_malloc_stats stats_before {};
+    serenity_get_malloc_stats(&stats_before);
+
+    // Chunks allocated by a thread that has exited in the meantime are freed into our own thread cache.
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(&thread, nullptr, allocate_for_other_thread, nullptr), 0);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    for (auto* allocation : s_cross_thread_allocations) {
+        EXPECT_EQ(*static_cast<u8*>(allocation), 0x42);
+        free(allocation);
+    }
+
+    serenity_malloc_stats stats_after {};
+    serenity_get_malloc_stats(&stats_after);
+    EXPECT(stats_after.malloc_call_count >= stats_before.malloc_call_count + cross_thread_allocation_count);
+    EXPECT(stats_after.free_call_count >= stats_before.free_call_count + cross_thread_allocation_count);
+    EXPECT(stats_after.thread_cache_keep_count > stats_before.thread_cache_keep_count);
+    EXPECT(stats_after.thread_cache_flush_count > stats_before.thread_cache_flush_count);
+}
+
+static void* malloc_free_loop(void*)
+{
+    for (size_t i = 0; i < 1'000'000; ++i) {
+        auto* ptr = malloc(16 + (i % 32) * 16);
+        free(ptr);
+    }
+    return nullptr;
+}
+
+BENCHMARK_CASE(malloc_free_multithreaded)
+{
+    Array<pthread_t, 4> threads;
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, malloc_free_loop, nullptr), 0);
+    for (auto thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
@@ -4,8 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteString.h>
+#include <AK/Platform.h>
+#include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 #include <dlfcn.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 TEST_CASE(test_dlopen)
 {
@@ -44,3 +52,75 @@ TEST_CASE(test_dlsym_rtld_default)
 
     dlclose(libd);
 }
+
+#ifdef AK_OS_SERENITY
+static void start_js(Vector<char*> const& environment)
+{
+    // js links against a good number of libraries, and exits right away when given a trivial script,
+    // so this mostly measures how long the dynamic loader takes to load and relocate them.
+    char* argv[] = { const_cast<char*>("/bin/js"), const_cast<char*>("-c"), const_cast<char*>("0"), nullptr };
+    pid_t pid;
+    EXPECT_EQ(posix_spawn(&pid, argv[0], nullptr, nullptr, argv, environment.data()), 0);
+    int status;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+static Vector<char*> environment_with(char* extra_variable)
+{
+    Vector<char*> environment;
+    for (char** variable = environ; *variable; ++variable)
+        environment.append(*variable);
+    if (extra_variable)
+        environment.append(extra_variable);
+    environment.append(nullptr);
+    return environment;
+}
+
+TEST_CASE(symbol_resolution_cache)
+{
+    char directory_template[] = "/tmp/ld-cache.XXXXXX";
+    auto* directory = mkdtemp(directory_template);
+    VERIFY(directory);
+    auto cache_path = ByteString::formatted("{}/js-{:08x}.ldcache", directory, "/bin/js"sv.hash());
+    auto variable = ByteString::formatted("LD_SYMBOL_CACHE_DIRECTORY={}", directory);
+    auto environment = environment_with(const_cast<char*>(variable.characters()));
+
+    // The first start writes the cache, the second one uses it.
+    start_js(environment);
+    struct stat first_stat;
+    EXPECT_EQ(stat(cache_path.characters(), &first_stat), 0);
+    EXPECT(first_stat.st_size > 0);
+
+    start_js(environment);
+    struct stat second_stat;
+    EXPECT_EQ(stat(cache_path.characters(), &second_stat), 0);
+    EXPECT_EQ(second_stat.st_ino, first_stat.st_ino);
+
+    EXPECT_EQ(unlink(cache_path.characters()), 0);
+    EXPECT_EQ(rmdir(directory), 0);
+}
+
+BENCHMARK_CASE(start_program_with_many_libraries)
+{
+    auto environment = environment_with(nullptr);
+    for (size_t i = 0; i < 50; ++i)
+        start_js(environment);
+}
+
+BENCHMARK_CASE(start_program_with_many_libraries_using_symbol_resolution_cache)
+{
+    char directory_template[] = "/tmp/ld-cache.XXXXXX";
+    auto* directory = mkdtemp(directory_template);
+    VERIFY(directory);
+    auto variable = ByteString::formatted("LD_SYMBOL_CACHE_DIRECTORY={}", directory);
+    auto environment = environment_with(const_cast<char*>(variable.characters()));
+
+    for (size_t i = 0; i < 50; ++i)
+        start_js(environment);
+
+    unlink(ByteString::formatted("{}/js-{:08x}.ldcache", directory, "/bin/js"sv.hash()).characters());
+    rmdir(directory);
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGUI/TextDocument.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<GUI::TextDocument> create_document(StringView text)
+{
+    auto document = GUI::TextDocument::create();
+    document->set_text(text);
+    return document;
+}
+
+static Vector<GUI::TextRange> find_all_with_find_next(GUI::TextDocument& document, StringView needle, bool match_case)
+{
+    Vector<GUI::TextRange> ranges;
+    GUI::TextPosition position { 0, 0 };
+    for (;;) {
+        auto range = document.find_next(needle, position, GUI::TextDocument::SearchShouldWrap::No, false, match_case);
+        if (!range.is_valid())
+            break;
+        ranges.append(range);
+        position = range.end();
+    }
+    return ranges;
+}
+
+static void expect_ranges(Vector<GUI::TextRange> const& ranges, Vector<GUI::TextRange> const& expected)
+{
+    EXPECT_EQ(ranges.size(), expected.size());
+    for (size_t i = 0; i < min(ranges.size(), expected.size()); ++i)
+        EXPECT_EQ(ranges[i], expected[i]);
+}
+
+TEST_CASE(find_all_match_case)
+{
+    auto document = create_document("foo bar foo\nfoofoo\nbar Foo"sv);
+    auto ranges = document->find_all("foo"sv, false, true);
+    expect_ranges(ranges, {
+                              { { 0, 0 }, { 0, 3 } },
+                              { { 0, 8 }, { 0, 11 } },
+                              { { 1, 0 }, { 1, 3 } },
+                              { { 1, 3 }, { 1, 6 } },
+                          });
+    expect_ranges(ranges, find_all_with_find_next(document, "foo"sv, true));
+}
+
+TEST_CASE(find_all_ignore_case)
+{
+    auto document = create_document("Foo FOO\nfoO\nbar"sv);
+    auto ranges = document->find_all("fOo"sv, false, false);
+    expect_ranges(ranges, {
+                              { { 0, 0 }, { 0, 3 } },
+                              { { 0, 4 }, { 0, 7 } },
+                              { { 1, 0 }, { 1, 3 } },
+                          });
+    expect_ranges(ranges, find_all_with_find_next(document, "fOo"sv, false));
+}
+
+TEST_CASE(find_all_at_end_of_line)
+{
+    auto document = create_document("abc\nxbc\nbc"sv);
+    auto ranges = document->find_all("bc"sv, false, true);
+    expect_ranges(ranges, {
+                              { { 0, 1 }, { 0, 3 } },
+                              { { 1, 1 }, { 1, 3 } },
+                              { { 2, 0 }, { 2, 2 } },
+                          });
+    expect_ranges(ranges, find_all_with_find_next(document, "bc"sv, true));
+}
+
+TEST_CASE(find_all_does_not_overlap)
+{
+    auto document = create_document("aaaaa"sv);
+    auto ranges = document->find_all("aa"sv, false, true);
+    expect_ranges(ranges, {
+                              { { 0, 0 }, { 0, 2 } },
+                              { { 0, 2 }, { 0, 4 } },
+                          });
+    expect_ranges(ranges, find_all_with_find_next(document, "aa"sv, true));
+}
+
+TEST_CASE(find_all_across_lines)
+{
+    auto document = create_document("abc\nxbc"sv);
+    auto ranges = document->find_all("c\nx"sv, false, true);
+    expect_ranges(ranges, {
+                              { { 0, 2 }, { 1, 1 } },
+                          });
+}
+
+TEST_CASE(find_all_no_match)
+{
+    auto document = create_document("abc\n\nx"sv);
+    EXPECT(document->find_all("abcd"sv, false, true).is_empty());
+    EXPECT(document->find_all("y"sv, false, false).is_empty());
+}
+
+TEST_CASE(lines_are_decoded_lazily)
+{
+    auto document = create_document("plain\nünïcödé\n\nlast"sv);
+    EXPECT_EQ(document->line_count(), 4u);
+    EXPECT_EQ(document->line(0).undecoded_text(), "plain"sv);
+    EXPECT_EQ(document->line(1).length(), 7u);
+    EXPECT(document->line(2).undecoded_text().is_null());
+    EXPECT_EQ(document->text(), "plain\nünïcödé\n\nlast"sv);
+    EXPECT_EQ(document->line(1).to_utf8(), "ünïcödé"sv);
+
+    // Nothing so far needed the code points.
+    EXPECT(!document->line(1).undecoded_text().is_null());
+
+    EXPECT_EQ(document->line(1).code_points()[1], 0x6eu);
+    EXPECT(document->line(1).undecoded_text().is_null());
+    EXPECT_EQ(document->line(1).length(), 7u);
+    EXPECT_EQ(document->line(1).to_utf8(), "ünïcödé"sv);
+
+    document->line(0).append(*document, '!');
+    EXPECT(document->line(0).undecoded_text().is_null());
+    EXPECT_EQ(document->text(), "plain!\nünïcödé\n\nlast"sv);
+}
+
+TEST_CASE(set_text_rejects_invalid_utf8)
+{
+    auto document = GUI::TextDocument::create();
+    EXPECT(!document->set_text("valid\n\xff\xfe"sv));
+    EXPECT(document->is_empty());
+}
+
+TEST_CASE(find_all_in_undecoded_lines)
+{
+    auto text = "ab Ab ab\nüab AB\nxyz"sv;
+    auto document = create_document(text);
+    auto expected = find_all_with_find_next(create_document(text), "ab"sv, false);
+
+    expect_ranges(document->find_all("ab"sv, false, false), expected);
+    // The ASCII lines are searched without decoding them.
+    EXPECT(!document->line(0).undecoded_text().is_null());
+    EXPECT(!document->line(2).undecoded_text().is_null());
+}
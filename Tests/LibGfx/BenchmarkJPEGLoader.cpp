@@ -18,6 +18,7 @@ auto small_image = Core::File::open(TEST_INPUT("jpg/rgb24.jpg"sv), Core::File::O
 auto big_image = Core::File::open(TEST_INPUT("jpg/big_image.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto rgb_image = Core::File::open(TEST_INPUT("jpg/rgb_components.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto several_scans = Core::File::open(TEST_INPUT("jpg/several_scans.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+auto ycck_image = Core::File::open(TEST_INPUT("jpg/ycck-2111.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 
 BENCHMARK_CASE(small_image)
 {
@@ -42,3 +43,16 @@ BENCHMARK_CASE(several_scans)
     auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(several_scans));
     MUST(plugin_decoder->frame(0));
 }
+
+BENCHMARK_CASE(ycck_image)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(ycck_image));
+    MUST(plugin_decoder->cmyk_frame());
+}
+
+BENCHMARK_CASE(big_image_downscaled)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(big_image));
+    auto size = plugin_decoder->size();
+    MUST(plugin_decoder->frame(0, Gfx::IntSize { size.width() / 4, size.height() / 4 }));
+}
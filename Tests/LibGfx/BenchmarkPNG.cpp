@@ -7,8 +7,11 @@
 #include <AK/FixedArray.h>
 #include <LibCore/File.h>
 #include <LibGfx/ImageFormats/JPEGLoader.h>
+#include <LibGfx/ImageFormats/PNGLoader.h>
 #include <LibGfx/ImageFormats/PNGShared.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/ParallelFor.h>
 
 #ifdef AK_OS_SERENITY
 #    define TEST_INPUT(x) ("/usr/Tests/LibGfx/test-inputs/" x)
@@ -47,3 +50,31 @@ BENCHMARK_CASE(paeth)
         scanline_minus_1 = scanline;
     }
 }
+
+auto encoded_bitmap = MUST(Gfx::PNGWriter::encode(*bitmap));
+auto interlaced_image = Core::File::open(TEST_INPUT("png/interlaced.png"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+
+BENCHMARK_CASE(decode)
+{
+    auto plugin_decoder = MUST(Gfx::PNGImageDecoderPlugin::create(encoded_bitmap));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(decode_interlaced)
+{
+    Threading::set_parallel_worker_count(0);
+    for (int i = 0; i < 100; ++i) {
+        auto plugin_decoder = MUST(Gfx::PNGImageDecoderPlugin::create(interlaced_image));
+        MUST(plugin_decoder->frame(0));
+    }
+}
+
+BENCHMARK_CASE(decode_interlaced_in_parallel)
+{
+    Threading::set_parallel_worker_count(3);
+    for (int i = 0; i < 100; ++i) {
+        auto plugin_decoder = MUST(Gfx::PNGImageDecoderPlugin::create(interlaced_image));
+        MUST(plugin_decoder->frame(0));
+    }
+    Threading::set_parallel_worker_count(0);
+}
@@ -35,6 +35,7 @@
 #include <LibGfx/ImageFormats/TinyVGLoader.h>
 #include <LibGfx/ImageFormats/WebPLoader.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/ParallelFor.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -548,6 +549,39 @@ TEST_CASE(test_jpeg_odd_mcu_restart_interval)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 102, 77 }));
 }
 
+TEST_CASE(test_jpeg_parallel_decoding)
+{
+    Array test_inputs = {
+        TEST_INPUT("jpg/odd-restart.jpg"sv),
+        TEST_INPUT("jpg/grayscale_mcu.jpg"sv),
+        TEST_INPUT("jpg/buggie-cmyk.jpg"sv),
+        TEST_INPUT("jpg/several_scans.jpg"sv),
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+
+        Threading::set_parallel_worker_count(0);
+        auto sequential_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto sequential_frame = TRY_OR_FAIL(sequential_decoder->frame(0)).image;
+
+        Threading::set_parallel_worker_count(3);
+        auto parallel_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto parallel_frame = TRY_OR_FAIL(parallel_decoder->frame(0)).image;
+        Threading::set_parallel_worker_count(0);
+
+        EXPECT_EQ(parallel_frame->size(), sequential_frame->size());
+        for (int y = 0; y < sequential_frame->height(); ++y) {
+            for (int x = 0; x < sequential_frame->width(); ++x) {
+                if (parallel_frame->get_pixel(x, y) != sequential_frame->get_pixel(x, y)) {
+                    FAIL(ByteString::formatted("{}: pixel at {},{} differs", test_input, x, y));
+                    return;
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE(test_jpeg_rgb_components)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
@@ -697,6 +731,27 @@ TEST_CASE(test_jpeg_non_conventional_app_id)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 80, 80 }));
 }
 
+TEST_CASE(test_jpeg_downscaled)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb24.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(127, 64));
+
+    // The image is decoded at the smallest of 1/8, 1/4, 1/2 and full scale that is at least as large as requested.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 30, 16 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(32, 16));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 10, 8 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(32, 16));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 50 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(127, 64));
+
+    auto downscaled_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto downscaled_frame = TRY_OR_FAIL(downscaled_decoder->frame(0, Gfx::IntSize { 16, 8 }));
+    EXPECT_EQ(downscaled_frame.image->size(), Gfx::IntSize(16, 8));
+}
+
 TEST_CASE(test_jpeg2000_spec_annex_j_10_bitplane_decoding)
 {
     // J.10.4 Arithmetic-coded compressed data
@@ -1412,6 +1467,53 @@ TEST_CASE(test_exif)
     EXPECT_EQ(*exif_metadata.orientation(), Gfx::TIFF::Orientation::Rotate90Clockwise);
 }
 
+TEST_CASE(test_png_interlaced)
+{
+    auto reference_file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/non-interlaced.png"sv)));
+    auto reference_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(reference_file->bytes()));
+    auto reference_frame = TRY_OR_FAIL(expect_single_frame_of_size(*reference_decoder, { 37, 29 }));
+    EXPECT_EQ(reference_frame.image->get_pixel(0, 0), Gfx::Color(0, 0, 255, 128));
+
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/interlaced.png"sv)));
+
+    // Decode the Adam7 passes both one after another and in parallel.
+    for (size_t worker_count : { 0, 3 }) {
+        Threading::set_parallel_worker_count(worker_count);
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 37, 29 }));
+
+        for (int y = 0; y < frame.image->height(); ++y) {
+            for (int x = 0; x < frame.image->width(); ++x)
+                EXPECT_EQ(frame.image->get_pixel(x, y), reference_frame.image->get_pixel(x, y));
+        }
+    }
+    Threading::set_parallel_worker_count(0);
+}
+
+TEST_CASE(test_png_interlaced_narrow)
+{
+    // Images this narrow have Adam7 passes without any columns, whose rows must not be counted.
+    struct TestInput {
+        StringView path;
+        Gfx::IntSize size;
+    };
+    Array test_inputs = {
+        TestInput { TEST_INPUT("png/interlaced-1x9.png"sv), { 1, 9 } },
+        TestInput { TEST_INPUT("png/interlaced-4x9.png"sv), { 4, 9 } },
+    };
+
+    for (auto const& test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input.path));
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, test_input.size));
+
+        for (int y = 0; y < frame.image->height(); ++y) {
+            for (int x = 0; x < frame.image->width(); ++x)
+                EXPECT_EQ(frame.image->get_pixel(x, y), Gfx::Color(x * 60, y * 25, (x + y) * 10));
+        }
+    }
+}
+
 TEST_CASE(test_png_malformed_frame)
 {
     Array test_inputs = {
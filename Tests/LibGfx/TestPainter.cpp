@@ -64,6 +64,31 @@ TEST_CASE(draw_triangle_wave)
         painter.draw_triangle_wave({ 0, y }, { bitmap->width(), y }, Gfx::Color::Red, 3, 2);
 }
 
+TEST_CASE(blit_with_alpha_matches_color_blend)
+{
+    // Wide enough to go through both the vectorized loop and the scalar tail.
+    int const w = 259;
+    int const h = 3;
+
+    auto source = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { w, h }));
+    auto destination = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { w, h }));
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            source->set_pixel(x, y, Gfx::Color(x * 7, y * 50, x, x % 256));
+            destination->set_pixel(x, y, Gfx::Color(255 - x % 256, x * 3, 128));
+        }
+    }
+    auto expected = MUST(destination->clone());
+
+    Gfx::Painter painter(*destination);
+    painter.blit({ 0, 0 }, *source, source->rect());
+
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x)
+            EXPECT_EQ(destination->get_pixel(x, y), expected->get_pixel(x, y).blend(source->get_pixel(x, y)));
+    }
+}
+
 // FIXME: Stolen from `Userland/Demos/Tubes/Tubes.cpp`; we really need something like this in `AK/Random.h`.
 static double random_double()
 {
@@ -49,3 +49,10 @@ BENCHMARK_CASE(vp9_clamp_reference_mvs)
 {
     decode_video("./vp9_clamp_reference_mvs.webm"sv, 92, make_decoder);
 }
+
+BENCHMARK_CASE(vp9_4k_throughput)
+{
+    // The 4K stream is split into several tile columns, so this measures how well decoding is spread over the cores.
+    for (auto i = 0; i < 10; i++)
+        decode_video("./vp9_4k.webm"sv, 2, make_decoder);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibMedia/VideoFrame.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<Media::SubsampledYUVFrame> make_frame(Gfx::Size<u32> size, Media::MatrixCoefficients matrix_coefficients)
+{
+    auto cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SRGB, matrix_coefficients, Media::VideoFullRangeFlag::Studio);
+    Media::Subsampling subsampling { true, true };
+    auto frame = MUST(Media::SubsampledYUVFrame::try_create(Duration::zero(), size, 8, cicp, subsampling));
+
+    // Fill the luma plane with a gradient, so that scaling errors show up in the output. The chroma planes are
+    // interpolated differently by the unscaled conversion, so keep those flat.
+    for (u32 row = 0; row < size.height(); row++) {
+        for (u32 column = 0; column < size.width(); column++)
+            frame->get_plane_data<u8>(0)[row * size.width() + column] = 16 + (column * 200) / size.width();
+    }
+    auto uv_area = subsampling.subsampled_size(size).to_type<size_t>().area();
+    for (size_t i = 0; i < uv_area; i++) {
+        frame->get_plane_data<u8>(1)[i] = 100;
+        frame->get_plane_data<u8>(2)[i] = 160;
+    }
+    return frame;
+}
+
+TEST_CASE(scaled_output_matches_unscaled_output_at_full_size)
+{
+    for (auto matrix_coefficients : { Media::MatrixCoefficients::BT709, Media::MatrixCoefficients::BT601, Media::MatrixCoefficients::BT2020NonConstantLuminance }) {
+        auto frame = make_frame({ 64, 32 }, matrix_coefficients);
+        auto expected = MUST(frame->to_bitmap());
+
+        // Drawing at an offset into a larger bitmap keeps the scaled conversion from deferring to the unscaled one.
+        auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 80, 40 }));
+        Gfx::IntRect destination_rect { 8, 4, 64, 32 };
+        MUST(frame->output_to_bitmap(*bitmap, destination_rect, bitmap->rect()));
+
+        for (int y = 0; y < expected->height(); y++) {
+            for (int x = 0; x < expected->width(); x++)
+                EXPECT_EQ(bitmap->get_pixel(x + destination_rect.x(), y + destination_rect.y()), expected->get_pixel(x, y));
+        }
+    }
+}
+
+TEST_CASE(scaled_output_is_clipped)
+{
+    auto frame = make_frame({ 64, 32 }, Media::MatrixCoefficients::BT709);
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 100, 50 }));
+    bitmap->fill(Gfx::Color::Magenta);
+
+    Gfx::IntRect destination_rect { -10, -5, 120, 60 };
+    Gfx::IntRect clip_rect { 20, 10, 30, 20 };
+    MUST(frame->output_to_bitmap(*bitmap, destination_rect, clip_rect));
+
+    for (int y = 0; y < bitmap->height(); y++) {
+        for (int x = 0; x < bitmap->width(); x++)
+            EXPECT_EQ(bitmap->get_pixel(x, y) == Gfx::Color::Magenta, !clip_rect.contains(x, y));
+    }
+}
+
+TEST_CASE(downscaled_output_averages_neighbors)
+{
+    auto frame = make_frame({ 64, 32 }, Media::MatrixCoefficients::BT709);
+    auto full_size = MUST(frame->to_bitmap());
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 32, 16 }));
+    MUST(frame->output_to_bitmap(*bitmap, bitmap->rect(), bitmap->rect()));
+
+    // Every output pixel lies halfway between two columns of the gradient in the luma plane.
+    for (int x = 0; x < bitmap->width(); x++) {
+        auto left = full_size->get_pixel(x * 2, 15);
+        auto right = full_size->get_pixel(x * 2 + 1, 15);
+        auto color = bitmap->get_pixel(x, 7);
+        EXPECT(color.green() + 1 >= min(left.green(), right.green()));
+        EXPECT(color.green() <= max(left.green(), right.green()) + 1);
+    }
+}
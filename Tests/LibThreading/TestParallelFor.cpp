@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ParallelFor.h>
+
+TEST_CASE(calls_are_sequential_without_workers)
+{
+    Threading::set_parallel_worker_count(0);
+
+    Vector<size_t> indices;
+    TRY_OR_FAIL(Threading::for_each_in_parallel(10, [&](size_t index) -> ErrorOr<void> {
+        TRY(indices.try_append(index));
+        return {};
+    }));
+
+    EXPECT_EQ(indices, (Vector<size_t> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST_CASE(every_index_is_visited_once)
+{
+    Threading::set_parallel_worker_count(4);
+
+    static constexpr size_t count = 1000;
+    Array<Atomic<u32>, count> visits {};
+    TRY_OR_FAIL(Threading::for_each_in_parallel(count, [&](size_t index) -> ErrorOr<void> {
+        visits[index].fetch_add(1);
+        return {};
+    }));
+
+    for (auto& visit_count : visits)
+        EXPECT_EQ(visit_count.load(), 1u);
+
+    Threading::set_parallel_worker_count(0);
+}
+
+TEST_CASE(errors_are_propagated)
+{
+    Threading::set_parallel_worker_count(4);
+
+    auto result = Threading::for_each_in_parallel(100, [](size_t index) -> ErrorOr<void> {
+        if (index == 42)
+            return Error::from_string_literal("Index 42");
+        return {};
+    });
+    EXPECT(result.is_error());
+
+    Threading::set_parallel_worker_count(0);
+}
+
+TEST_CASE(nested_loops_do_not_deadlock)
+{
+    Threading::set_parallel_worker_count(2);
+
+    Atomic<u32> total { 0 };
+    TRY_OR_FAIL(Threading::for_each_in_parallel(8, [&](size_t) -> ErrorOr<void> {
+        return Threading::for_each_in_parallel(8, [&](size_t) -> ErrorOr<void> {
+            total.fetch_add(1);
+            return {};
+        });
+    }));
+    EXPECT_EQ(total.load(), 64u);
+
+    Threading::set_parallel_worker_count(0);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibVT/Line.h>
+
+static VT::Attribute bold_attribute()
+{
+    VT::Attribute attribute;
+    attribute.flags = VT::Attribute::Flags::Bold;
+    return attribute;
+}
+
+static VT::Attribute link_attribute(StringView href, StringView href_id)
+{
+    VT::Attribute attribute;
+    attribute.href = href;
+    attribute.href_id = ByteString { href_id };
+    return attribute;
+}
+
+static VT::Attribute red_background_attribute()
+{
+    VT::Attribute attribute;
+    attribute.background_color = VT::Color::named(VT::Color::ANSIColor::Red);
+    return attribute;
+}
+
+static void write(VT::Line& line, size_t column, StringView text, VT::Attribute const& attribute = {})
+{
+    for (auto character : text) {
+        line.set_code_point(column, character);
+        line.attribute_at(column) = attribute;
+        ++column;
+    }
+}
+
+static void expect_same_cells(VT::Line const& line, Vector<VT::Line::Cell> const& expected_cells)
+{
+    EXPECT_EQ(line.length(), expected_cells.size());
+    for (size_t i = 0; i < expected_cells.size(); ++i) {
+        auto cell = line.cell_at(i);
+        EXPECT_EQ(cell.code_point, expected_cells[i].code_point);
+        EXPECT(cell.attribute == expected_cells[i].attribute);
+        EXPECT_EQ(cell.attribute.href, expected_cells[i].attribute.href);
+        EXPECT_EQ(cell.attribute.href_id, expected_cells[i].attribute.href_id);
+    }
+}
+
+static Vector<VT::Line::Cell> cells_of(VT::Line const& line)
+{
+    Vector<VT::Line::Cell> cells;
+    for (size_t i = 0; i < line.length(); ++i)
+        cells.append(line.cell_at(i));
+    return cells;
+}
+
+TEST_CASE(compact_and_expand_round_trip)
+{
+    VT::Line line(24);
+    write(line, 0, "hello"sv, bold_attribute());
+    write(line, 6, "link"sv, link_attribute("https://example.com/a"sv, "1"sv));
+    write(line, 10, "more"sv, link_attribute("https://example.com/b"sv, "2"sv));
+    write(line, 18, "      "sv, red_background_attribute());
+    auto cells = cells_of(line);
+
+    line.compact();
+    EXPECT(line.is_compact());
+    expect_same_cells(line, cells);
+
+    // Modifying a cell expands the line again.
+    (void)line.cell_at(0);
+    EXPECT(!line.is_compact());
+    expect_same_cells(line, cells);
+}
+
+TEST_CASE(compact_keeps_adjacent_hyperlinks_apart)
+{
+    // Attribute::operator== ignores hyperlinks, so these cells would look the same to it.
+    VT::Line line(8);
+    write(line, 0, "ab"sv, link_attribute("https://example.com/a"sv, "1"sv));
+    write(line, 2, "cd"sv, link_attribute("https://example.com/b"sv, "1"sv));
+    write(line, 4, "ef"sv, link_attribute("https://example.com/b"sv, "2"sv));
+    auto cells = cells_of(line);
+
+    line.compact();
+    EXPECT_EQ(line.attribute_at(1).href, "https://example.com/a"sv);
+    EXPECT_EQ(line.attribute_at(2).href, "https://example.com/b"sv);
+    EXPECT_EQ(line.attribute_at(5).href_id, "2"sv);
+    expect_same_cells(line, cells);
+}
+
+TEST_CASE(compact_drops_trailing_blanks)
+{
+    VT::Line line(80);
+    write(line, 0, "ab"sv);
+    auto cells = cells_of(line);
+
+    line.compact();
+    EXPECT_EQ(line.length(), 80u);
+    EXPECT_EQ(line.code_point(79), static_cast<u32>(' '));
+    EXPECT(!line.is_empty());
+    expect_same_cells(line, cells);
+
+    VT::Line blank_line(80);
+    blank_line.compact();
+    EXPECT(blank_line.is_empty());
+    EXPECT(blank_line.has_only_one_background_color());
+
+    // Blanks with a background color are not empty.
+    VT::Line colored_line(80);
+    write(colored_line, 78, "  "sv, red_background_attribute());
+    colored_line.compact();
+    EXPECT(!colored_line.is_empty());
+    EXPECT(!colored_line.has_only_one_background_color());
+}
+
+TEST_CASE(compact_attribute_at_run_boundaries)
+{
+    VT::Line line(16);
+    for (size_t i = 0; i < line.length(); ++i)
+        write(line, i, "x"sv, i % 2 ? bold_attribute() : red_background_attribute());
+    auto cells = cells_of(line);
+
+    line.compact();
+    expect_same_cells(line, cells);
+}
+
+TEST_CASE(set_length_keeps_line_compact)
+{
+    VT::Line line(10);
+    write(line, 0, "abcd"sv, bold_attribute());
+    write(line, 8, "  "sv, red_background_attribute());
+    line.compact();
+
+    line.set_length(14);
+    EXPECT(line.is_compact());
+    EXPECT_EQ(line.length(), 14u);
+    EXPECT(line.attribute_at(9) == red_background_attribute());
+    EXPECT(line.attribute_at(10) == VT::Attribute());
+    EXPECT_EQ(line.code_point(13), static_cast<u32>(' '));
+
+    line.set_length(3);
+    EXPECT(line.is_compact());
+    EXPECT_EQ(line.length(), 3u);
+    EXPECT_EQ(line.code_point(2), static_cast<u32>('c'));
+    EXPECT(line.attribute_at(2) == bold_attribute());
+
+    VT::Line expected_line(3);
+    write(expected_line, 0, "abc"sv, bold_attribute());
+    (void)line.cell_at(0);
+    expect_same_cells(line, cells_of(expected_line));
+}
+
+TEST_CASE(rewrap_of_terminated_line_keeps_it_compact)
+{
+    VT::Line line(80);
+    write(line, 0, "short line"sv);
+    line.set_terminated(10);
+    line.compact();
+
+    VT::Line next_line(80);
+    write(next_line, 0, "next"sv);
+    next_line.compact();
+
+    line.rewrap(40, &next_line, nullptr);
+    EXPECT(line.is_compact());
+    EXPECT(next_line.is_compact());
+    EXPECT_EQ(line.length(), 40u);
+    EXPECT_EQ(line.code_point(9), static_cast<u32>('e'));
+
+    line.rewrap(120, &next_line, nullptr);
+    EXPECT(line.is_compact());
+    EXPECT_EQ(line.length(), 120u);
+    EXPECT_EQ(line.termination_column(), 10);
+}
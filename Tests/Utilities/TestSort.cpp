@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <LibCore/Command.h>
+#include <LibTest/Macros.h>
+#include <LibTest/TestCase.h>
+
+static void run_sort(Vector<char const*>&& arguments, StringView standard_input, StringView expected_stdout)
+{
+    MUST(arguments.try_insert(0, "sort"));
+    MUST(arguments.try_append(nullptr));
+    auto sort = MUST(Core::Command::create("sort"sv, arguments.data()));
+    MUST(sort->write(standard_input));
+    auto [stdout, stderr] = MUST(sort->read_all());
+    auto status = MUST(sort->status());
+    if (status != Core::Command::ProcessResult::DoneWithZeroExitCode) {
+        FAIL(ByteString::formatted("sort didn't exit cleanly: status: {}, stdout: {}, stderr: {}", static_cast<int>(status), StringView { stdout.bytes() }, StringView { stderr.bytes() }));
+    }
+    EXPECT_EQ(StringView { expected_stdout.bytes() }, StringView { stdout.bytes() });
+}
+
+TEST_CASE(plain)
+{
+    run_sort({}, "Well\nHello\nFriends!\n"sv, "Friends!\nHello\nWell\n"sv);
+    run_sort({ "-r" }, "Well\nHello\nFriends!\n"sv, "Well\nHello\nFriends!\n"sv);
+}
+
+TEST_CASE(key_field)
+{
+    run_sort({ "-k", "2", "-t", "," }, "a,3\nb,1\nc,2\n"sv, "b,1\nc,2\na,3\n"sv);
+    run_sort({ "-k", "2", "-n" }, "a 10\nb 9\nc 100\n"sv, "b 9\na 10\nc 100\n"sv);
+}
+
+TEST_CASE(stable_and_unique)
+{
+    run_sort({ "-k", "1", "-s" }, "b 2\na 2\nb 1\na 1\n"sv, "a 2\na 1\nb 2\nb 1\n"sv);
+    // Without -s, lines with equal keys are ordered by the whole line.
+    run_sort({ "-k", "1" }, "b 2\na 2\nb 1\na 1\n"sv, "a 1\na 2\nb 1\nb 2\n"sv);
+    // The first line of every group of equal keys is kept.
+    run_sort({ "-k", "1", "-u" }, "b 2\na 2\nb 1\na 1\n"sv, "a 2\nb 2\n"sv);
+}
+
+TEST_CASE(spill_to_temporary_files)
+{
+    // With a tiny buffer, every few lines are written to a temporary file, and there are more runs than are merged at once.
+    StringBuilder input;
+    StringBuilder expected_output;
+    for (int i = 0; i < 2000; ++i)
+        input.appendff("{}\n", (i * 7919) % 2000);
+    for (int i = 0; i < 2000; ++i)
+        expected_output.appendff("{}\n", i);
+
+    run_sort({ "-n", "-S", "1K" }, input.string_view(), expected_output.string_view());
+    run_sort({ "-n", "-S", "1K", "-u" }, ByteString::formatted("{}{}", input.string_view(), input.string_view()), expected_output.string_view());
+}
@@ -242,6 +242,9 @@ ErrorOr<void> BackgroundSettingsWidget::load_current_settings()
 
 void BackgroundSettingsWidget::apply_settings()
 {
+    // The wallpaper is decoded at a size that depends on the mode, so the mode has to be set first.
+    GUI::Desktop::the().set_wallpaper_mode(m_monitor_widget->wallpaper_mode());
+
     // We need to provide an empty path (not OptionalNone) to set_wallpaper to save a solid color wallpaper.
     auto wallpaper_path = m_monitor_widget->wallpaper().value_or(""sv);
     if (!GUI::Desktop::the().set_wallpaper(wallpaper_path)) {
@@ -252,7 +255,6 @@ void BackgroundSettingsWidget::apply_settings()
     }
 
     GUI::Desktop::the().set_background_color(m_color_input->text());
-    GUI::Desktop::the().set_wallpaper_mode(m_monitor_widget->wallpaper_mode());
 }
 
 }
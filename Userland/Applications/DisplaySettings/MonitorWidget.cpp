@@ -29,16 +29,23 @@ ErrorOr<NonnullRefPtr<MonitorWidget>> MonitorWidget::try_create()
 
 void MonitorWidget::load_wallpaper(ByteString path)
 {
+    // The preview of the other modes depends on the size of the wallpaper on the actual desktop, so it can only be
+    // decoded at the size of the preview if it's scaled to the desktop.
+    Optional<Gfx::IntSize> ideal_size;
+    if (GUI::Desktop::wallpaper_mode_scales_to_desktop(m_desktop_wallpaper_mode))
+        ideal_size = m_monitor_rect.size();
+    m_wallpaper_is_scaled_to_preview = ideal_size.has_value();
+
     (void)Threading::BackgroundAction<NonnullRefPtr<Gfx::Bitmap>>::construct(
-        [path, this](auto&) -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
+        [path, ideal_size](auto&) -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
             constexpr auto scale_factor = 1;
-            return Gfx::Bitmap::load_from_file(path, scale_factor, m_monitor_rect.size());
+            return Gfx::Bitmap::load_from_file(path, scale_factor, ideal_size);
         },
 
-        [this, path](NonnullRefPtr<Gfx::Bitmap> bitmap) -> ErrorOr<void> {
+        [this, path, ideal_size](NonnullRefPtr<Gfx::Bitmap> bitmap) -> ErrorOr<void> {
             // If we've been requested to change while we were loading the bitmap, don't bother spending the cost to
             // move and render the now stale bitmap.
-            if (is_different_to_current_wallpaper_path(path))
+            if (is_different_to_current_wallpaper_path(path) || m_wallpaper_is_scaled_to_preview != ideal_size.has_value())
                 return {};
             m_wallpaper_bitmap = move(bitmap);
             m_desktop_dirty = true;
@@ -78,6 +85,14 @@ void MonitorWidget::set_wallpaper_mode(String mode)
     if (m_desktop_wallpaper_mode == mode)
         return;
     m_desktop_wallpaper_mode = move(mode);
+
+    // A wallpaper that was decoded at the size of the preview can't be shown in its actual size.
+    if (m_wallpaper_is_scaled_to_preview && !GUI::Desktop::wallpaper_mode_scales_to_desktop(m_desktop_wallpaper_mode)) {
+        m_wallpaper_bitmap = nullptr;
+        if (m_desktop_wallpaper_path.has_value())
+            load_wallpaper(*m_desktop_wallpaper_path);
+    }
+
     m_desktop_dirty = true;
     update();
 }
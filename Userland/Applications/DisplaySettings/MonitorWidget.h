@@ -50,6 +50,7 @@ private:
 
     Optional<ByteString> m_desktop_wallpaper_path;
     RefPtr<Gfx::Bitmap> m_wallpaper_bitmap;
+    bool m_wallpaper_is_scaled_to_preview { false };
     String m_desktop_wallpaper_mode;
     Gfx::IntSize m_desktop_resolution;
     int m_desktop_scale_factor { 1 };
@@ -280,7 +280,10 @@ void do_set_wallpaper(ByteString const& file_path, GUI::Window* window)
     };
 
     constexpr auto scale_factor = 1;
-    auto bitmap_or_error = Gfx::Bitmap::load_from_file(file_path, scale_factor, GUI::Desktop::the().rect().size());
+    Optional<Gfx::IntSize> ideal_size;
+    if (GUI::Desktop::wallpaper_mode_scales_to_desktop(GUI::Desktop::the().wallpaper_mode()))
+        ideal_size = GUI::Desktop::the().rect().size();
+    auto bitmap_or_error = Gfx::Bitmap::load_from_file(file_path, scale_factor, ideal_size);
     if (bitmap_or_error.is_error()) {
         show_error();
         return;
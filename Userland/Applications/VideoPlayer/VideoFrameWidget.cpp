@@ -17,14 +17,14 @@ VideoFrameWidget::VideoFrameWidget()
     set_auto_resize(true);
 }
 
-void VideoFrameWidget::set_bitmap(Gfx::Bitmap const* bitmap)
+void VideoFrameWidget::set_video_frame(RefPtr<Media::VideoFrame> frame)
 {
-    if (m_bitmap == bitmap)
+    if (m_frame == frame)
         return;
 
-    m_bitmap = bitmap;
-    if (m_bitmap && m_auto_resize)
-        set_fixed_size(m_bitmap->size());
+    m_frame = move(frame);
+    if (m_frame && m_auto_resize)
+        set_fixed_size(frame_size());
 
     update();
 }
@@ -42,8 +42,8 @@ void VideoFrameWidget::set_auto_resize(bool value)
 {
     m_auto_resize = value;
 
-    if (m_bitmap)
-        set_fixed_size(m_bitmap->size());
+    if (m_frame)
+        set_fixed_size(frame_size());
 }
 
 void VideoFrameWidget::mousedown_event(GUI::MouseEvent&)
@@ -67,41 +67,48 @@ void VideoFrameWidget::paint_event(GUI::PaintEvent& event)
 
     painter.fill_rect(frame_inner_rect(), Gfx::Color::Black);
 
-    if (!m_bitmap)
+    if (!m_frame)
         return;
 
+    // The frame is converted and scaled straight into the window's back buffer, without an intermediate bitmap.
+    auto paint_frame = [&](Gfx::IntRect const& display_rect) {
+        auto result = m_frame->output_to_bitmap(painter.target(), display_rect.translated(painter.translation()) * painter.scale(), painter.clip_rect() * painter.scale());
+        if (result.is_error())
+            dbgln("Failed to paint video frame: {}", result.error().description());
+    };
+
     if (m_sizing_mode == VideoSizingMode::Stretch) {
-        painter.draw_scaled_bitmap(frame_inner_rect(), *m_bitmap, m_bitmap->rect(), 1.0f, Gfx::ScalingMode::BilinearBlend);
+        paint_frame(frame_inner_rect());
         return;
     }
 
     auto center = frame_inner_rect().center();
+    auto size = frame_size();
 
     if (m_sizing_mode == VideoSizingMode::FullSize) {
-        painter.blit(center.translated(-m_bitmap->width() / 2, -m_bitmap->height() / 2), *m_bitmap, m_bitmap->rect());
+        paint_frame({ center.translated(-size.width() / 2, -size.height() / 2), size });
         return;
     }
 
     VERIFY(m_sizing_mode < VideoSizingMode::Sentinel);
 
-    auto aspect_ratio = m_bitmap->width() / static_cast<float>(m_bitmap->height());
+    auto aspect_ratio = size.width() / static_cast<float>(size.height());
     auto display_aspect_ratio = frame_inner_rect().width() / static_cast<float>(frame_inner_rect().height());
 
     Gfx::IntSize display_size;
     if ((display_aspect_ratio > aspect_ratio) == (m_sizing_mode == VideoSizingMode::Fit)) {
         display_size = {
-            (frame_inner_rect().height() * m_bitmap->width()) / m_bitmap->height(),
+            (frame_inner_rect().height() * size.width()) / size.height(),
             frame_inner_rect().height(),
         };
     } else {
         display_size = {
             frame_inner_rect().width(),
-            (frame_inner_rect().width() * m_bitmap->height()) / m_bitmap->width(),
+            (frame_inner_rect().width() * size.height()) / size.width(),
         };
     }
 
-    auto display_rect = Gfx::IntRect(center.translated(-display_size.width() / 2, -display_size.height() / 2), display_size);
-    painter.draw_scaled_bitmap(display_rect, *m_bitmap, m_bitmap->rect(), 1.0f, Gfx::ScalingMode::BilinearBlend);
+    paint_frame(Gfx::IntRect(center.translated(-display_size.width() / 2, -display_size.height() / 2), display_size));
 }
 
 }
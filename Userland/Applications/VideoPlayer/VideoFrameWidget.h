@@ -9,6 +9,7 @@
 #include <AK/StringView.h>
 #include <LibGUI/Event.h>
 #include <LibGUI/Frame.h>
+#include <LibMedia/VideoFrame.h>
 
 namespace VideoPlayer {
 
@@ -25,8 +26,8 @@ class VideoFrameWidget final : public GUI::Frame {
 public:
     virtual ~VideoFrameWidget() override = default;
 
-    void set_bitmap(Gfx::Bitmap const*);
-    Gfx::Bitmap const* bitmap() const { return m_bitmap.ptr(); }
+    void set_video_frame(RefPtr<Media::VideoFrame>);
+    Media::VideoFrame* video_frame() const { return m_frame.ptr(); }
 
     void set_sizing_mode(VideoSizingMode value);
     VideoSizingMode sizing_mode() const { return m_sizing_mode; }
@@ -45,7 +46,9 @@ protected:
     virtual void paint_event(GUI::PaintEvent&) override;
 
 private:
-    RefPtr<Gfx::Bitmap const> m_bitmap;
+    Gfx::IntSize frame_size() const { return m_frame->size().to_type<int>(); }
+
+    RefPtr<Media::VideoFrame> m_frame;
     VideoSizingMode m_sizing_mode { VideoSizingMode::Fit };
     bool m_auto_resize { false };
 };
@@ -132,7 +132,7 @@ void VideoPlayerWidget::open_file(FileSystemAccessClient::File file)
     m_playback_manager = load_file_result.release_value();
 
     m_playback_manager->on_video_frame = [this](auto frame) {
-        m_video_display->set_bitmap(move(frame));
+        m_video_display->set_video_frame(move(frame));
         m_video_display->repaint();
 
         update_seek_slider_max();
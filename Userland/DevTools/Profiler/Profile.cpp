@@ -17,7 +17,9 @@
 #include <AK/Try.h>
 #include <LibCore/MappedFile.h>
 #include <LibELF/Image.h>
+#include <LibPerfcore/Reader.h>
 #include <LibSymbolication/Symbolication.h>
+#include <serenity.h>
 #include <sys/stat.h>
 
 namespace Profiler {
@@ -267,13 +269,7 @@ OwnPtr<Debug::DebugInfo> g_kernel_debug_info;
 
 ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
 {
-    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
-
-    auto json = JsonValue::from_string(TRY(file->read_until_eof()));
-    if (json.is_error() || !json.value().is_object())
-        return Error::from_string_literal("Invalid perfcore format (not a JSON object)");
-
-    auto const& object = json.value().as_object();
+    auto reader = TRY(Perfcore::Reader::open(path));
 
     if (!g_kernel_debuginfo_object.has_value()) {
         auto debuginfo_file_or_error = Core::MappedFile::map("/boot/Kernel.debug"sv);
@@ -284,102 +280,98 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         }
     }
 
-    auto strings_value = object.get_array("strings"sv);
-    if (!strings_value.has_value())
-        return Error::from_string_literal("Malformed profile (strings is not an array)");
-    auto const& strings = strings_value.value();
-
-    HashMap<FlatPtr, ByteString> profile_strings;
-    for (FlatPtr string_id = 0; string_id < strings.size(); ++string_id) {
-        auto const& value = strings.at(string_id);
-        profile_strings.set(string_id, value.as_string());
-    }
-
-    auto events_value = object.get_array("events"sv);
-    if (!events_value.has_value())
-        return Error::from_string_literal("Malformed profile (events is not an array)");
-    auto const& perf_events = events_value.value();
+    auto profile_string = [&](FlatPtr string_id) -> Optional<ByteString> {
+        if (string_id >= reader->strings().size())
+            return {};
+        return reader->strings()[string_id];
+    };
 
     Vector<NonnullOwnPtr<Process>> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
     EventSerialNumber next_serial;
 
-    for (auto const& perf_event_value : perf_events.values()) {
-        auto const& perf_event = perf_event_value.as_object();
+    // Binary perfcore files intern their stacks, so we only have to symbolicate each one once per process.
+    // Since symbolication depends on the libraries mapped into the process, the cache is reset whenever those change.
+    HashMap<u64, Vector<Frame>> symbolicated_stacks;
+
+    auto maybe_kernel_base = Symbolication::kernel_base();
 
+    Perfcore::Event perf_event;
+    while (TRY(reader->next_event(perf_event))) {
         Event event;
 
         event.serial = next_serial;
         next_serial.increment();
-        event.timestamp = perf_event.get_u64("timestamp"sv).value_or(0);
-        event.lost_samples = perf_event.get_u32("lost_samples"sv).value_or(0);
-        event.pid = perf_event.get_i32("pid"sv).value_or(0);
-        event.tid = perf_event.get_i32("tid"sv).value_or(0);
+        event.timestamp = perf_event.timestamp;
+        event.lost_samples = perf_event.lost_samples;
+        event.pid = perf_event.pid;
+        event.tid = perf_event.tid;
 
-        auto type_string = perf_event.get_byte_string("type"sv).value_or({});
-
-        if (type_string == "sample"sv) {
+        switch (perf_event.type) {
+        case PERF_EVENT_SAMPLE:
             event.data = Event::SampleData {};
-        } else if (type_string == "kmalloc"sv) {
+            break;
+        case PERF_EVENT_KMALLOC:
             event.data = Event::MallocData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = perf_event.ptr,
+                .size = perf_event.size,
             };
-        } else if (type_string == "kfree"sv) {
+            break;
+        case PERF_EVENT_KFREE:
             event.data = Event::FreeData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
+                .ptr = perf_event.ptr,
             };
-        } else if (type_string == "signpost"sv) {
-            auto string_id = perf_event.get_addr("arg1"sv).value_or(0);
+            break;
+        case PERF_EVENT_SIGNPOST: {
+            auto string_id = perf_event.arg1;
             event.data = Event::SignpostData {
-                .string = profile_strings.get(string_id).value_or(ByteString::formatted("Signpost #{}", string_id)),
-                .arg = perf_event.get_addr("arg2"sv).value_or(0),
+                .string = profile_string(string_id).value_or(ByteString::formatted("Signpost #{}", string_id)),
+                .arg = perf_event.arg2,
             };
-        } else if (type_string == "mmap"sv) {
-            auto ptr = perf_event.get_addr("ptr"sv).value_or(0);
-            auto size = perf_event.get_integer<size_t>("size"sv).value_or(0);
-            auto name = perf_event.get_byte_string("name"sv).value_or({});
-
+            break;
+        }
+        case PERF_EVENT_MMAP: {
             event.data = Event::MmapData {
-                .ptr = ptr,
-                .size = size,
-                .name = name,
+                .ptr = perf_event.ptr,
+                .size = perf_event.size,
+                .name = perf_event.name,
             };
 
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
-                it->value->library_metadata.handle_mmap(ptr, size, name);
+                it->value->library_metadata.handle_mmap(perf_event.ptr, perf_event.size, perf_event.name);
+            symbolicated_stacks.clear();
             continue;
-        } else if (type_string == "munmap"sv) {
+        }
+        case PERF_EVENT_MUNMAP:
             event.data = Event::MunmapData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = perf_event.ptr,
+                .size = perf_event.size,
             };
             continue;
-        } else if (type_string == "process_create"sv) {
-            auto parent_pid = perf_event.get_integer<pid_t>("parent_pid"sv).value_or(0);
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        case PERF_EVENT_PROCESS_CREATE: {
             event.data = Event::ProcessCreateData {
-                .parent_pid = parent_pid,
-                .executable = executable,
+                .parent_pid = perf_event.parent_pid,
+                .executable = perf_event.executable,
             };
 
             auto sampled_process = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Process {
                 .pid = event.pid,
-                .executable = executable,
-                .basename = LexicalPath::basename(executable),
+                .executable = perf_event.executable,
+                .basename = LexicalPath::basename(perf_event.executable),
                 .start_valid = event.serial,
                 .end_valid = {},
             }));
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
+            symbolicated_stacks.clear();
             continue;
-        } else if (type_string == "process_exec"sv) {
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        }
+        case PERF_EVENT_PROCESS_EXEC: {
             event.data = Event::ProcessExecData {
-                .executable = executable,
+                .executable = perf_event.executable,
             };
 
             auto* old_process = current_processes.get(event.pid).value();
@@ -389,123 +381,131 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
             auto sampled_process = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Process {
                 .pid = event.pid,
-                .executable = executable,
-                .basename = LexicalPath::basename(executable),
+                .executable = perf_event.executable,
+                .basename = LexicalPath::basename(perf_event.executable),
                 .start_valid = event.serial,
                 .end_valid = {},
             }));
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
+            symbolicated_stacks.clear();
             continue;
-        } else if (type_string == "process_exit"sv) {
+        }
+        case PERF_EVENT_PROCESS_EXIT: {
             auto* old_process = current_processes.get(event.pid).value();
             old_process->end_valid = event.serial;
 
             current_processes.remove(event.pid);
             continue;
-        } else if (type_string == "thread_create"sv) {
-            auto parent_tid = perf_event.get_integer<pid_t>("parent_tid"sv).value_or(0);
+        }
+        case PERF_EVENT_THREAD_CREATE: {
             event.data = Event::ThreadCreateData {
-                .parent_tid = parent_tid,
+                .parent_tid = perf_event.parent_tid,
             };
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_create(event.tid, event.serial);
             continue;
-        } else if (type_string == "thread_exit"sv) {
+        }
+        case PERF_EVENT_THREAD_EXIT: {
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.serial);
             continue;
-        } else if (type_string == "filesystem"sv) {
+        }
+        case PERF_EVENT_FILESYSTEM: {
+            auto const& filesystem = perf_event.filesystem;
             Event::FilesystemEventData fsdata {
-                .duration = Duration::from_nanoseconds(perf_event.get_integer<u64>("durationNs"sv).value_or(0)),
+                .duration = Duration::from_nanoseconds(filesystem.duration_ns),
                 .data = Event::OpenEventData {},
             };
-            auto const filesystem_event_type = perf_event.get("fs_event_type"sv).value_or("").as_string();
-            if (filesystem_event_type == "open"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+            auto const filename = profile_string(filesystem.filename_index).value_or("");
+            switch (filesystem.type) {
+            case Perfcore::FilesystemEventType::Open:
                 fsdata.data = Event::OpenEventData {
-                    .dirfd = perf_event.get_integer<int>("dirfd"sv).value_or(0),
+                    .dirfd = filesystem.fd,
                     .path = filename,
-                    .options = perf_event.get_integer<int>("options"sv).value_or(0),
-                    .mode = perf_event.get_integer<u64>("mode"sv).value_or(0),
+                    .options = filesystem.options,
+                    .mode = filesystem.mode,
                 };
-            } else if (filesystem_event_type == "close"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+                break;
+            case Perfcore::FilesystemEventType::Close:
                 fsdata.data = Event::CloseEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "preadv"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Perfcore::FilesystemEventType::Preadv:
                 fsdata.data = Event::PreadvEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
-                    .offset = perf_event.get_integer<off_t>("offset"sv).value_or(0),
+                    .offset = filesystem.offset,
                 };
-            } else if (filesystem_event_type == "read"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Perfcore::FilesystemEventType::Read:
                 fsdata.data = Event::ReadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "pread"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Perfcore::FilesystemEventType::Pread:
                 fsdata.data = Event::PreadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
-                    .buffer_ptr = perf_event.get_integer<FlatPtr>("buffer_ptr"sv).value_or(0),
-                    .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
-                    .offset = perf_event.get_integer<off_t>("offset"sv).value_or(0),
+                    .buffer_ptr = filesystem.buffer_ptr,
+                    .size = filesystem.size,
+                    .offset = filesystem.offset,
                 };
+                break;
             }
 
             event.data = fsdata;
-        } else {
-            dbgln("Unknown event type '{}'", type_string);
+            break;
+        }
+        default:
+            dbgln("Unknown event type '{}'", perf_event.type);
             VERIFY_NOT_REACHED();
         }
 
-        auto maybe_kernel_base = Symbolication::kernel_base();
-
-        auto stack = perf_event.get_array("stack"sv);
-        VERIFY(stack.has_value());
-        auto const& stack_array = stack.value();
-        for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
-            auto const& frame = stack_array.at(i);
-            auto ptr = frame.as_integer<u64>();
-            u32 offset = 0;
-            DeprecatedFlyString object_name;
-            ByteString symbol;
-
-            if (maybe_kernel_base.has_value() && ptr >= maybe_kernel_base.value()) {
-                if (g_kernel_debuginfo_object.has_value()) {
-                    symbol = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &offset);
-                } else {
-                    symbol = ByteString::formatted("?? <{:p}>", ptr);
-                }
-            } else {
-                auto it = current_processes.find(event.pid);
-                // FIXME: This logic is kinda gnarly, find a way to clean it up.
-                LibraryMetadata* library_metadata {};
-                if (it != current_processes.end())
-                    library_metadata = &it->value->library_metadata;
-                if (auto const* library = library_metadata ? library_metadata->library_containing(ptr) : nullptr) {
-                    object_name = library->name;
-                    symbol = library->symbolicate(ptr, &offset);
+        auto symbolicate_stack = [&] {
+            Vector<Frame> frames;
+            for (ssize_t i = perf_event.stack.size() - 1; i >= 0; --i) {
+                auto ptr = perf_event.stack[i];
+                u32 offset = 0;
+                DeprecatedFlyString object_name;
+                ByteString symbol;
+
+                if (maybe_kernel_base.has_value() && ptr >= maybe_kernel_base.value()) {
+                    if (g_kernel_debuginfo_object.has_value()) {
+                        symbol = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &offset);
+                    } else {
+                        symbol = ByteString::formatted("?? <{:p}>", ptr);
+                    }
                 } else {
-                    symbol = ByteString::formatted("?? <{:p}>", ptr);
+                    auto it = current_processes.find(event.pid);
+                    // FIXME: This logic is kinda gnarly, find a way to clean it up.
+                    LibraryMetadata* library_metadata {};
+                    if (it != current_processes.end())
+                        library_metadata = &it->value->library_metadata;
+                    if (auto const* library = library_metadata ? library_metadata->library_containing(ptr) : nullptr) {
+                        object_name = library->name;
+                        symbol = library->symbolicate(ptr, &offset);
+                    } else {
+                        symbol = ByteString::formatted("?? <{:p}>", ptr);
+                    }
                 }
+
+                frames.append({ object_name, symbol, ptr, offset });
             }
+            return frames;
+        };
 
-            event.frames.append({ object_name, symbol, (FlatPtr)ptr, offset });
+        if (perf_event.stack_id != 0) {
+            auto key = (static_cast<u64>(static_cast<u32>(event.pid)) << 32) | perf_event.stack_id;
+            event.frames = symbolicated_stacks.ensure(key, symbolicate_stack);
+        } else {
+            event.frames = symbolicate_stack();
         }
 
         if (event.frames.size() < 2)
@@ -17,6 +17,7 @@
 #include "TimelineView.h"
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <LibCore/System.h>
 #include <LibCore/Timer.h>
@@ -38,6 +39,8 @@
 #include <LibGUI/TreeView.h>
 #include <LibGUI/Window.h>
 #include <LibMain/Main.h>
+#include <LibPerfcore/Reader.h>
+#include <LibPerfcore/Writer.h>
 #include <serenity.h>
 #include <string.h>
 
@@ -49,8 +52,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     int pid = 0;
     StringView perfcore_file_arg;
+    StringView convert_to_path;
     Core::ArgsParser args_parser;
     args_parser.add_option(pid, "PID to profile", "pid", 'p', "PID");
+    args_parser.add_option(convert_to_path, "Convert the perfcore file to the binary perfcore format and exit", "convert-to", 0, "path");
     args_parser.add_positional_argument(perfcore_file_arg, "Path of perfcore file", "perfcore-file", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -59,6 +64,18 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    if (!convert_to_path.is_empty()) {
+        if (perfcore_file_arg.is_empty()) {
+            warnln("--convert-to requires a perfcore-file argument!");
+            return 1;
+        }
+        auto reader = TRY(Perfcore::Reader::open(perfcore_file_arg));
+        auto output_file = TRY(Core::File::open(convert_to_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        auto output_stream = TRY(Core::OutputBufferedFile::create(move(output_file)));
+        TRY(Perfcore::write_binary(*reader, *output_stream));
+        return 0;
+    }
+
     auto app = TRY(GUI::Application::create(arguments));
     auto app_icon = TRY(GUI::Icon::try_create_default_icon("app-profiler"sv));
 
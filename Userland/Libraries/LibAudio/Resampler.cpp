@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibAudio/Resampler.h>
+
+namespace Audio {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::load_unaligned;
+
+// Phases are exact up to this interpolation factor, which covers all conversions between the common sample rates.
+static constexpr u32 MAXIMUM_PHASE_COUNT = 512;
+// Half of the filter length in input samples, when upsampling.
+// When downsampling, the filter is stretched by the downsampling ratio to keep the same transition band.
+static constexpr size_t BASE_HALF_WIDTH = 32;
+static constexpr size_t MAXIMUM_HALF_WIDTH = 256;
+// The cutoff frequency relative to the lower of both Nyquist frequencies. The transition band is centered on it,
+// and with the filter length above, this puts the start of the stopband right at the Nyquist frequency.
+static constexpr double CUTOFF_FRACTION = 0.92;
+// Kaiser window shape parameter; this gives about 80 dB of stopband attenuation.
+static constexpr double KAISER_BETA = 8;
+
+static u32 greatest_common_divisor(u32 a, u32 b)
+{
+    while (b != 0) {
+        auto remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function of the first kind, which defines the Kaiser window.
+static double bessel_i0(double x)
+{
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 64; ++k) {
+        auto factor = x / (2 * k);
+        term *= factor * factor;
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
+
+static double windowed_sinc(double position, double cutoff, double half_width)
+{
+    static double const window_normalization = 1 / bessel_i0(KAISER_BETA);
+
+    auto relative_position = position / half_width;
+    if (relative_position <= -1 || relative_position >= 1)
+        return 0;
+
+    auto window = bessel_i0(KAISER_BETA * AK::sqrt(1 - relative_position * relative_position)) * window_normalization;
+    auto x = 2 * cutoff * position;
+    auto sinc = x == 0 ? 1 : AK::sin(AK::Pi<double> * x) / (AK::Pi<double> * x);
+    return 2 * cutoff * sinc * window;
+}
+
+ErrorOr<SincResampler> SincResampler::create(u32 source, u32 target)
+{
+    if (source == 0 || target == 0)
+        return Error::from_string_literal("Sample rates must be non-zero");
+
+    auto divisor = greatest_common_divisor(source, target);
+    u32 interpolation_factor = target / divisor;
+    u32 decimation_factor = source / divisor;
+    u32 phase_count = min(interpolation_factor, MAXIMUM_PHASE_COUNT);
+
+    auto downsampling_ratio = min(1.0, static_cast<double>(target) / static_cast<double>(source));
+    // Keeping the filter length a multiple of 8 taps lets convolve() work on whole vectors.
+    auto half_width = min(align_up_to(static_cast<size_t>(AK::ceil(BASE_HALF_WIDTH / downsampling_ratio)), 4), MAXIMUM_HALF_WIDTH);
+    auto tap_count = half_width * 2;
+    // In cycles per input sample.
+    auto cutoff = 0.5 * downsampling_ratio * CUTOFF_FRACTION;
+
+    // The extra phase is the filter for the position right at the next input sample, and is only used
+    // when interpolating between phases.
+    auto filter_bank = TRY(FixedArray<float>::create((phase_count + 1) * tap_count * 2));
+    Vector<double> coefficients;
+    TRY(coefficients.try_resize(tap_count));
+    for (u32 phase = 0; phase <= phase_count; ++phase) {
+        auto fraction = static_cast<double>(phase) / static_cast<double>(phase_count);
+        double sum = 0;
+        for (size_t tap = 0; tap < tap_count; ++tap) {
+            // Tap half_width - 1 is the input sample right before the output position.
+            auto position = static_cast<double>(tap) - static_cast<double>(half_width - 1) - fraction;
+            coefficients[tap] = windowed_sinc(position, cutoff, static_cast<double>(half_width));
+            sum += coefficients[tap];
+        }
+        // Normalize every phase to unity gain, so that there is no ripple on constant signals.
+        auto* phase_coefficients = filter_bank.data() + phase * tap_count * 2;
+        for (size_t tap = 0; tap < tap_count; ++tap) {
+            auto coefficient = static_cast<float>(coefficients[tap] / sum);
+            phase_coefficients[tap * 2] = coefficient;
+            phase_coefficients[tap * 2 + 1] = coefficient;
+        }
+    }
+
+    SincResampler resampler { source, target, interpolation_factor, decimation_factor, phase_count, tap_count, move(filter_bank) };
+    TRY(resampler.m_history.try_resize(half_width - 1));
+    return resampler;
+}
+
+SincResampler::SincResampler(u32 source, u32 target, u32 interpolation_factor, u32 decimation_factor, u32 phase_count, size_t tap_count, FixedArray<float> filter_bank)
+    : m_source(source)
+    , m_target(target)
+    , m_interpolation_factor(interpolation_factor)
+    , m_decimation_factor(decimation_factor)
+    , m_phase_count(phase_count)
+    , m_tap_count(tap_count)
+    , m_filter_bank(move(filter_bank))
+{
+}
+
+static ALWAYS_INLINE Sample convolve(Sample const* input, float const* coefficients, size_t tap_count)
+{
+    // Samples are interleaved left/right floats, and every coefficient is stored twice to match.
+    static_assert(sizeof(Sample) == 2 * sizeof(float));
+    auto const* input_data = reinterpret_cast<float const*>(input);
+
+    // Four independent sums keep the additions from waiting on each other.
+    f32x4 sums[4] {};
+    for (size_t i = 0; i < tap_count * 2; i += 16) {
+        for (size_t j = 0; j < 4; ++j)
+            sums[j] += load_unaligned<f32x4>(input_data + i + j * 4) * load_unaligned<f32x4>(coefficients + i + j * 4);
+    }
+    auto sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    return { sum[0] + sum[2], sum[1] + sum[3] };
+}
+
+Sample SincResampler::filter(size_t input_index, u32 phase) const
+{
+    auto const* input = m_history.data() + input_index;
+    auto phase_stride = m_tap_count * 2;
+
+    if (m_phase_count == m_interpolation_factor)
+        return convolve(input, m_filter_bank.data() + phase * phase_stride, m_tap_count);
+
+    auto phase_position = static_cast<double>(phase) * m_phase_count / m_interpolation_factor;
+    auto nearest_phase = static_cast<size_t>(phase_position);
+    auto weight = static_cast<float>(phase_position - nearest_phase);
+    auto below = convolve(input, m_filter_bank.data() + nearest_phase * phase_stride, m_tap_count);
+    auto above = convolve(input, m_filter_bank.data() + (nearest_phase + 1) * phase_stride, m_tap_count);
+    return below * (1 - weight) + above * weight;
+}
+
+ErrorOr<void> SincResampler::produce_output(Vector<Sample>& destination, u64 output_limit)
+{
+    while (m_total_output_samples < output_limit && m_history_position + m_tap_count <= m_history.size()) {
+        TRY(destination.try_append(filter(m_history_position, m_phase)));
+        ++m_total_output_samples;
+
+        m_phase += m_decimation_factor;
+        m_history_position += m_phase / m_interpolation_factor;
+        m_phase %= m_interpolation_factor;
+    }
+
+    // Drop the input that no future output sample depends on.
+    auto consumed_samples = min(m_history_position, m_history.size());
+    m_history.remove(0, consumed_samples);
+    m_history_position -= consumed_samples;
+    return {};
+}
+
+ErrorOr<void> SincResampler::try_resample_into_end(Vector<Sample>& destination, ReadonlySpan<Sample> input)
+{
+    TRY(m_history.try_append(input.data(), input.size()));
+    m_total_input_samples += input.size();
+
+    auto expected_output_size = (input.size() * m_interpolation_factor) / m_decimation_factor + 1;
+    TRY(destination.try_ensure_capacity(destination.size() + expected_output_size));
+    return produce_output(destination, NumericLimits<u64>::max());
+}
+
+ErrorOr<Vector<Sample>> SincResampler::try_resample(ReadonlySpan<Sample> input)
+{
+    Vector<Sample> resampled;
+    TRY(try_resample_into_end(resampled, input));
+    return resampled;
+}
+
+ErrorOr<void> SincResampler::try_flush_into_end(Vector<Sample>& destination)
+{
+    // Output sample n lies at input position n / ratio, so there is one for every position before the end of the input.
+    auto total_output_samples = (m_total_input_samples * m_interpolation_factor + m_decimation_factor - 1) / m_decimation_factor;
+
+    // Pad with silence, so that the filter can reach past the last input sample.
+    TRY(m_history.try_resize(m_history.size() + m_tap_count));
+    TRY(produce_output(destination, total_output_samples));
+    reset();
+    return {};
+}
+
+void SincResampler::reset()
+{
+    m_history.clear_with_capacity();
+    m_history.resize(m_tap_count / 2 - 1);
+    m_history_position = 0;
+    m_phase = 0;
+    m_total_input_samples = 0;
+    m_total_output_samples = 0;
+}
+
+}
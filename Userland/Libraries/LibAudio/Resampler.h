@@ -7,14 +7,17 @@
 #pragma once
 
 #include <AK/Concepts.h>
+#include <AK/FixedArray.h>
+#include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibAudio/Sample.h>
 
 namespace Audio {
 
 // Small helper to resample from one playback rate to another
 // This isn't really "smart", in that we just insert (or drop) samples.
-// Should do better...
+// Use SincResampler for audio that is going to be listened to.
 template<typename SampleType>
 class ResampleHelper {
 public:
@@ -97,4 +100,59 @@ private:
     SampleType m_last_sample_r {};
 };
 
+// Band-limited resampler for stereo audio, using a polyphase windowed-sinc filter.
+// The filter bank is computed once up front, so that each output sample is a single dot product.
+// The resampler keeps the last input samples around, so a stream can be resampled in chunks of any size
+// with the same result as resampling it in one go.
+class SincResampler {
+public:
+    static ErrorOr<SincResampler> create(u32 source, u32 target);
+
+    SincResampler(SincResampler&&) = default;
+    SincResampler& operator=(SincResampler&&) = default;
+
+    // Resamples the input and appends the result to the destination.
+    // This only allocates if the destination or the internal history need to grow.
+    ErrorOr<void> try_resample_into_end(Vector<Sample>& destination, ReadonlySpan<Sample> input);
+    ErrorOr<Vector<Sample>> try_resample(ReadonlySpan<Sample> input);
+
+    // Outputs the samples that are still held back because the filter needs input from after them.
+    // After this, the output has the length of the input, scaled by the resampling ratio.
+    ErrorOr<void> try_flush_into_end(Vector<Sample>& destination);
+
+    void reset();
+
+    u32 source() const { return m_source; }
+    u32 target() const { return m_target; }
+
+private:
+    SincResampler(u32 source, u32 target, u32 interpolation_factor, u32 decimation_factor, u32 phase_count, size_t tap_count, FixedArray<float> filter_bank);
+
+    Sample filter(size_t input_index, u32 phase) const;
+    ErrorOr<void> produce_output(Vector<Sample>& destination, u64 output_limit);
+
+    u32 m_source;
+    u32 m_target;
+
+    // The output sample rate is the input sample rate times interpolation / decimation factor.
+    u32 m_interpolation_factor;
+    u32 m_decimation_factor;
+
+    // The number of precomputed filter phases. This matches the interpolation factor unless that is too large,
+    // in which case the output is linearly interpolated between the two nearest phases.
+    u32 m_phase_count;
+    size_t m_tap_count;
+    // For each phase, tap_count coefficients that are each stored twice, once for either channel.
+    FixedArray<float> m_filter_bank;
+
+    Vector<Sample> m_history;
+    // The first input sample in m_history that the next output sample depends on, and its position
+    // between that input sample and the next in units of 1 / interpolation factor.
+    size_t m_history_position { 0 };
+    u32 m_phase { 0 };
+
+    u64 m_total_input_samples { 0 };
+    u64 m_total_output_samples { 0 };
+};
+
 }
@@ -42,6 +42,10 @@ private:
 
 #define RECYCLE_BIG_ALLOCATIONS
 
+#ifndef NO_TLS
+#    define USE_THREAD_CACHE
+#endif
+
 static pthread_mutex_t s_malloc_mutex = PTHREAD_MUTEX_INITIALIZER;
 bool __heap_is_stable = true;
 
@@ -49,6 +53,10 @@ constexpr size_t number_of_hot_chunked_blocks_to_keep_around = 16;
 constexpr size_t number_of_cold_chunked_blocks_to_keep_around = 16;
 constexpr size_t number_of_big_blocks_to_keep_around_per_size_class = 8;
 
+constexpr size_t thread_cache_max_chunk_size = 1008;
+constexpr size_t number_of_thread_cached_chunks_per_size_class = 32;
+constexpr size_t thread_cache_batch_size = number_of_thread_cached_chunks_per_size_class / 2;
+
 static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
 static bool s_scrub_free = true;
@@ -76,6 +84,11 @@ struct MallocStats {
     size_t number_of_hot_keeps;
     size_t number_of_cold_keeps;
     size_t number_of_frees;
+
+    size_t number_of_thread_cache_hits;
+    size_t number_of_thread_cache_keeps;
+    size_t number_of_thread_cache_refills;
+    size_t number_of_thread_cache_flushes;
 };
 static MallocStats g_malloc_stats = {};
 
@@ -114,6 +127,25 @@ static inline BigAllocator (&big_allocators())[1]
     return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
 }
 
+#ifdef USE_THREAD_CACHE
+// Every thread keeps a few free chunks of each of the smaller size classes around, so that most
+// malloc() and free() calls don't have to take s_malloc_mutex. Bins are refilled from and flushed
+// back to the shared allocators in batches. Since any chunk can go into any thread's cache, freeing
+// a chunk that was allocated by another thread needs no special handling.
+struct ThreadCache {
+    struct Bin {
+        FreelistEntry* chunks { nullptr };
+        size_t count { 0 };
+    };
+    Bin bins[num_size_classes];
+
+    // These are folded into g_malloc_stats whenever we take s_malloc_mutex anyway.
+    size_t number_of_hits { 0 };
+    size_t number_of_keeps { 0 };
+};
+static __thread ThreadCache s_thread_cache;
+#endif
+
 // --- BEGIN MATH ---
 // This stuff is only used for checking if there exists an aligned block in a
 // chunk. It has no bearing on the rest of the allocator, especially for
@@ -247,6 +279,193 @@ enum class CallerWillInitializeMemory {
 __thread bool __allocation_enabled = true;
 #endif
 
+// Must be called with s_malloc_mutex held.
+static ErrorOr<void*> allocate_chunk(Allocator& allocator, size_t good_size, size_t align)
+{
+    ChunkedBlock* block = nullptr;
+    void* ptr = nullptr;
+    for (auto& current : allocator.usable_blocks) {
+        if (current.free_chunks()) {
+            ptr = try_allocate_chunk_aligned(align, current);
+            if (ptr) {
+                block = &current;
+                break;
+            }
+        }
+    }
+
+    if (!block && s_hot_empty_block_count) {
+        g_malloc_stats.number_of_hot_empty_block_hits++;
+        block = s_hot_empty_blocks[--s_hot_empty_block_count];
+        if (block->m_size != good_size) {
+            new (block) ChunkedBlock(good_size);
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+            set_mmap_name(block, ChunkedBlock::block_size, buffer);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block && s_cold_empty_block_count) {
+        g_malloc_stats.number_of_cold_empty_block_hits++;
+        block = s_cold_empty_blocks[--s_cold_empty_block_count];
+        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
+        bool this_block_was_purged = rc == 1;
+        if (rc < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
+        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
+        if (rc < 0) {
+            perror("mprotect");
+            VERIFY_NOT_REACHED();
+        }
+        if (this_block_was_purged || block->m_size != good_size) {
+            if (this_block_was_purged)
+                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
+            new (block) ChunkedBlock(good_size);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block) {
+        g_malloc_stats.number_of_block_allocs++;
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
+        new (block) ChunkedBlock(good_size);
+        allocator.usable_blocks.append(*block);
+        ++allocator.block_count;
+    }
+
+    if (!ptr) {
+        ptr = try_allocate_chunk_aligned(align, *block);
+    }
+
+    VERIFY(ptr);
+    if (block->is_full()) {
+        g_malloc_stats.number_of_blocks_full++;
+        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
+        allocator.usable_blocks.remove(*block);
+        allocator.full_blocks.append(*block);
+    }
+    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+
+    return ptr;
+}
+
+// Must be called with s_malloc_mutex held.
+static void free_chunk(ChunkedBlock* block, void* ptr)
+{
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block->m_freelist;
+    block->m_freelist = entry;
+
+    if (block->is_full()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
+        g_malloc_stats.number_of_freed_full_blocks++;
+        allocator->full_blocks.remove(*block);
+        allocator->usable_blocks.prepend(*block);
+    }
+
+    ++block->m_free_chunks;
+
+    if (!block->used_chunks()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
+            g_malloc_stats.number_of_hot_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
+            return;
+        }
+        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
+            g_malloc_stats.number_of_cold_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
+            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
+            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
+            return;
+        }
+        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
+        g_malloc_stats.number_of_frees++;
+        allocator->usable_blocks.remove(*block);
+        --allocator->block_count;
+        os_free(block, ChunkedBlock::block_size);
+    }
+}
+
+#ifdef USE_THREAD_CACHE
+static void fold_thread_cache_stats()
+{
+    g_malloc_stats.number_of_malloc_calls += s_thread_cache.number_of_hits;
+    g_malloc_stats.number_of_thread_cache_hits += exchange(s_thread_cache.number_of_hits, 0);
+    g_malloc_stats.number_of_free_calls += s_thread_cache.number_of_keeps;
+    g_malloc_stats.number_of_thread_cache_keeps += exchange(s_thread_cache.number_of_keeps, 0);
+}
+
+static ErrorOr<void*> allocate_from_thread_cache(Allocator& allocator, size_t good_size)
+{
+    auto& bin = s_thread_cache.bins[&allocator - allocators()];
+    if (!bin.count) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        fold_thread_cache_stats();
+        g_malloc_stats.number_of_thread_cache_refills++;
+        for (size_t i = 0; i < thread_cache_batch_size; ++i) {
+            auto ptr_or_error = allocate_chunk(allocator, good_size, 16);
+            if (ptr_or_error.is_error()) {
+                if (!bin.count)
+                    return ptr_or_error.release_error();
+                break;
+            }
+            auto* entry = (FreelistEntry*)ptr_or_error.value();
+            entry->next = bin.chunks;
+            bin.chunks = entry;
+            ++bin.count;
+        }
+    }
+
+    ++s_thread_cache.number_of_hits;
+    --bin.count;
+    return exchange(bin.chunks, bin.chunks->next);
+}
+
+static void free_into_thread_cache(ChunkedBlock* block, void* ptr)
+{
+    size_t good_size;
+    auto* allocator = allocator_for_size(block->m_size, good_size);
+    auto& bin = s_thread_cache.bins[allocator - allocators()];
+
+    if (bin.count == number_of_thread_cached_chunks_per_size_class) {
+        // Give the chunks that have been cached the longest back to the allocator, and keep the recently freed (and probably still hot) ones.
+        auto* last_kept_entry = bin.chunks;
+        for (size_t i = 1; i < number_of_thread_cached_chunks_per_size_class - thread_cache_batch_size; ++i)
+            last_kept_entry = last_kept_entry->next;
+        auto* entry = exchange(last_kept_entry->next, nullptr);
+        bin.count -= thread_cache_batch_size;
+
+        PthreadMutexLocker locker(s_malloc_mutex);
+        fold_thread_cache_stats();
+        g_malloc_stats.number_of_thread_cache_flushes++;
+        while (entry) {
+            auto* next = entry->next;
+            free_chunk((ChunkedBlock*)((FlatPtr)entry & ChunkedBlock::block_mask), entry);
+            entry = next;
+        }
+    }
+
+    ++s_thread_cache.number_of_keeps;
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = bin.chunks;
+    bin.chunks = entry;
+    ++bin.count;
+}
+#endif
+
 static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializeMemory caller_will_initialize_memory)
 {
 #ifndef NO_TLS
@@ -270,12 +489,21 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         size = 1;
     }
 
-    g_malloc_stats.number_of_malloc_calls++;
-
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size, align);
 
+#ifdef USE_THREAD_CACHE
+    // NOTE: Every chunk is at least 16-byte aligned, so any cached chunk will do for a regular malloc().
+    if (allocator && align <= 16 && good_size <= thread_cache_max_chunk_size) {
+        auto* ptr = TRY(allocate_from_thread_cache(*allocator, good_size));
+        if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+            memset(ptr, MALLOC_SCRUB_BYTE, good_size);
+        return ptr;
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
+    g_malloc_stats.number_of_malloc_calls++;
 
     if (!allocator) {
         size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size + ((align > 16) ? align : 0), ChunkedBlock::block_size);
@@ -314,77 +542,10 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         return reinterpret_cast<void*>(round_up_to_power_of_two(reinterpret_cast<uintptr_t>(&block->m_slot[0]), align));
     }
 
-    ChunkedBlock* block = nullptr;
-    void* ptr = nullptr;
-    for (auto& current : allocator->usable_blocks) {
-        if (current.free_chunks()) {
-            ptr = try_allocate_chunk_aligned(align, current);
-            if (ptr) {
-                block = &current;
-                break;
-            }
-        }
-    }
-
-    if (!block && s_hot_empty_block_count) {
-        g_malloc_stats.number_of_hot_empty_block_hits++;
-        block = s_hot_empty_blocks[--s_hot_empty_block_count];
-        if (block->m_size != good_size) {
-            new (block) ChunkedBlock(good_size);
-            char buffer[64];
-            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-            set_mmap_name(block, ChunkedBlock::block_size, buffer);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block && s_cold_empty_block_count) {
-        g_malloc_stats.number_of_cold_empty_block_hits++;
-        block = s_cold_empty_blocks[--s_cold_empty_block_count];
-        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
-        bool this_block_was_purged = rc == 1;
-        if (rc < 0) {
-            perror("madvise");
-            VERIFY_NOT_REACHED();
-        }
-        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
-        if (rc < 0) {
-            perror("mprotect");
-            VERIFY_NOT_REACHED();
-        }
-        if (this_block_was_purged || block->m_size != good_size) {
-            if (this_block_was_purged)
-                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
-            new (block) ChunkedBlock(good_size);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block) {
-        g_malloc_stats.number_of_block_allocs++;
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
-        new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(*block);
-        ++allocator->block_count;
-    }
-
-    if (!ptr) {
-        ptr = try_allocate_chunk_aligned(align, *block);
-    }
-
-    VERIFY(ptr);
-    if (block->is_full()) {
-        g_malloc_stats.number_of_blocks_full++;
-        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
-        allocator->usable_blocks.remove(*block);
-        allocator->full_blocks.append(*block);
-    }
-    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+    auto* ptr = TRY(allocate_chunk(*allocator, good_size, align));
 
     if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
-        memset(ptr, MALLOC_SCRUB_BYTE, block->m_size);
+        memset(ptr, MALLOC_SCRUB_BYTE, good_size);
 
     return ptr;
 }
@@ -400,12 +561,24 @@ static void free_impl(void* ptr)
     if (!ptr)
         return;
 
-    g_malloc_stats.number_of_free_calls++;
-
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
+#ifdef USE_THREAD_CACHE
+    if (magic == MAGIC_PAGE_HEADER) {
+        // NOTE: The size of a block only changes once all of its chunks are free, so we can look at it without holding the lock.
+        auto* block = (ChunkedBlock*)block_base;
+        if (block->m_size <= thread_cache_max_chunk_size) {
+            if (s_scrub_free)
+                memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+            free_into_thread_cache(block, ptr);
+            return;
+        }
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
+    g_malloc_stats.number_of_free_calls++;
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
         auto* block = (BigAllocationBlock*)block_base;
@@ -440,46 +613,7 @@ static void free_impl(void* ptr)
     if (s_scrub_free)
         memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
-
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
-        g_malloc_stats.number_of_freed_full_blocks++;
-        allocator->full_blocks.remove(*block);
-        allocator->usable_blocks.prepend(*block);
-    }
-
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
-            g_malloc_stats.number_of_hot_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
-            return;
-        }
-        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
-            g_malloc_stats.number_of_cold_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
-            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
-            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
-            return;
-        }
-        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
-        g_malloc_stats.number_of_frees++;
-        allocator->usable_blocks.remove(*block);
-        --allocator->block_count;
-        os_free(block, ChunkedBlock::block_size);
-    }
+    free_chunk(block, ptr);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/malloc.html
@@ -611,8 +745,54 @@ void __malloc_init()
     new (&big_allocators()[0])(BigAllocator);
 }
 
+void __malloc_flush_thread_cache()
+{
+#ifdef USE_THREAD_CACHE
+    PthreadMutexLocker locker(s_malloc_mutex);
+    fold_thread_cache_stats();
+    for (auto& bin : s_thread_cache.bins) {
+        if (!bin.count)
+            continue;
+        g_malloc_stats.number_of_thread_cache_flushes++;
+        while (bin.chunks) {
+            auto* entry = exchange(bin.chunks, bin.chunks->next);
+            free_chunk((ChunkedBlock*)((FlatPtr)entry & ChunkedBlock::block_mask), entry);
+        }
+        bin.count = 0;
+    }
+#endif
+}
+
+void serenity_get_malloc_stats(struct serenity_malloc_stats* stats)
+{
+    PthreadMutexLocker locker(s_malloc_mutex);
+#ifdef USE_THREAD_CACHE
+    fold_thread_cache_stats();
+#endif
+
+    // NOTE: Other threads only report their thread cache hits when they next take the lock, so those may lag behind a bit.
+    stats->malloc_call_count = g_malloc_stats.number_of_malloc_calls;
+    stats->free_call_count = g_malloc_stats.number_of_free_calls;
+    stats->thread_cache_hit_count = g_malloc_stats.number_of_thread_cache_hits;
+    stats->thread_cache_keep_count = g_malloc_stats.number_of_thread_cache_keeps;
+    stats->thread_cache_refill_count = g_malloc_stats.number_of_thread_cache_refills;
+    stats->thread_cache_flush_count = g_malloc_stats.number_of_thread_cache_flushes;
+
+    stats->chunked_block_count = 0;
+    for (auto const& allocator : allocators())
+        stats->chunked_block_count += allocator.block_count;
+    stats->empty_chunked_block_count = s_hot_empty_block_count + s_cold_empty_block_count;
+    stats->big_allocation_count = g_malloc_stats.number_of_big_allocs;
+}
+
 void serenity_dump_malloc_stats()
 {
+#ifdef USE_THREAD_CACHE
+    {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        fold_thread_cache_stats();
+    }
+#endif
     dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
     dbgln();
     dbgln("big alloc hits: {}", g_malloc_stats.number_of_big_allocator_hits);
@@ -634,5 +814,10 @@ void serenity_dump_malloc_stats()
     dbgln("number of hot keeps: {}", g_malloc_stats.number_of_hot_keeps);
     dbgln("number of cold keeps: {}", g_malloc_stats.number_of_cold_keeps);
     dbgln("number of frees: {}", g_malloc_stats.number_of_frees);
+    dbgln();
+    dbgln("thread cache hits: {}", g_malloc_stats.number_of_thread_cache_hits);
+    dbgln("thread cache keeps: {}", g_malloc_stats.number_of_thread_cache_keeps);
+    dbgln("thread cache refills: {}", g_malloc_stats.number_of_thread_cache_refills);
+    dbgln("thread cache flushes: {}", g_malloc_stats.number_of_thread_cache_flushes);
 }
 }
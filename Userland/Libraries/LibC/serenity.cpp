@@ -101,6 +101,26 @@ int anon_create(size_t size, int options)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+int create_event_queue(int flags)
+{
+    int rc = syscall(SC_create_event_queue, flags);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int event_queue_ctl(int queue_fd, int operation, int fd, struct event_queue_event const* event)
+{
+    Syscall::SC_event_queue_ctl_params params { queue_fd, operation, fd, event };
+    int rc = syscall(SC_event_queue_ctl, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int event_queue_wait(int queue_fd, struct event_queue_event* events, size_t max_events, struct timespec const* timeout)
+{
+    Syscall::SC_event_queue_wait_params params { queue_fd, events, max_events, timeout };
+    int rc = syscall(SC_event_queue_wait, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int setkeymap(char const* name, u32 const* map, u32* const shift_map, u32 const* alt_map, u32 const* altgr_map, u32 const* shift_altgr_map)
 {
     Syscall::SC_setkeymap_params params { map, shift_map, alt_map, altgr_map, shift_altgr_map, { name, strlen(name) } };
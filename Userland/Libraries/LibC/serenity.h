@@ -61,6 +61,10 @@ int get_stack_bounds(uintptr_t* user_stack_base, size_t* user_stack_size);
 
 int anon_create(size_t size, int options);
 
+int create_event_queue(int flags);
+int event_queue_ctl(int queue_fd, int operation, int fd, struct event_queue_event const* event);
+int event_queue_wait(int queue_fd, struct event_queue_event* events, size_t max_events, struct timespec const* timeout);
+
 int getkeymap(char* name_buffer, size_t name_buffer_size, uint32_t* map, uint32_t* shift_map, uint32_t* alt_map, uint32_t* altgr_map, uint32_t* shift_altgr_map);
 int setkeymap(char const* name, uint32_t const* map, uint32_t* const shift_map, uint32_t const* alt_map, uint32_t const* altgr_map, uint32_t const* shift_altgr_map);
 
@@ -22,6 +22,19 @@ __attribute__((malloc)) __attribute__((alloc_size(1, 2))) void* calloc(size_t nm
 size_t malloc_size(void const*);
 size_t malloc_good_size(size_t);
 void serenity_dump_malloc_stats(void);
+
+struct serenity_malloc_stats {
+    size_t malloc_call_count;
+    size_t free_call_count;
+    size_t thread_cache_hit_count;
+    size_t thread_cache_keep_count;
+    size_t thread_cache_refill_count;
+    size_t thread_cache_flush_count;
+    size_t chunked_block_count;
+    size_t empty_chunked_block_count;
+    size_t big_allocation_count;
+};
+void serenity_get_malloc_stats(struct serenity_malloc_stats*);
 void free(void*);
 __attribute__((alloc_size(2))) void* realloc(void* ptr, size_t);
 char* getenv(char const* name);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinaryHeap.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
@@ -263,6 +264,10 @@ struct ThreadData {
         pthread_rwlock_wrlock(&*s_thread_data_lock);
         s_thread_data.remove(s_thread_id);
         pthread_rwlock_unlock(&*s_thread_data_lock);
+#ifdef AK_OS_SERENITY
+        if (event_queue_fd != -1)
+            close(event_queue_fd);
+#endif
     }
 
     void initialize_wake_pipe()
@@ -284,6 +289,74 @@ struct ThreadData {
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+
+#ifdef AK_OS_SERENITY
+        initialize_event_queue();
+#endif
+    }
+
+#ifdef AK_OS_SERENITY
+    // With an event queue, the kernel keeps the set of fds we're waiting on, so we don't have to pass all of them
+    // on every iteration like with poll(). If it can't be created, we just keep using poll().
+    void initialize_event_queue()
+    {
+        // NOTE: After a fork, this is still the parent's event queue. Closing it doesn't affect the parent.
+        if (event_queue_fd != -1)
+            close(event_queue_fd);
+        event_queue_fd = -1;
+
+        auto result = Core::System::create_event_queue(EVENT_QUEUE_CLOEXEC);
+        if (result.is_error()) {
+            dbgln("EventLoopImplementationUnix: Failed to create event queue, falling back to poll(): {}", result.error());
+            return;
+        }
+        event_queue_fd = result.release_value();
+
+        // The wake pipe is registered with the ID 0, which no notifier can have.
+        event_queue_event event { .id = 0, .events = POLLIN, .flags = 0 };
+        if (auto add_result = Core::System::event_queue_ctl(event_queue_fd, EVENT_QUEUE_CTL_ADD, wake_pipe_fds[0], event); add_result.is_error()) {
+            dbgln("EventLoopImplementationUnix: Failed to register wake pipe, falling back to poll(): {}", add_result.error());
+            close(event_queue_fd);
+            event_queue_fd = -1;
+        }
+    }
+#endif
+
+    ErrorOr<int> wait_for_fds(int timeout)
+    {
+#ifdef AK_OS_SERENITY
+        if (event_queue_fd != -1)
+            return Core::System::event_queue_wait(event_queue_fd, ready_events, timeout);
+#endif
+        return Core::System::poll(poll_fds, timeout);
+    }
+
+    bool wake_pipe_is_readable([[maybe_unused]] int marked_fd_count) const
+    {
+#ifdef AK_OS_SERENITY
+        if (event_queue_fd != -1) {
+            return any_of(ready_events.span().trim(marked_fd_count), [](auto& event) {
+                return event.id == 0 && has_flag(event.events, POLLIN);
+            });
+        }
+#endif
+        return has_flag(poll_fds[0].revents, POLLIN);
+    }
+
+    template<typename Callback>
+    void for_each_ready_notifier([[maybe_unused]] int marked_fd_count, Callback callback)
+    {
+#ifdef AK_OS_SERENITY
+        if (event_queue_fd != -1) {
+            for (auto& event : ready_events.span().trim(marked_fd_count)) {
+                if (event.id != 0)
+                    callback(*bit_cast<Notifier*>(static_cast<FlatPtr>(event.id)), event.events);
+            }
+            return;
+        }
+#endif
+        for (size_t i = 1; i < poll_fds.size(); ++i)
+            callback(*notifier_by_index[i], poll_fds[i].revents);
     }
 
     // Each thread has its own timers, notifiers and a wake pipe.
@@ -298,6 +371,12 @@ struct ThreadData {
     Array<int, 2> wake_pipe_fds { -1, -1 };
 
     pid_t pid { 0 };
+
+#ifdef AK_OS_SERENITY
+    // Mirrors poll_fds, with the notifier's address as the ID of its registration.
+    int event_queue_fd { -1 };
+    Array<event_queue_event, 64> ready_events;
+#endif
 };
 }
 
@@ -383,7 +462,7 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
-    ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+    ErrorOr<int> error_or_marked_fd_count = thread_data.wait_for_fds(should_wait_forever ? -1 : timeout);
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
@@ -395,7 +474,7 @@ try_select_again:
 
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (thread_data.wake_pipe_is_readable(error_or_marked_fd_count.value())) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -426,10 +505,7 @@ try_select_again:
 
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
-        for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
-            auto& revents = thread_data.poll_fds[i].revents;
-            auto& notifier = *thread_data.notifier_by_index[i];
-
+        thread_data.for_each_ready_notifier(error_or_marked_fd_count.value(), [](Notifier& notifier, short revents) {
             NotificationType type = NotificationType::None;
             if (has_flag(revents, POLLIN))
                 type |= NotificationType::Read;
@@ -444,7 +520,7 @@ try_select_again:
 
             if (type != NotificationType::None)
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
-        }
+        });
     }
 
     // Handle expired timers.
@@ -688,6 +764,14 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .revents = 0,
     });
 
+#ifdef AK_OS_SERENITY
+    if (thread_data.event_queue_fd != -1) {
+        event_queue_event event { .id = bit_cast<FlatPtr>(&notifier), .events = notification_type_to_poll_events(notifier.type()), .flags = 0 };
+        if (auto result = System::event_queue_ctl(thread_data.event_queue_fd, EVENT_QUEUE_CTL_ADD, notifier.fd(), event); result.is_error())
+            dbgln("EventLoopImplementationUnix::register_notifier: {}", result.error());
+    }
+#endif
+
     notifier.set_owner_thread(s_thread_id);
 }
 
@@ -711,6 +795,14 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+
+#ifdef AK_OS_SERENITY
+    if (thread_data.event_queue_fd != -1) {
+        // NOTE: This fails if registering the notifier did, which we already complained about.
+        event_queue_event event { .id = bit_cast<FlatPtr>(&notifier), .events = 0, .flags = 0 };
+        (void)System::event_queue_ctl(thread_data.event_queue_fd, EVENT_QUEUE_CTL_REMOVE, -1, event);
+    }
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
@@ -35,6 +35,7 @@
 #    include <serenity.h>
 #    include <sys/prctl.h>
 #    include <sys/ptrace.h>
+#    include <sys/sendfile.h>
 #    include <sys/sysmacros.h>
 #endif
 
@@ -263,6 +264,14 @@ ErrorOr<int> recvfd(int sockfd, int options)
     return fd;
 }
 
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    auto rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
 ErrorOr<void> ptrace_peekbuf(pid_t tid, void const* tracee_addr, Bytes destination_buf)
 {
     Syscall::SC_ptrace_buf_params buf_params {
@@ -412,6 +421,28 @@ ErrorOr<void> profiling_free_buffer(pid_t pid)
     int rc = ::profiling_free_buffer(pid);
     HANDLE_SYSCALL_RETURN_VALUE("profiling_free_buffer", rc, {});
 }
+
+ErrorOr<int> create_event_queue(int flags)
+{
+    int rc = syscall(SC_create_event_queue, flags);
+    HANDLE_SYSCALL_RETURN_VALUE("create_event_queue", rc, rc);
+}
+
+ErrorOr<void> event_queue_ctl(int queue_fd, int operation, int fd, event_queue_event const& event)
+{
+    Syscall::SC_event_queue_ctl_params params { queue_fd, operation, fd, &event };
+    int rc = syscall(SC_event_queue_ctl, &params);
+    HANDLE_SYSCALL_RETURN_VALUE("event_queue_ctl", rc, {});
+}
+
+ErrorOr<int> event_queue_wait(int queue_fd, Span<event_queue_event> events, int timeout)
+{
+    // Like with poll(), the timeout is in milliseconds and a negative timeout waits forever.
+    timespec timeout_spec { timeout / 1000, (timeout % 1000) * 1'000'000 };
+    Syscall::SC_event_queue_wait_params params { queue_fd, events.data(), events.size(), timeout < 0 ? nullptr : &timeout_spec };
+    int rc = syscall(SC_event_queue_wait, &params);
+    HANDLE_SYSCALL_RETURN_VALUE("event_queue_wait", rc, rc);
+}
 #endif
 
 #if !defined(AK_OS_BSD_GENERIC)
@@ -47,6 +47,7 @@
 
 #ifdef AK_OS_SERENITY
 #    include <Kernel/API/Unshare.h>
+#    include <serenity.h>
 #endif
 
 namespace Core::System {
@@ -60,6 +61,7 @@ ErrorOr<void> unveil(StringView path, StringView permissions);
 ErrorOr<void> unveil_after_exec(StringView path, StringView permissions);
 ErrorOr<void> sendfd(int sockfd, int fd);
 ErrorOr<int> recvfd(int sockfd, int options);
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
 ErrorOr<void> ptrace_peekbuf(pid_t tid, void const* tracee_addr, Bytes destination_buf);
 ErrorOr<void> mount(Optional<i32> vfs_context_id, int source_fd, StringView target, StringView fs_type, int flags);
 ErrorOr<void> bindmount(Optional<i32> vfs_context_id, int source_fd, StringView target, int flags);
@@ -73,6 +75,9 @@ ErrorOr<void> disown(pid_t pid);
 ErrorOr<void> profiling_enable(pid_t, u64 event_mask);
 ErrorOr<void> profiling_disable(pid_t);
 ErrorOr<void> profiling_free_buffer(pid_t);
+ErrorOr<int> create_event_queue(int flags);
+ErrorOr<void> event_queue_ctl(int queue_fd, int operation, int fd, event_queue_event const&);
+ErrorOr<int> event_queue_wait(int queue_fd, Span<event_queue_event>, int timeout);
 #else
 inline ErrorOr<void> unveil(StringView, StringView)
 {
@@ -24,6 +24,7 @@
 #include <LibELF/DynamicLoader.h>
 #include <LibELF/DynamicObject.h>
 #include <LibELF/Hashes.h>
+#include <LibELF/SymbolResolutionCache.h>
 #include <bits/dlfcn_integration.h>
 #include <bits/pthread_integration.h>
 #include <dlfcn.h>
@@ -70,11 +71,17 @@ static ByteString s_cwd;
 static bool s_allowed_to_check_environment_variables { false };
 static bool s_do_breakpoint_trap_before_entry { false };
 static StringView s_ld_library_path;
+static StringView s_symbol_cache_directory;
 static StringView s_main_program_pledge_promises;
 static ByteString s_loader_pledge_promises;
 
 static HashMap<StringView, DynamicObject::SymbolLookupResult> s_magic_functions;
 
+// Most symbols are referenced by many objects, e.g. every library imports malloc() and the AK and LibCore
+// functions. Objects are only ever appended to s_global_objects, so a symbol that was found once will be
+// found in the same object by every later lookup.
+static HashMap<ByteString, DynamicObject::SymbolLookupResult> s_global_symbol_cache;
+
 Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(StringView name)
 {
     auto symbol = DynamicObject::HashSymbol { name };
@@ -93,10 +100,56 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
     return {};
 }
 
+// If the program was started with the same objects before, this tells us which object defines each symbol.
+static OwnPtr<SymbolResolutionCache> s_persistent_symbol_cache;
+// The objects that were mapped when the program started, in load order.
+static Vector<SymbolResolutionCache::ObjectIdentity> s_initial_object_identities;
+static Vector<NonnullRefPtr<DynamicObject>> s_initial_objects;
+
+static Optional<DynamicObject::SymbolLookupResult> lookup_symbol_in_persistent_cache(StringView name)
+{
+    auto symbol = DynamicObject::HashSymbol { name };
+    auto object_index = s_persistent_symbol_cache->object_index_for_symbol(name, symbol.gnu_hash());
+    if (!object_index.has_value())
+        return {};
+
+    // The cache only matches if every object is the same file as last time, so no object that comes earlier
+    // in load order can define this symbol either.
+    auto result = s_initial_objects[object_index.value()]->lookup_symbol(symbol);
+    if (!result.has_value() || (result->bind != STB_GLOBAL && result->bind != STB_WEAK))
+        return {};
+    return result;
+}
+
+Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol_cached(StringView name)
+{
+    if (auto cached_result = s_global_symbol_cache.get(name); cached_result.has_value())
+        return cached_result.release_value();
+
+    Optional<DynamicObject::SymbolLookupResult> result;
+    if (s_persistent_symbol_cache)
+        result = lookup_symbol_in_persistent_cache(name);
+    if (!result.has_value())
+        result = lookup_global_symbol(name);
+    // Symbols that weren't found might still be provided by an object that is loaded later, and magic
+    // functions can be overridden by later objects too.
+    if (result.has_value() && result->dynamic_object != nullptr)
+        s_global_symbol_cache.set(name, *result);
+    return result;
+}
+
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(ByteString const& filepath, int fd)
 {
     VERIFY(filepath.starts_with('/'));
 
+    if (!s_symbol_cache_directory.is_empty()) {
+        auto identity_or_error = SymbolResolutionCache::ObjectIdentity::from_fd(filepath, fd);
+        if (identity_or_error.is_error())
+            s_symbol_cache_directory = {};
+        else
+            s_initial_object_identities.append(identity_or_error.release_value());
+    }
+
     auto loader = TRY(ELF::DynamicLoader::try_create(fd, filepath));
 
     static size_t s_current_tls_offset = 0;
@@ -163,6 +216,41 @@ Optional<ByteString> DynamicLinker::resolve_library(ByteString const& name, Dyna
     return {};
 }
 
+static void open_persistent_symbol_cache()
+{
+    VERIFY(s_initial_object_identities.size() == s_global_objects.size());
+
+    auto cache_path = SymbolResolutionCache::path_for_program(s_symbol_cache_directory, s_main_program_path);
+    s_persistent_symbol_cache = SymbolResolutionCache::open(cache_path, s_initial_object_identities);
+    if (!s_persistent_symbol_cache)
+        return;
+
+    s_initial_objects.ensure_capacity(s_global_objects.size());
+    for (auto& it : s_global_objects)
+        s_initial_objects.unchecked_append(it.value);
+}
+
+static void write_persistent_symbol_cache()
+{
+    HashMap<DynamicObject const*, u32> object_indices;
+    u32 object_index = 0;
+    for (auto& it : s_global_objects)
+        object_indices.set(it.value.ptr(), object_index++);
+
+    Vector<SymbolResolutionCache::Resolution> resolutions;
+    resolutions.ensure_capacity(s_global_symbol_cache.size());
+    for (auto& it : s_global_symbol_cache) {
+        resolutions.unchecked_append({
+            .symbol_name = it.key,
+            .object_index = object_indices.get(it.value.dynamic_object).value(),
+        });
+    }
+
+    auto cache_path = SymbolResolutionCache::path_for_program(s_symbol_cache_directory, s_main_program_path);
+    if (auto result = SymbolResolutionCache::write(cache_path, s_initial_object_identities, resolutions); result.is_error())
+        dbgln_if(DYNAMIC_LOAD_DEBUG, "Failed to write symbol resolution cache {}: {}", cache_path, result.error());
+}
+
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(ByteString const& path)
 {
     VERIFY(path.starts_with('/'));
@@ -631,6 +719,11 @@ static void read_environment_variables()
             s_ld_library_path = env_string.substring_view(library_path_string.length());
         }
 
+        constexpr auto symbol_cache_directory_string = "LD_SYMBOL_CACHE_DIRECTORY="sv;
+        if (env_string.starts_with(symbol_cache_directory_string)) {
+            s_symbol_cache_directory = env_string.substring_view(symbol_cache_directory_string.length());
+        }
+
         constexpr auto main_pledge_promises_key = "_LOADER_MAIN_PROGRAM_PLEDGE_PROMISES="sv;
         if (env_string.starts_with(main_pledge_promises_key)) {
             s_main_program_pledge_promises = env_string.substring_view(main_pledge_promises_key.length());
@@ -680,6 +773,10 @@ EntryPointFunction ELF::DynamicLinker::linker_main(ByteString&& main_program_pat
     if (s_allowed_to_check_environment_variables)
         read_environment_variables();
 
+    // A pledged loader would be killed for writing the cache, so pledged programs go without one.
+    if (!s_main_program_pledge_promises.is_empty() || !s_loader_pledge_promises.is_empty())
+        s_symbol_cache_directory = {};
+
     s_main_program_path = main_program_path;
 
     // NOTE: We always map the main library first, since it may require
@@ -733,12 +830,20 @@ Examples of static-pie ELF objects are ELF packers, and the system dynamic loade
 
     allocate_tls(objects.load_order);
 
+    if (!s_symbol_cache_directory.is_empty())
+        open_persistent_symbol_cache();
+
     auto result = link_main_library(RTLD_GLOBAL | RTLD_LAZY, objects);
     if (result.is_error()) {
         warnln("{}", result.error().text);
         _exit(1);
     }
 
+    if (!s_symbol_cache_directory.is_empty() && !s_persistent_symbol_cache)
+        write_persistent_symbol_cache();
+    // Objects loaded by dlopen() later on aren't part of the cache.
+    s_symbol_cache_directory = {};
+
     drop_loader_promise("rpath"sv);
 
     auto& main_executable_loader = objects.load_order.first();
@@ -518,7 +518,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_direct_relocation(DynamicObjec
         // in large inheritance hierarchies are involved, there might be tens of references to
         // the same symbol. We can avoid redundant lookups by keeping track of the previous result.
         if (!cached_result.has_value() || !cached_result.value().symbol.definitely_equals(symbol))
-            cached_result = DynamicLoader::CachedLookupResult { symbol, DynamicLoader::lookup_symbol(symbol) };
+            cached_result = DynamicLoader::CachedLookupResult { symbol, DynamicLoader::lookup_symbol(symbol, UseGlobalSymbolCache::Yes) };
         return cached_result.value().result;
     };
 
@@ -818,10 +818,13 @@ void DynamicLoader::call_object_init_functions()
     }
 }
 
-Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const ELF::DynamicObject::Symbol& symbol)
+Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const ELF::DynamicObject::Symbol& symbol, UseGlobalSymbolCache use_global_symbol_cache)
 {
-    if (symbol.is_undefined() || symbol.bind() == STB_WEAK)
+    if (symbol.is_undefined() || symbol.bind() == STB_WEAK) {
+        if (use_global_symbol_cache == UseGlobalSymbolCache::Yes)
+            return DynamicLinker::lookup_global_symbol_cached(symbol.name());
         return DynamicLinker::lookup_global_symbol(symbol.name());
+    }
 
     return DynamicObject::SymbolLookupResult { symbol.value(), symbol.size(), symbol.address(), symbol.bind(), symbol.type(), &symbol.object() };
 }
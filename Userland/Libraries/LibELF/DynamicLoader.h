@@ -80,7 +80,11 @@ public:
     Vector<LoadedSegment> const text_segments() const { return m_text_segments; }
     bool is_dynamic() const { return image().is_dynamic(); }
 
-    static Optional<DynamicObject::SymbolLookupResult> lookup_symbol(const ELF::DynamicObject::Symbol&);
+    enum class UseGlobalSymbolCache {
+        No,
+        Yes,
+    };
+    static Optional<DynamicObject::SymbolLookupResult> lookup_symbol(const ELF::DynamicObject::Symbol&, UseGlobalSymbolCache = UseGlobalSymbolCache::No);
     void copy_initial_tls_data_into(Bytes buffer) const;
 
     DynamicObject& dynamic_object() { return *m_dynamic_object; }
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/IntegralMath.h>
+#include <AK/LexicalPath.h>
+#include <AK/ScopeGuard.h>
+#include <LibELF/Hashes.h>
+#include <LibELF/SymbolResolutionCache.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ELF {
+
+// The cache file consists of a header, followed by the identities of the objects in load order, an
+// open-addressing hash table of symbols keyed by their GNU hash, and finally the names of the objects and symbols.
+// It is only ever read back on the machine that wrote it, so everything is stored in native byte order.
+static constexpr u32 cache_magic = 0x4c445343; // "LDSC"
+static constexpr u32 cache_version = 1;
+
+struct CacheHeader {
+    u32 magic;
+    u32 version;
+    u32 object_count;
+    u32 bucket_count;
+    u32 string_table_size;
+    u32 reserved;
+};
+
+struct CachedObject {
+    u64 device;
+    u64 inode;
+    u64 size;
+    i64 modification_seconds;
+    i64 modification_nanoseconds;
+    u32 path_offset;
+    u32 path_length;
+};
+
+struct CachedSymbol {
+    u32 gnu_hash;
+    u32 name_offset;
+    u32 name_length;
+    u32 object_index;
+};
+
+static constexpr u32 empty_bucket = NumericLimits<u32>::max();
+
+static size_t objects_offset() { return sizeof(CacheHeader); }
+static size_t buckets_offset(CacheHeader const& header) { return objects_offset() + header.object_count * sizeof(CachedObject); }
+static size_t strings_offset(CacheHeader const& header) { return buckets_offset(header) + header.bucket_count * sizeof(CachedSymbol); }
+
+ErrorOr<SymbolResolutionCache::ObjectIdentity> SymbolResolutionCache::ObjectIdentity::from_fd(ByteString path, int fd)
+{
+    struct stat stat;
+    if (fstat(fd, &stat) < 0)
+        return Error::from_errno(errno);
+
+    return ObjectIdentity {
+        .path = move(path),
+        .device = static_cast<u64>(stat.st_dev),
+        .inode = static_cast<u64>(stat.st_ino),
+        .size = static_cast<u64>(stat.st_size),
+        .modification_seconds = stat.st_mtim.tv_sec,
+        .modification_nanoseconds = stat.st_mtim.tv_nsec,
+    };
+}
+
+ByteString SymbolResolutionCache::path_for_program(StringView cache_directory, StringView program_path)
+{
+    return ByteString::formatted("{}/{}-{:08x}.ldcache", cache_directory, LexicalPath::basename(program_path), program_path.hash());
+}
+
+OwnPtr<SymbolResolutionCache> SymbolResolutionCache::open(ByteString const& path, Vector<ObjectIdentity> const& objects)
+{
+    int fd = ::open(path.characters(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    ScopeGuard close_fd = [fd] { close(fd); };
+
+    struct stat stat;
+    if (fstat(fd, &stat) < 0 || static_cast<size_t>(stat.st_size) < sizeof(CacheHeader))
+        return nullptr;
+    auto size = static_cast<size_t>(stat.st_size);
+
+    auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return nullptr;
+    auto cache = adopt_own(*new SymbolResolutionCache(static_cast<u8 const*>(data), size));
+
+    auto const& header = *reinterpret_cast<CacheHeader const*>(cache->m_data);
+    if (header.magic != cache_magic || header.version != cache_version)
+        return nullptr;
+    if (header.bucket_count == 0 || !is_power_of_two(header.bucket_count))
+        return nullptr;
+    if (header.object_count != objects.size())
+        return nullptr;
+    if (strings_offset(header) + header.string_table_size != size)
+        return nullptr;
+
+    auto const* cached_objects = reinterpret_cast<CachedObject const*>(cache->m_data + objects_offset());
+    auto const* strings = reinterpret_cast<char const*>(cache->m_data + strings_offset(header));
+    for (size_t i = 0; i < objects.size(); ++i) {
+        auto const& cached_object = cached_objects[i];
+        if (static_cast<size_t>(cached_object.path_offset) + cached_object.path_length > header.string_table_size)
+            return nullptr;
+        auto const& object = objects[i];
+        if (StringView { strings + cached_object.path_offset, cached_object.path_length } != object.path
+            || cached_object.device != object.device
+            || cached_object.inode != object.inode
+            || cached_object.size != object.size
+            || cached_object.modification_seconds != object.modification_seconds
+            || cached_object.modification_nanoseconds != object.modification_nanoseconds)
+            return nullptr;
+    }
+
+    return cache;
+}
+
+ErrorOr<void> SymbolResolutionCache::write(ByteString const& path, Vector<ObjectIdentity> const& objects, Vector<Resolution> const& resolutions)
+{
+    Vector<u8> strings;
+    auto append_string = [&](StringView string) -> ErrorOr<u32> {
+        auto offset = static_cast<u32>(strings.size());
+        TRY(strings.try_append(string.bytes().data(), string.length()));
+        return offset;
+    };
+
+    Vector<CachedObject> cached_objects;
+    TRY(cached_objects.try_ensure_capacity(objects.size()));
+    for (auto const& object : objects) {
+        cached_objects.unchecked_append({
+            .device = object.device,
+            .inode = object.inode,
+            .size = object.size,
+            .modification_seconds = object.modification_seconds,
+            .modification_nanoseconds = object.modification_nanoseconds,
+            .path_offset = TRY(append_string(object.path)),
+            .path_length = static_cast<u32>(object.path.length()),
+        });
+    }
+
+    // Keep the table at most half full, so that probe sequences stay short.
+    u32 bucket_count = 1u << AK::ceil_log2(max<u32>(resolutions.size() * 2, 1));
+    Vector<CachedSymbol> buckets;
+    TRY(buckets.try_resize(bucket_count));
+    for (auto& bucket : buckets)
+        bucket.object_index = empty_bucket;
+
+    for (auto const& resolution : resolutions) {
+        VERIFY(resolution.object_index < objects.size());
+        auto gnu_hash = compute_gnu_hash(resolution.symbol_name);
+        auto index = gnu_hash & (bucket_count - 1);
+        while (buckets[index].object_index != empty_bucket)
+            index = (index + 1) & (bucket_count - 1);
+        buckets[index] = {
+            .gnu_hash = gnu_hash,
+            .name_offset = TRY(append_string(resolution.symbol_name)),
+            .name_length = static_cast<u32>(resolution.symbol_name.length()),
+            .object_index = resolution.object_index,
+        };
+    }
+
+    CacheHeader header {
+        .magic = cache_magic,
+        .version = cache_version,
+        .object_count = static_cast<u32>(objects.size()),
+        .bucket_count = bucket_count,
+        .string_table_size = static_cast<u32>(strings.size()),
+        .reserved = 0,
+    };
+
+    // Write to a temporary file first, so that a process starting at the same time never sees a partial cache.
+    auto temporary_path = ByteString::formatted("{}.{}", path, getpid());
+    int fd = ::open(temporary_path.characters(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+        return Error::from_errno(errno);
+    bool did_rename = false;
+    ScopeGuard clean_up = [&] {
+        close(fd);
+        if (!did_rename)
+            unlink(temporary_path.characters());
+    };
+
+    auto write_all = [fd](ReadonlyBytes bytes) -> ErrorOr<void> {
+        while (!bytes.is_empty()) {
+            auto nwritten = ::write(fd, bytes.data(), bytes.size());
+            if (nwritten < 0)
+                return Error::from_errno(errno);
+            bytes = bytes.slice(nwritten);
+        }
+        return {};
+    };
+    TRY(write_all({ &header, sizeof(header) }));
+    TRY(write_all({ cached_objects.data(), cached_objects.size() * sizeof(CachedObject) }));
+    TRY(write_all({ buckets.data(), buckets.size() * sizeof(CachedSymbol) }));
+    TRY(write_all(strings.span()));
+
+    if (rename(temporary_path.characters(), path.characters()) < 0)
+        return Error::from_errno(errno);
+    did_rename = true;
+    return {};
+}
+
+SymbolResolutionCache::SymbolResolutionCache(u8 const* data, size_t size)
+    : m_data(data)
+    , m_size(size)
+{
+}
+
+SymbolResolutionCache::~SymbolResolutionCache()
+{
+    munmap(const_cast<u8*>(m_data), m_size);
+}
+
+Optional<u32> SymbolResolutionCache::object_index_for_symbol(StringView name, u32 gnu_hash) const
+{
+    auto const& header = *reinterpret_cast<CacheHeader const*>(m_data);
+    auto const* buckets = reinterpret_cast<CachedSymbol const*>(m_data + buckets_offset(header));
+    auto const* strings = reinterpret_cast<char const*>(m_data + strings_offset(header));
+
+    for (u32 probe = 0, index = gnu_hash & (header.bucket_count - 1); probe < header.bucket_count; ++probe, index = (index + 1) & (header.bucket_count - 1)) {
+        auto const& bucket = buckets[index];
+        if (bucket.object_index == empty_bucket)
+            return {};
+        if (bucket.gnu_hash != gnu_hash)
+            continue;
+        if (static_cast<size_t>(bucket.name_offset) + bucket.name_length > header.string_table_size)
+            return {};
+        if (StringView { strings + bucket.name_offset, bucket.name_length } != name)
+            continue;
+        if (bucket.object_index >= header.object_count)
+            return {};
+        return bucket.object_index;
+    }
+    return {};
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace ELF {
+
+// Remembers in which object each symbol was found the last time a program was started. When the program is
+// started again with exactly the same objects, the loader only has to look each symbol up in that one object,
+// instead of walking every object in load order until one of them defines it.
+class SymbolResolutionCache {
+public:
+    // Our toolchain doesn't emit build IDs, so the identity of the file stands in for one. A library that was
+    // rebuilt or replaced gets a new inode or modification time, which invalidates the cache.
+    struct ObjectIdentity {
+        ByteString path;
+        u64 device { 0 };
+        u64 inode { 0 };
+        u64 size { 0 };
+        i64 modification_seconds { 0 };
+        i64 modification_nanoseconds { 0 };
+
+        static ErrorOr<ObjectIdentity> from_fd(ByteString path, int fd);
+    };
+
+    struct Resolution {
+        StringView symbol_name;
+        u32 object_index { 0 };
+    };
+
+    static ByteString path_for_program(StringView cache_directory, StringView program_path);
+
+    // Returns nullptr if there's no cache for exactly these objects, in this order.
+    static OwnPtr<SymbolResolutionCache> open(ByteString const& path, Vector<ObjectIdentity> const& objects);
+    static ErrorOr<void> write(ByteString const& path, Vector<ObjectIdentity> const& objects, Vector<Resolution> const& resolutions);
+
+    ~SymbolResolutionCache();
+
+    // Returns the index into the load order of the object that defined this symbol last time.
+    Optional<u32> object_index_for_symbol(StringView name, u32 gnu_hash) const;
+
+private:
+    SymbolResolutionCache(u8 const* data, size_t size);
+
+    u8 const* m_data { nullptr };
+    size_t m_size { 0 };
+};
+
+}
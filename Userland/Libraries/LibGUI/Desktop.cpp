@@ -49,6 +49,11 @@ void Desktop::set_wallpaper_mode(StringView mode)
     ConnectionToWindowServer::the().async_set_wallpaper_mode(mode);
 }
 
+ByteString Desktop::wallpaper_mode() const
+{
+    return ConnectionToWindowServer::the().get_wallpaper_mode();
+}
+
 ByteString Desktop::wallpaper_path() const
 {
     return Config::read_string("WindowManager"sv, "Background"sv, "Wallpaper"sv);
@@ -66,7 +71,10 @@ bool Desktop::apply_wallpaper(RefPtr<Gfx::Bitmap const> wallpaper_bitmap, Option
 
     if (!wallpaper_bitmap && path.has_value() && !path->is_empty()) {
         constexpr auto scale_factor = 1;
-        auto maybe_wallpaper_bitmap = Gfx::Bitmap::load_from_file(*path, scale_factor, rect().size());
+        Optional<Gfx::IntSize> ideal_size;
+        if (wallpaper_mode_scales_to_desktop(wallpaper_mode()))
+            ideal_size = rect().size();
+        auto maybe_wallpaper_bitmap = Gfx::Bitmap::load_from_file(*path, scale_factor, ideal_size);
         if (maybe_wallpaper_bitmap.is_error()) {
             dbgln("Failed to load wallpaper bitmap from path: {}", maybe_wallpaper_bitmap.error());
             return false;
@@ -30,6 +30,10 @@ public:
     void set_background_color(StringView background_color);
 
     void set_wallpaper_mode(StringView mode);
+    ByteString wallpaper_mode() const;
+
+    // Wallpapers are only scaled to the desktop in some modes, so they can be decoded at a smaller size.
+    static bool wallpaper_mode_scales_to_desktop(StringView mode) { return mode == "Stretch"sv || mode == "Fill"sv; }
 
     ByteString wallpaper_path() const;
     RefPtr<Gfx::Bitmap> wallpaper_bitmap() const;
@@ -44,6 +44,10 @@ TextDocument::TextDocument(Client* client)
 
 bool TextDocument::set_text(StringView text, AllowCallback allow_callback, IsNewDocument is_new_document)
 {
+    // The lines refer to our copy of the text until they are edited. Copy it before the old lines are
+    // removed, in case the text is part of the old copy.
+    auto text_storage = ByteBuffer::copy(text.bytes()).release_value_but_fixme_should_propagate_errors();
+
     m_client_notifications_enabled = false;
     if (is_new_document == IsNewDocument::Yes)
         m_undo_stack.clear();
@@ -51,10 +55,15 @@ bool TextDocument::set_text(StringView text, AllowCallback allow_callback, IsNew
     m_folding_regions.clear();
     remove_all_lines();
 
+    m_text_storage = move(text_storage);
+    text = StringView { m_text_storage.bytes() };
+
     ArmedScopeGuard clear_text_guard([this]() {
         set_text({});
     });
 
+    m_lines.ensure_capacity(text.count('\n') + 1);
+
     size_t start_of_current_line = 0;
 
     auto add_line = [&](size_t current_position) -> bool {
@@ -63,7 +72,7 @@ bool TextDocument::set_text(StringView text, AllowCallback allow_callback, IsNew
 
         bool success = true;
         if (line_length)
-            success = line->set_text(*this, text.substring_view(start_of_current_line, current_position - start_of_current_line));
+            success = line->set_text_without_copying(*this, text.substring_view(start_of_current_line, current_position - start_of_current_line));
 
         if (!success)
             return false;
@@ -126,6 +135,8 @@ void TextDocument::insert_line(size_t line_index, NonnullOwnPtr<TextDocumentLine
 NonnullOwnPtr<TextDocumentLine> TextDocument::take_line(size_t line_index)
 {
     auto line = lines().take(line_index);
+    // The line might outlive our copy of the text it refers to.
+    (void)line->code_points();
     if (m_client_notifications_enabled) {
         for (auto* client : m_clients)
             client->document_did_remove_line(line_index);
@@ -189,7 +200,10 @@ ByteString TextDocument::text() const
     StringBuilder builder;
     for (size_t i = 0; i < line_count(); ++i) {
         auto& line = this->line(i);
-        builder.append(line.view());
+        if (auto undecoded_text = line.undecoded_text(); !undecoded_text.is_null())
+            builder.append(undecoded_text);
+        else
+            builder.append(line.view());
         if (i != line_count() - 1)
             builder.append('\n');
     }
@@ -499,6 +513,14 @@ TextRange TextDocument::find_previous(StringView needle, TextPosition const& sta
 
 Vector<TextRange> TextDocument::find_all(StringView needle, bool regmatch, bool match_case)
 {
+    if (needle.is_empty())
+        return {};
+
+    // A needle without line breaks can only match within a single line, so we can search the lines
+    // directly instead of going through find_next() one position at a time.
+    if (!regmatch && !needle.contains('\n'))
+        return find_all_within_lines(needle, match_case);
+
     Vector<TextRange> ranges;
 
     TextPosition position;
@@ -512,6 +534,56 @@ Vector<TextRange> TextDocument::find_all(StringView needle, bool regmatch, bool
     return ranges;
 }
 
+Vector<TextRange> TextDocument::find_all_within_lines(StringView needle, bool match_case) const
+{
+    Vector<u32> needle_code_points;
+    for (u32 code_point : Utf8View(needle))
+        needle_code_points.append(match_case ? code_point : Unicode::to_unicode_lowercase(code_point));
+    auto needle_length = needle_code_points.size();
+    auto first_code_point = needle_code_points.first();
+
+    auto matches_at = [&](auto const* code_points) {
+        for (size_t i = 0; i < needle_length; ++i) {
+            u32 code_point = match_case ? code_points[i] : Unicode::to_unicode_lowercase(code_points[i]);
+            if (code_point != needle_code_points[i])
+                return false;
+        }
+        return true;
+    };
+
+    Vector<TextRange> ranges;
+    auto search_line = [&](size_t line_index, auto const* code_points, size_t length) {
+        auto last_start = length - needle_length;
+        for (size_t column = 0; column <= last_start;) {
+            if (match_case && code_points[column] != first_code_point) {
+                ++column;
+                continue;
+            }
+            if (!matches_at(code_points + column)) {
+                ++column;
+                continue;
+            }
+            // Compute the end the same way find_next() does, so that both paths agree on the ranges they produce.
+            TextPosition last_matched_position { line_index, column + needle_length - 1 };
+            ranges.append({ { line_index, column }, next_position_after(last_matched_position, SearchShouldWrap::No) });
+            column += needle_length;
+        }
+    };
+
+    for (size_t line_index = 0; line_index < line_count(); ++line_index) {
+        auto const& line = this->line(line_index);
+        if (line.length() < needle_length)
+            continue;
+
+        // Lines that are still pure ASCII text don't have to be decoded to be searched.
+        if (auto undecoded_text = line.undecoded_text(); !undecoded_text.is_null() && undecoded_text.length() == line.length())
+            search_line(line_index, undecoded_text.bytes().data(), line.length());
+        else
+            search_line(line_index, line.code_points(), line.length());
+    }
+    return ranges;
+}
+
 Optional<TextDocumentSpan> TextDocument::first_non_skippable_span_before(TextPosition const& position) const
 {
     for (int i = m_spans.size() - 1; i >= 0; --i) {
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
@@ -135,7 +136,12 @@ protected:
     explicit TextDocument(Client* client);
 
 private:
+    Vector<TextRange> find_all_within_lines(StringView needle, bool match_case) const;
+
+    // FIXME: Every line is still a separate allocation, even while it only refers to m_text_storage.
     Vector<NonnullOwnPtr<TextDocumentLine>> m_lines;
+    // The text passed to set_text(). Lines refer to it until they are edited or their code points are needed.
+    ByteBuffer m_text_storage;
 
     HashTable<Client*> m_clients;
     bool m_client_notifications_enabled { true };
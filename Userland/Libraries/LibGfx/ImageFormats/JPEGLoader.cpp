@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/CPUFeatures.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -13,6 +15,9 @@
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
@@ -20,9 +25,17 @@
 #include <LibGfx/ImageFormats/JPEGShared.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Gfx {
 
+using AK::SIMD::f32x8;
+using AK::SIMD::i16x8;
+using AK::SIMD::i32x8;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::simd_cast;
+using AK::SIMD::store_unaligned;
+
 struct MacroblockMeta {
     u32 total { 0 };
     u32 padded_total { 0 };
@@ -415,12 +428,26 @@ struct Scan {
     HuffmanStream huffman_stream;
 
     u64 end_of_bands_run_count { 0 };
+    Array<i16, 4> previous_dc_values {};
 
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
     {
         return components.size() != 1;
     }
+
+    // Returns a scan with the same parameters that reads from another stream, in the state it has at the start
+    // of a restart interval.
+    Scan with_stream(JPEGStream& stream) const
+    {
+        Scan scan { HuffmanStream { stream } };
+        scan.components = components;
+        scan.spectral_selection_start = spectral_selection_start;
+        scan.spectral_selection_end = spectral_selection_end;
+        scan.successive_approximation_high = successive_approximation_high;
+        scan.successive_approximation_low = successive_approximation_low;
+        return scan;
+    }
 };
 
 enum class ColorTransform {
@@ -432,16 +459,17 @@ enum class ColorTransform {
 };
 
 struct JPEGLoadingContext {
-    JPEGLoadingContext(JPEGStream jpeg_stream, JPEGDecoderOptions options)
-        : stream(move(jpeg_stream))
+    JPEGLoadingContext(ReadonlyBytes data, JPEGStream jpeg_stream, JPEGDecoderOptions options)
+        : data(data)
+        , stream(move(jpeg_stream))
         , options(options)
     {
     }
 
-    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(NonnullOwnPtr<Stream> stream, JPEGDecoderOptions options)
+    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(ReadonlyBytes data, JPEGDecoderOptions options)
     {
-        auto jpeg_stream = TRY(JPEGStream::create(move(stream)));
-        return make<JPEGLoadingContext>(move(jpeg_stream), options);
+        auto jpeg_stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(data))));
+        return make<JPEGLoadingContext>(data, move(jpeg_stream), options);
     }
 
     enum State {
@@ -472,13 +500,26 @@ struct JPEGLoadingContext {
     Array<bool, 4> registered_dc_tables {};
     Array<HuffmanTable, 4> ac_tables {};
     Array<bool, 4> registered_ac_tables {};
-    Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
+
+    // The whole file, which stream reads from.
+    ReadonlyBytes data;
     JPEGStream stream;
     JPEGDecoderOptions options;
 
     Optional<ColorTransform> color_transform {};
 
+    // Decoded blocks are block_size x block_size pixels, stored without padding at the start of each block.
+    // This is less than 8 when decoding a downscaled image, see inverse_dct().
+    u8 block_size { 8 };
+
+    u32 pixels_per_block() const { return block_size * block_size; }
+
+    IntSize decoded_size() const
+    {
+        return { ceil_div<u32>(frame.width * block_size, 8), ceil_div<u32>(frame.height * block_size, 8) };
+    }
+
     OwnPtr<ExifMetadata> exif_metadata {};
 
     Optional<ICCMultiChunkState> icc_multi_chunk_state;
@@ -518,10 +559,9 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto& dc_table = context.dc_tables[scan_component.dc_destination_id];
-    auto& scan = *context.current_scan;
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -549,7 +589,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = scan.previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -593,13 +633,11 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto& ac_table = context.ac_tables[scan_component.ac_destination_id];
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -721,14 +759,14 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.sampling_factors.vertical; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.sampling_factors.horizontal; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
+                if (!scan.are_components_interleaved()) {
                     macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.sampling_factors.vertical) + (vfactor_i * scan_component.component.sampling_factors.horizontal));
 
                     // A.2.4 Completion of partial MCU
@@ -746,17 +784,17 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
                 Macroblock& block = macroblocks[macroblock_index];
 
                 if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
                 } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    if (scan.spectral_selection_start == 0)
+                        TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    if (scan.spectral_selection_end != 0)
+                        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
 
                     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
+                    if (scan.end_of_bands_run_count > 0) {
+                        --scan.end_of_bands_run_count;
                         continue;
                     }
                 }
@@ -779,33 +817,142 @@ static bool is_dct_based(StartOfFrame::FrameType frame_type)
         || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan)
 {
     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
+    scan.end_of_bands_run_count = 0;
 
     // E.2.4 Control procedure for decoding a restart interval
     if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
+        scan.previous_dc_values = {};
         return;
     }
 
     VERIFY_NOT_REACHED();
 }
 
+static ErrorOr<void> decode_mcu(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+{
+    if (is_progressive(context.frame.type))
+        return build_macroblocks<JPEGDecodingMode::Progressive>(context, scan, macroblocks, hcursor, vcursor);
+    return build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, macroblocks, hcursor, vcursor);
+}
+
+// Splits the entropy-coded data of a scan into its restart intervals, and sets scan_size to the offset of the marker
+// that ends the scan. Returns an empty vector if the end of the scan can't be found.
+static ErrorOr<Vector<ReadonlyBytes>> split_at_restart_markers(ReadonlyBytes data, size_t& scan_size)
+{
+    // B.1.1.5 - Entropy-coded data segments
+    // Inside of a scan, 0xFF bytes are followed by a stuffed zero byte, fill bytes or a marker.
+    Vector<ReadonlyBytes> intervals;
+    size_t interval_start = 0;
+    for (size_t i = 0; i + 1 < data.size(); ++i) {
+        if (data[i] != 0xFF)
+            continue;
+
+        auto const marker_offset = i;
+        while (i + 1 < data.size() && data[i + 1] == 0xFF)
+            ++i;
+        if (i + 1 == data.size())
+            break;
+
+        Marker const marker = 0xFF00 | data[++i];
+        if (marker == 0xFF00)
+            continue;
+
+        TRY(intervals.try_append(data.slice(interval_start, marker_offset - interval_start)));
+        if (marker < JPEG_RST0 || marker > JPEG_RST7) {
+            scan_size = marker_offset;
+            return intervals;
+        }
+        interval_start = i + 1;
+    }
+
+    return Vector<ReadonlyBytes> {};
+}
+
+// E.2.4 Control procedure for decoding a restart interval
+// Restart intervals don't depend on each other, so they can be decoded concurrently. This splits up the scan at its
+// restart markers instead of reading it through context.stream, and returns false if that's not possible.
+static ErrorOr<bool> decode_restart_intervals_in_parallel(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    if (context.dc_restart_interval == 0 || Threading::parallel_worker_count() == 0)
+        return false;
+
+    // This visits the MCUs in the same order as decode_huffman_stream().
+    u32 const mcus_per_row = context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+    u32 const mcu_count = ceil_div<u32>(context.mblock_meta.vcount, context.sampling_factors.vertical) * mcus_per_row;
+    u32 const interval_count = ceil_div<u32>(mcu_count, context.dc_restart_interval);
+    if (interval_count < 2)
+        return false;
+
+    size_t scan_size = 0;
+    auto const scan_data = context.data.slice(context.stream.byte_offset());
+    auto const intervals = TRY(split_at_restart_markers(scan_data, scan_size));
+
+    // Let the sequential decoder deal with broken files.
+    if (intervals.size() != interval_count)
+        return false;
+
+    // Restart intervals are often only a single MCU row or less, so each task decodes a batch of consecutive
+    // intervals. A few batches per thread are enough to keep all of them busy if some batches take longer.
+    static constexpr size_t batches_per_thread = 4;
+    u32 const maximum_batch_count = (Threading::parallel_worker_count() + 1) * batches_per_thread;
+    u32 const intervals_per_batch = ceil_div(interval_count, min(interval_count, maximum_batch_count));
+    u32 const batch_count = ceil_div(interval_count, intervals_per_batch);
+
+    auto const& scan = *context.current_scan;
+    TRY(Threading::for_each_in_parallel(batch_count, [&](size_t batch) -> ErrorOr<void> {
+        u32 const first_interval = batch * intervals_per_batch;
+        u32 const end_interval = min(first_interval + intervals_per_batch, interval_count);
+
+        // The batch is read from the scan data in place. The huffman stream may look ahead into the intervals of
+        // the next batch, but it never reads past the marker that ends the scan.
+        auto const batch_offset = intervals[first_interval].data() - scan_data.data();
+        auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(scan_data.slice(batch_offset)))));
+        auto batch_scan = scan.with_stream(stream);
+
+        for (u32 interval = first_interval; interval < end_interval; ++interval) {
+            if (interval != first_interval) {
+                // Skip the restart marker between two intervals, like decode_huffman_stream() does.
+                reset_decoder(context, batch_scan);
+                TRY(batch_scan.huffman_stream.advance_to_byte_boundary());
+                TRY(batch_scan.huffman_stream.discard_bits(8));
+            }
+
+            u32 const first_mcu = interval * context.dc_restart_interval;
+            u32 const end_mcu = min(first_mcu + context.dc_restart_interval, mcu_count);
+            for (u32 mcu = first_mcu; mcu < end_mcu; ++mcu) {
+                u32 const vcursor = (mcu / mcus_per_row) * context.sampling_factors.vertical;
+                u32 const hcursor = (mcu % mcus_per_row) * context.sampling_factors.horizontal;
+                TRY(decode_mcu(context, batch_scan, macroblocks, hcursor, vcursor));
+            }
+        }
+        return {};
+    }));
+
+    TRY(context.stream.discard(scan_size));
+    return true;
+}
+
 static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
+    // FIXME: This is likely wrong for non-interleaved scans.
+    VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
+
+    if (TRY(decode_restart_intervals_in_parallel(context, macroblocks)))
+        return {};
+
+    auto& scan = *context.current_scan;
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            // FIXME: This is likely wrong for non-interleaved scans.
-            VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
             u32 number_of_mcus_decoded_so_far = ((vcursor / context.sampling_factors.vertical) * context.mblock_meta.hpadded_count + hcursor) / context.sampling_factors.horizontal;
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+            auto& huffman_stream = scan.huffman_stream;
 
             if (context.dc_restart_interval > 0) {
                 if (number_of_mcus_decoded_so_far != 0 && number_of_mcus_decoded_so_far % context.dc_restart_interval == 0) {
-                    reset_decoder(context);
+                    reset_decoder(context, scan);
 
                     // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
                     //  the 0th bit of the next byte.
@@ -816,13 +963,7 @@ static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<M
                 }
             }
 
-            auto result = [&]() {
-                if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
-            }();
-
-            if (result.is_error()) {
+            if (auto result = decode_mcu(context, scan, macroblocks, hcursor, vcursor); result.is_error()) {
                 if constexpr (JPEG_DEBUG) {
                     dbgln("Failed to build Macroblock {}: {}", number_of_mcus_decoded_so_far, result.error());
                     dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
@@ -1399,10 +1540,24 @@ static ErrorOr<void> skip_segment(JPEGStream& stream)
     return {};
 }
 
+// A range of macroblock rows that starts and ends on MCU boundaries.
+// Once all scans are decoded, the macroblocks of different ranges can be turned into pixels independently.
+struct MacroblockRows {
+    u32 first { 0 };
+    u32 end { 0 };
+};
+
+static Span<Macroblock> macroblocks_in(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, MacroblockRows rows)
+{
+    auto const first = rows.first * context.mblock_meta.hpadded_count;
+    auto const end = min(rows.end, context.mblock_meta.vpadded_count) * context.mblock_meta.hpadded_count;
+    return macroblocks.span().slice(first, end - first);
+}
+
 template<CallableAs<void, Component const&, i16*> F>
-static void for_each_macroblock_component(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, F&& component_handler)
+static void for_each_macroblock_component(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, MacroblockRows rows, F&& component_handler)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
+    for (u32 vcursor = rows.first; vcursor < min(rows.end, context.mblock_meta.vcount); vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             for (u32 i = 0; i < context.components.size(); i++) {
                 auto const& component = context.components[i];
@@ -1425,13 +1580,19 @@ static void dequantize(JPEGLoadingContext const& context, Component const& compo
 {
     auto const& quantization_table = context.quantization_tables[component.quantization_table_id];
 
-    for (u32 k = 0; k < 64; k++)
-        block_component[k] *= quantization_table[k];
+    // When decoding at a reduced size, the higher frequencies are never used.
+    for (u32 v = 0; v < context.block_size; v++) {
+        for (u32 u = 0; u < context.block_size; u++) {
+            auto const k = v * 8 + u;
+            block_component[k] *= quantization_table[k];
+        }
+    }
 }
 
-static void inverse_dct_8x8(i16* block_component)
+// Applies the 1-D IDCT to eight independent sets of coefficients at once, one per vector lane.
+// values[u] holds the u-th coefficient of every set, and is replaced by the u-th output sample.
+ALWAYS_INLINE static void inverse_dct_8_points(f32x8 (&values)[8])
 {
-    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
     // The 1-D DCT idea is described at https://unix4lyfe.org/dct-1d/, read aan.cc from bottom to top.
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -1448,145 +1609,183 @@ static void inverse_dct_8x8(i16* block_component)
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
-    }
-    for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
+    f32x8 const g0 = values[0] * s0;
+    f32x8 const g1 = values[4] * s4;
+    f32x8 const g2 = values[2] * s2;
+    f32x8 const g3 = values[6] * s6;
+    f32x8 const g4 = values[5] * s5;
+    f32x8 const g5 = values[1] * s1;
+    f32x8 const g6 = values[7] * s7;
+    f32x8 const g7 = values[3] * s3;
+
+    f32x8 const f0 = g0;
+    f32x8 const f1 = g1;
+    f32x8 const f2 = g2;
+    f32x8 const f3 = g3;
+    f32x8 const f4 = g4 - g7;
+    f32x8 const f5 = g5 + g6;
+    f32x8 const f6 = g5 - g6;
+    f32x8 const f7 = g4 + g7;
+
+    f32x8 const e0 = f0;
+    f32x8 const e1 = f1;
+    f32x8 const e2 = f2 - f3;
+    f32x8 const e3 = f2 + f3;
+    f32x8 const e4 = f4;
+    f32x8 const e5 = f5 - f7;
+    f32x8 const e6 = f6;
+    f32x8 const e7 = f5 + f7;
+    f32x8 const e8 = f4 + f6;
+
+    f32x8 const d0 = e0;
+    f32x8 const d1 = e1;
+    f32x8 const d2 = e2 * m1;
+    f32x8 const d3 = e3;
+    f32x8 const d4 = e4 * m2;
+    f32x8 const d5 = e5 * m3;
+    f32x8 const d6 = e6 * m4;
+    f32x8 const d7 = e7;
+    f32x8 const d8 = e8 * m5;
+
+    f32x8 const c0 = d0 + d1;
+    f32x8 const c1 = d0 - d1;
+    f32x8 const c2 = d2 - d3;
+    f32x8 const c3 = d3;
+    f32x8 const c4 = d4 + d8;
+    f32x8 const c5 = d5 + d7;
+    f32x8 const c6 = d6 - d8;
+    f32x8 const c7 = d7;
+    f32x8 const c8 = c5 - c6;
+
+    f32x8 const b0 = c0 + c3;
+    f32x8 const b1 = c1 + c2;
+    f32x8 const b2 = c1 - c2;
+    f32x8 const b3 = c0 - c3;
+    f32x8 const b4 = c4 - c8;
+    f32x8 const b5 = c8;
+    f32x8 const b6 = c6 - c7;
+    f32x8 const b7 = c7;
+
+    values[0] = b0 + b7;
+    values[1] = b1 + b6;
+    values[2] = b2 + b5;
+    values[3] = b3 + b4;
+    values[4] = b3 - b4;
+    values[5] = b2 - b5;
+    values[6] = b1 - b6;
+    values[7] = b0 - b7;
+}
+
+ALWAYS_INLINE static void inverse_dct_8x8_vectorized(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    // The columns are transformed first, with every lane handling one column. The result is stored as i16 in between
+    // the two passes, and transposed so that the rows can be transformed the same way.
+    f32x8 values[8];
+    for (u32 i = 0; i < 8; ++i)
+        values[i] = simd_cast<f32x8>(load_unaligned<i16x8>(block_component + i * 8));
+    inverse_dct_8_points(values);
+
+    Array<i16, 64> transposed;
+    for (u32 i = 0; i < 8; ++i) {
+        auto const row = simd_cast<i16x8>(simd_cast<i32x8>(values[i]));
+        for (u32 j = 0; j < 8; ++j)
+            transposed[j * 8 + i] = row[j];
+    }
+
+    for (u32 i = 0; i < 8; ++i)
+        values[i] = simd_cast<f32x8>(load_unaligned<i16x8>(transposed.data() + i * 8));
+    inverse_dct_8_points(values);
+
+    for (u32 i = 0; i < 8; ++i) {
+        auto const column = simd_cast<i16x8>(simd_cast<i32x8>(values[i]));
+        for (u32 j = 0; j < 8; ++j)
+            block_component[j * 8 + i] = column[j];
+    }
+}
+
+template<CPUFeatures>
+static void inverse_dct_8x8_impl(i16* block_component)
+{
+    inverse_dct_8x8_vectorized(block_component);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] void inverse_dct_8x8_impl<CPUFeatures::X86_AVX2>(i16* block_component)
+{
+    inverse_dct_8x8_vectorized(block_component);
+}
+#endif
+
+static auto const inverse_dct_8x8 = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &inverse_dct_8x8_impl<CPUFeatures::X86_AVX2>;
+    }
+
+    return &inverse_dct_8x8_impl<CPUFeatures::None>;
+}();
+
+template<u8 N>
+static void inverse_dct_reduced(i16* block_component)
+{
+    // Computes an N-point 2-D IDCT from the lowest N x N frequencies of the block, which directly gives the block
+    // downscaled by a factor of 8 / N. Every resulting pixel is the full size IDCT evaluated at the center of the
+    // 8 / N x 8 / N pixels it replaces, so the other coefficients don't have to be looked at.
+    // The output is stored as N rows of N pixels at the start of the block.
+    static auto const cosines = [] {
+        Array<float, N * N> cosines;
+        for (u32 x = 0; x < N; ++x) {
+            for (u32 u = 0; u < N; ++u) {
+                float const scale = u == 0 ? AK::sqrt(0.5f) / 2.0f : 0.5f;
+                cosines[x * N + u] = scale * AK::cos(static_cast<float>((2 * x + 1) * u) * AK::Pi<float> / (2 * N));
+            }
+        }
+        return cosines;
+    }();
+
+    Array<float, N * N> columns;
+    for (u32 u = 0; u < N; ++u) {
+        for (u32 y = 0; y < N; ++y) {
+            float sum = 0;
+            for (u32 v = 0; v < N; ++v)
+                sum += cosines[y * N + v] * block_component[v * 8 + u];
+            columns[y * N + u] = sum;
+        }
+    }
+
+    for (u32 y = 0; y < N; ++y) {
+        for (u32 x = 0; x < N; ++x) {
+            float sum = 0;
+            for (u32 u = 0; u < N; ++u)
+                sum += cosines[x * N + u] * columns[y * N + u];
+            block_component[y * N + x] = sum;
+        }
     }
 }
 
 static void inverse_dct(JPEGLoadingContext const& context, i16* block_component)
 {
-    inverse_dct_8x8(block_component);
+    switch (context.block_size) {
+    case 8:
+        inverse_dct_8x8(block_component);
+        break;
+    case 4:
+        inverse_dct_reduced<4>(block_component);
+        break;
+    case 2:
+        inverse_dct_reduced<2>(block_component);
+        break;
+    case 1:
+        // Only the DC coefficient is left, which is eight times the average of the block.
+        block_component[0] /= 8;
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
 
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
@@ -1599,11 +1798,12 @@ static void inverse_dct(JPEGLoadingContext const& context, i16* block_component)
         return static_cast<u8>(color >> 4);
     };
 
-    for (u8 i = 0; i < 64; ++i)
+    u32 const pixel_count = context.pixels_per_block();
+    for (u32 i = 0; i < pixel_count; ++i)
         block_component[i] = clamp_to_8_bits(clamp(block_component[i] + level_shift, 0, max_value));
 }
 
-static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, MacroblockRows rows)
 {
     // The first component has sampling factors of context.sampling_factors, while the others
     // divide the first component's sampling factors. This is enforced by read_start_of_frame().
@@ -1613,12 +1813,13 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     // FIXME: Allow more combinations of sampling factors.
     // See https://calendar.perfplanet.com/2015/why-arent-your-images-using-chroma-subsampling/ for
     // subsampling factors visble on the web. In PDF files, YCCK 2111 and 2112 and CMYK 2111 and 2112 are also present.
+    u8 const block_size = context.block_size;
     for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
         auto& component = context.components[component_i];
         if (component.sampling_factors == context.sampling_factors)
             continue;
 
-        for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
+        for (u32 vcursor = rows.first; vcursor < min(rows.end, context.mblock_meta.vcount); vcursor += context.sampling_factors.vertical) {
             for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
                 u32 const component_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
                 Macroblock& component_block = macroblocks[component_block_index];
@@ -1630,13 +1831,13 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
+                        for (u8 i = block_size - 1; i < block_size; --i) {
+                            for (u8 j = block_size - 1; j < block_size; --j) {
+                                u8 const pixel = i * block_size + j;
                                 // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
+                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + (block_size / context.sampling_factors.vertical) * vfactor_i;
+                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + (block_size / context.sampling_factors.horizontal) * hfactor_i;
+                                u32 const component_pixel = component_pxrow * block_size + component_pxcol;
                                 block_component_destination[pixel] = block_component_source[component_pixel];
                             }
                         }
@@ -1647,7 +1848,7 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     }
 }
 
-static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
+ALWAYS_INLINE static void ycbcr_to_rgb_vectorized(Span<Macroblock> macroblocks, u32 pixels_per_block)
 {
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
@@ -1656,7 +1857,22 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
         auto* y = macroblock.y;
         auto* cb = macroblock.cb;
         auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
+
+        u32 i = 0;
+        for (; i + 8 <= pixels_per_block; i += 8) {
+            auto const luma = simd_cast<f32x8>(load_unaligned<i16x8>(y + i));
+            auto const blue_difference = simd_cast<f32x8>(load_unaligned<i16x8>(cb + i) - 128);
+            auto const red_difference = simd_cast<f32x8>(load_unaligned<i16x8>(cr + i) - 128);
+            auto const r = simd_cast<i32x8>(luma + 1.402f * red_difference);
+            auto const g = simd_cast<i32x8>(luma - 0.3441f * blue_difference - 0.7141f * red_difference);
+            auto const b = simd_cast<i32x8>(luma + 1.772f * blue_difference);
+            store_unaligned(y + i, simd_cast<i16x8>(AK::SIMD::clamp(r, 0, 255)));
+            store_unaligned(cb + i, simd_cast<i16x8>(AK::SIMD::clamp(g, 0, 255)));
+            store_unaligned(cr + i, simd_cast<i16x8>(AK::SIMD::clamp(b, 0, 255)));
+        }
+
+        // Blocks of downscaled images can be smaller than a vector.
+        for (; i < pixels_per_block; ++i) {
             int r = y[i] + 1.402f * (cr[i] - 128);
             int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
             int b = y[i] + 1.772f * (cb[i] - 128);
@@ -1667,7 +1883,37 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
     }
 }
 
-static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+template<CPUFeatures>
+static void ycbcr_to_rgb_impl(Span<Macroblock> macroblocks, u32 pixels_per_block)
+{
+    ycbcr_to_rgb_vectorized(macroblocks, pixels_per_block);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] void ycbcr_to_rgb_impl<CPUFeatures::X86_AVX2>(Span<Macroblock> macroblocks, u32 pixels_per_block)
+{
+    ycbcr_to_rgb_vectorized(macroblocks, pixels_per_block);
+}
+#endif
+
+static void ycbcr_to_rgb(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
+{
+    static auto const dispatched = [] {
+        CPUFeatures features = detect_cpu_features();
+
+        if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+            if (has_flag(features, CPUFeatures::X86_AVX2))
+                return &ycbcr_to_rgb_impl<CPUFeatures::X86_AVX2>;
+        }
+
+        return &ycbcr_to_rgb_impl<CPUFeatures::None>;
+    }();
+
+    dispatched(macroblocks, context.pixels_per_block());
+}
+
+static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     if (!context.color_transform.has_value())
         return;
@@ -1679,7 +1925,7 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     // This is arguably a bug in Photoshop, but if you need to work with Photoshop
     // CMYK files, you will have to deal with it in your application.
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
+        for (u32 i = 0; i < context.pixels_per_block(); ++i) {
             macroblock.r[i] = 255 - macroblock.r[i];
             macroblock.g[i] = 255 - macroblock.g[i];
             macroblock.b[i] = 255 - macroblock.b[i];
@@ -1688,17 +1934,17 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     }
 }
 
-static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
+static void ycck_to_cmyk(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     // 7 - Conversions between colour encodings
     // YCCK is obtained from CMYK by converting the CMY channels to YCC channel.
 
     // To convert back into RGB, we only need the 3 first components, which are baseline YCbCr
-    ycbcr_to_rgb(macroblocks);
+    ycbcr_to_rgb(context, macroblocks);
 
     // RGB to CMY, as mentioned in https://www.smcm.iqfr.csic.es/docs/intel/ipp/ipp_manual/IPPI/ippi_ch15/functn_YCCKToCMYK_JPEG.htm#functn_YCCKToCMYK_JPEG
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
+        for (u32 i = 0; i < context.pixels_per_block(); ++i) {
             macroblock.r[i] = 255 - macroblock.r[i];
             macroblock.g[i] = 255 - macroblock.g[i];
             macroblock.b[i] = 255 - macroblock.b[i];
@@ -1706,16 +1952,16 @@ static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
     }
 }
 
-static void grayscale_to_rgb(Vector<Macroblock>& macroblocks)
+static void grayscale_to_rgb(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     for (auto& macroblock : macroblocks) {
         // r is already filled with luma components.
-        ReadonlySpan<i16>(macroblock.r).copy_to(macroblock.g);
-        ReadonlySpan<i16>(macroblock.r).copy_to(macroblock.b);
+        ReadonlySpan<i16>(macroblock.r).trim(context.pixels_per_block()).copy_to(macroblock.g);
+        ReadonlySpan<i16>(macroblock.r).trim(context.pixels_per_block()).copy_to(macroblock.b);
     }
 }
 
-static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     // Note: This is non-standard but some encoder still add the App14 segment for grayscale images.
     //       So let's ignore the color transform value if we only have one component.
@@ -1734,10 +1980,10 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
             }
             break;
         case ColorTransform::YCbCr:
-            ycbcr_to_rgb(macroblocks);
+            ycbcr_to_rgb(context, macroblocks);
             break;
         case ColorTransform::YCCK:
-            ycck_to_cmyk(macroblocks);
+            ycck_to_cmyk(context, macroblocks);
             break;
         }
 
@@ -1749,54 +1995,50 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
     //      - 3 components means YCbCr
     //      - 4 components means CMYK (Nothing to do here).
     if (context.components.size() == 3)
-        ycbcr_to_rgb(macroblocks);
+        ycbcr_to_rgb(context, macroblocks);
 
     if (context.components.size() == 1)
-        grayscale_to_rgb(macroblocks);
+        grayscale_to_rgb(context, macroblocks);
 
     return {};
 }
 
-static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
+static void compose_bitmap(JPEGLoadingContext const& context, Vector<Macroblock> const& macroblocks, MacroblockRows rows)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
-
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    auto const size = context.decoded_size();
+    u32 const block_size = context.block_size;
+    for (u32 y = rows.first * block_size; y < min(rows.end * block_size, static_cast<u32>(size.height())); y++) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
+            u32 const pixel_column = x % block_size;
+            u32 const pixel_index = pixel_row * block_size + pixel_column;
             Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
             context.bitmap->set_pixel(x, y, color);
         }
     }
-
-    return {};
 }
 
-static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void compose_cmyk_bitmap(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, MacroblockRows rows)
 {
     if (context.options.cmyk == JPEGDecoderOptions::CMYK::Normal)
-        invert_colors_for_adobe_images(context, macroblocks);
-
-    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
-
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+        invert_colors_for_adobe_images(context, macroblocks_in(context, macroblocks, rows));
+
+    auto const size = context.decoded_size();
+    u32 const block_size = context.block_size;
+    for (u32 y = rows.first * block_size; y < min(rows.end * block_size, static_cast<u32>(size.height())); y++) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
+            u32 const pixel_column = x % block_size;
+            u32 const pixel_index = pixel_row * block_size + pixel_column;
             context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
         }
     }
-
-    return {};
 }
 
 static bool is_app_marker(Marker const marker)
@@ -1945,17 +2187,28 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
 static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
 {
     auto macroblocks = TRY(construct_macroblocks(context));
-    for_each_macroblock_component(context, macroblocks, [&](Component const& component, i16* block_component) {
-        dequantize(context, component, block_component);
-        inverse_dct(context, block_component);
-    });
-    undo_subsampling(context, macroblocks);
-    TRY(handle_color_transform(context, macroblocks));
+
     if (context.components.size() == 4)
-        TRY(compose_cmyk_bitmap(context, macroblocks));
+        context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size(context.decoded_size()));
     else
-        TRY(compose_bitmap(context, macroblocks));
-    return {};
+        context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, context.decoded_size()));
+
+    u32 const rows_per_mcu = context.sampling_factors.vertical;
+    u32 const mcu_row_count = ceil_div<u32>(context.mblock_meta.vcount, rows_per_mcu);
+    return Threading::for_each_in_parallel(mcu_row_count, [&](size_t mcu_row) -> ErrorOr<void> {
+        MacroblockRows const rows { static_cast<u32>(mcu_row) * rows_per_mcu, static_cast<u32>(mcu_row + 1) * rows_per_mcu };
+        for_each_macroblock_component(context, macroblocks, rows, [&](Component const& component, i16* block_component) {
+            dequantize(context, component, block_component);
+            inverse_dct(context, block_component);
+        });
+        undo_subsampling(context, macroblocks, rows);
+        TRY(handle_color_transform(context, macroblocks_in(context, macroblocks, rows)));
+        if (context.components.size() == 4)
+            compose_cmyk_bitmap(context, macroblocks, rows);
+        else
+            compose_bitmap(context, macroblocks, rows);
+        return {};
+    });
 }
 
 JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
@@ -1985,29 +2238,65 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options)
 {
-    auto stream = TRY(try_make<FixedMemoryStream>(data));
-    auto context = TRY(JPEGLoadingContext::create(move(stream), options));
+    auto context = TRY(JPEGLoadingContext::create(data, options));
     auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+static u8 block_size_for_ideal_size(JPEGLoadingContext const& context, Optional<IntSize> ideal_size)
 {
-    if (index > 0)
-        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+    if (!ideal_size.has_value())
+        return 8;
 
+    // Pick the smallest scale (1/8, 1/4, 1/2 or 1) that is still at least as large as what was asked for.
+    // The caller takes care of the remaining scaling.
+    for (u8 block_size = 1; block_size < 8; block_size *= 2) {
+        if (ceil_div<u32>(context.frame.width * block_size, 8) >= static_cast<u32>(ideal_size->width())
+            && ceil_div<u32>(context.frame.height * block_size, 8) >= static_cast<u32>(ideal_size->height()))
+            return block_size;
+    }
+    return 8;
+}
+
+ErrorOr<void> JPEGImageDecoderPlugin::decode(u8 block_size)
+{
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
+        m_context->block_size = block_size;
         if (auto result = decode_jpeg(*m_context); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
         }
         m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+        return {};
     }
 
+    if (m_context->block_size >= block_size)
+        return {};
+
+    // The image was previously decoded at a smaller scale and the stream has been consumed. Decode it again from
+    // scratch, but only keep the result so that metadata and ICC data handed out earlier stay valid.
+    auto context = TRY(JPEGLoadingContext::create(m_context->data, m_context->options));
+    TRY(decode_header(*context));
+    context->block_size = block_size;
+    TRY(decode_jpeg(*context));
+
+    m_context->block_size = block_size;
+    m_context->bitmap = move(context->bitmap);
+    m_context->cmyk_bitmap = move(context->cmyk_bitmap);
+    return {};
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
+{
+    if (index > 0)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+
+    TRY(decode(block_size_for_ideal_size(*m_context, ideal_size)));
+
     if (m_context->cmyk_bitmap && !m_context->bitmap)
         return ImageFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), 0 };
 
@@ -2044,13 +2333,7 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
     VERIFY(natural_frame_format() == NaturalFrameFormat::CMYK);
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    TRY(decode(8));
 
     return *m_context->cmyk_bitmap;
 }
@@ -48,6 +48,9 @@ public:
 private:
     JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
 
+    // Decodes the image at block_size / 8 of its size, unless it was already decoded at least that large.
+    ErrorOr<void> decode(u8 block_size);
+
     NonnullOwnPtr<JPEGLoadingContext> m_context;
 };
 
@@ -7,13 +7,16 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/FixedArray.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/ImageFormats/PNGLoader.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
 #include <LibGfx/Painter.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Gfx {
 
@@ -82,11 +85,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -185,8 +183,6 @@ struct PNGLoadingContext {
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
     ByteBuffer compressed_data;
     Vector<PaletteEntry> palette_data;
@@ -228,6 +224,7 @@ struct PNGLoadingContext {
         subimage_context.palette_transparency_data = palette_transparency_data;
         subimage_context.bit_depth = bit_depth;
         subimage_context.filter_method = filter_method;
+        subimage_context.interlace_method = interlace_method;
         return subimage_context;
     }
 };
@@ -293,10 +290,8 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
-void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
+static void unfilter_scanline_scalar(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
-    // https://www.w3.org/TR/png-3/#9Filter-types
-    // "Filters are applied to bytes, not to pixels, regardless of the bit depth or colour type of the image."
     switch (filter) {
     case PNG::FilterType::None:
         break;
@@ -336,133 +331,180 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
     }
 }
 
-template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+static void unfilter_scanline_up(Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    using AK::SIMD::u8x16;
+
+    size_t i = 0;
+    for (; i + sizeof(u8x16) <= scanline_data.size(); i += sizeof(u8x16)) {
+        auto above = AK::SIMD::load_unaligned<u8x16>(&previous_scanlines_data[i]);
+        auto value = AK::SIMD::load_unaligned<u8x16>(&scanline_data[i]);
+        AK::SIMD::store_unaligned(&scanline_data[i], value + above);
     }
+    for (; i < scanline_data.size(); ++i)
+        scanline_data[i] += previous_scanlines_data[i];
 }
 
-template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+template<typename VectorType, size_t bytes_per_pixel>
+ALWAYS_INLINE static VectorType load_pixel(u8 const* data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
-    }
+    VectorType pixel {};
+    __builtin_memcpy(&pixel, data, bytes_per_pixel);
+    return pixel;
 }
 
-template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+template<typename VectorType, size_t bytes_per_pixel>
+ALWAYS_INLINE static void store_pixel(u8* data, VectorType pixel)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
-    }
+    __builtin_memcpy(data, &pixel, bytes_per_pixel);
 }
 
-template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+// The Sub, Average and Paeth filters only make a byte depend on the same byte of the pixels to the left, so the
+// bytes of one pixel can all be unfiltered at once. The scanline has to hold a whole number of pixels.
+template<typename VectorType, size_t bytes_per_pixel>
+static void unfilter_scanline_vectorized(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
+    static_assert(bytes_per_pixel <= sizeof(VectorType));
+
+    auto* data = scanline_data.data();
+    auto const* above_data = previous_scanlines_data.data();
+
+    VectorType left {};
+    VectorType upper_left {};
+    for (size_t i = 0; i < scanline_data.size(); i += bytes_per_pixel) {
+        auto value = load_pixel<VectorType, bytes_per_pixel>(data + i);
+        auto above = load_pixel<VectorType, bytes_per_pixel>(above_data + i);
+
+        switch (filter) {
+        case PNG::FilterType::Sub:
+            left = value + left;
+            break;
+        case PNG::FilterType::Average:
+            // This is (left + above) / 2 without overflowing the 8 bit lanes.
+            left = value + ((left & above) + ((left ^ above) >> 1));
+            break;
+        case PNG::FilterType::Paeth:
+            left = value + PNG::paeth_predictor(left, above, upper_left);
+            upper_left = above;
+            break;
+        default:
+            VERIFY_NOT_REACHED();
         }
+
+        store_pixel<VectorType, bytes_per_pixel>(data + i, left);
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
+    // https://www.w3.org/TR/png-3/#9Filter-types
+    // "Filters are applied to bytes, not to pixels, regardless of the bit depth or colour type of the image."
+    switch (filter) {
+    case PNG::FilterType::None:
+        return;
+    case PNG::FilterType::Up:
+        return unfilter_scanline_up(scanline_data, previous_scanlines_data);
+    default:
+        break;
     }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
 
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+    if (scanline_data.size() % bytes_per_complete_pixel == 0) {
+        switch (bytes_per_complete_pixel) {
+        case 3:
+            return unfilter_scanline_vectorized<AK::SIMD::u8x4, 3>(filter, scanline_data, previous_scanlines_data);
+        case 4:
+            return unfilter_scanline_vectorized<AK::SIMD::u8x4, 4>(filter, scanline_data, previous_scanlines_data);
+        case 6:
+            return unfilter_scanline_vectorized<AK::SIMD::u8x8, 6>(filter, scanline_data, previous_scanlines_data);
+        case 8:
+            return unfilter_scanline_vectorized<AK::SIMD::u8x8, 8>(filter, scanline_data, previous_scanlines_data);
+        default:
+            break;
+        }
+    }
 
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
+    unfilter_scanline_scalar(filter, scanline_data, previous_scanlines_data, bytes_per_complete_pixel);
+}
 
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
+template<typename T>
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* gray_values = reinterpret_cast<T const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
+    }
+}
 
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
+template<typename T>
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
+    }
+}
 
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
+template<typename T>
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
+    }
+}
 
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
+template<typename T>
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline, Pixel* pixels, int width, Triplet<T> transparency_value)
+{
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
+}
+
+// Converts one unfiltered scanline of `width` pixels to BGRA.
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* row, int width)
+{
+    auto* pixels = reinterpret_cast<Pixel*>(row);
 
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline, pixels, width);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline.data();
+            for (int x = 0; x < width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +512,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline, pixels, width);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,39 +522,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline, pixels, width, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline, pixels, width, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline, pixels, width);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline, pixels, width);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels, scanline.data(), scanline.size());
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -520,42 +558,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -567,12 +601,41 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
+    for (int i = 0; i < width; ++i) {
+        auto& x = pixels[i];
+        swap(x.r, x.b);
+    }
+
+    return {};
+}
+
+// Reads the scanlines of an image (or of one Adam7 pass) from the decompressed image data one at a time, unfilters
+// them and hands them to the callback. Only the current and the previous scanline are kept in memory.
+template<typename Callback>
+static ErrorOr<void> for_each_unfiltered_scanline(PNGLoadingContext const& context, Stream& stream, int height, size_t row_size, Callback callback)
+{
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+
+    // Both buffers hold a filter byte followed by a scanline. The scanline before the first one is all zeroes.
+    auto current = TRY(ByteBuffer::create_uninitialized(row_size + 1));
+    auto previous = TRY(ByteBuffer::create_zeroed(row_size + 1));
+
+    for (int y = 0; y < height; ++y) {
+        if (stream.read_until_filled(current).is_error())
+            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+        auto filter = TRY(PNG::filter_type(current[0]));
+        auto scanline = current.bytes().slice(1);
+        PNGImageDecoderPlugin::unfilter_scanline(filter, scanline, previous.bytes().slice(1), bytes_per_complete_pixel);
+        TRY(callback(y, scanline));
+
+        swap(current, previous);
     }
 
     return {};
@@ -700,36 +763,19 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Stream& stream)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-
-    for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
+    auto row_size = context.compute_row_size_for_width(context.width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
 
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+
+    // The scanlines are unpacked as soon as they come out of the decompressor, so the decompressed image data is
+    // never held in memory as a whole.
+    return for_each_unfiltered_scanline(context, stream, context.height, row_size.value(), [&](int y, ReadonlyBytes scanline) {
+        return unpack_scanline(context, scanline, context.bitmap->scanline(y), context.width);
+    });
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -782,57 +828,97 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
-{
-    auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
+struct Adam7Pass {
+    int width { 0 };
+    int height { 0 };
+    size_t row_size { 0 };
+    ReadonlyBytes data;
+};
 
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext const& context, Adam7Pass const& pass, int pass_index)
+{
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!pass.width || !pass.height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    auto& bitmap = *context.bitmap;
+    auto pixels = TRY(FixedArray<ARGB32>::create(pass.width));
+    FixedMemoryStream stream { pass.data };
 
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+    return for_each_unfiltered_scanline(context, stream, pass.height, pass.row_size, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, pixels.data(), pass.width));
 
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
+        // Copy the pass' pixels into the main image according to the pass pattern
+        int dy = adam7_starty[pass_index] + y * adam7_stepy[pass_index];
+        if (dy >= context.height)
+            return {};
+        auto* row = bitmap.scanline(dy);
+        for (int x = 0, dx = adam7_startx[pass_index]; x < pass.width && dx < context.width; ++x, dx += adam7_stepx[pass_index])
+            row[dx] = pixels[x];
+        return {};
+    });
+}
 
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Stream& stream)
+{
+    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
+
+    // The passes are stored one after another, and each of them covers a different set of pixels of the image.
+    // Once we know where each pass starts in the decompressed image data, they can be decoded independently.
+    Array<Adam7Pass, 8> passes {};
+    Checked<size_t> total_size = 0;
+    for (int pass_index = 1; pass_index <= 7; ++pass_index) {
+        auto& pass = passes[pass_index];
+        pass.width = adam7_width(context, pass_index);
+        pass.height = adam7_height(context, pass_index);
+        if (!pass.width || !pass.height)
+            continue;
+
+        auto row_size = context.compute_row_size_for_width(pass.width);
         if (row_size.has_overflow())
             return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+        pass.row_size = row_size.value();
+
+        Checked<size_t> pass_size = pass.row_size;
+        pass_size += 1;
+        pass_size *= pass.height;
+        total_size += pass_size;
+        if (total_size.has_overflow())
+            return Error::from_string_literal("PNGImageDecoderPlugin: Image data size overflow");
     }
 
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
+    auto decompressed_data = TRY(ByteBuffer::create_uninitialized(total_size.value()));
+    if (stream.read_until_filled(decompressed_data).is_error())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
 
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
-        }
+    size_t offset = 0;
+    for (auto& pass : passes) {
+        // Passes without pixels have no data at all, not even the filter bytes of their rows.
+        if (!pass.width || !pass.height)
+            continue;
+        size_t pass_size = (pass.row_size + 1) * pass.height;
+        pass.data = decompressed_data.bytes().slice(offset, pass_size);
+        offset += pass_size;
     }
-    return {};
+
+    return Threading::for_each_in_parallel(7, [&](size_t index) {
+        return decode_adam7_pass(context, passes[index + 1], index + 1);
+    });
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_image_data(PNGLoadingContext& context, ReadonlyBytes compressed_data)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
-    return {};
+    auto compressed_data_stream = make<FixedMemoryStream>(compressed_data);
+    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
+
+    switch (context.interlace_method) {
+    case PngInterlaceMethod::Null:
+        return decode_png_bitmap_simple(context, *decompressor);
+    case PngInterlaceMethod::Adam7:
+        return decode_png_adam7(context, *decompressor);
+    default:
+        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+    }
 }
 
 static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
@@ -848,34 +934,12 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
-    auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
-    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
-    if (decompressor_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return decompressor_or_error.release_error();
-    }
-    auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
+    if (auto result = decode_png_image_data(context, context.compressed_data); result.is_error()) {
         context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
+        return result.release_error();
     }
-    auto decompression_buffer = result_or_error.release_value();
     context.compressed_data.clear();
 
-    context.scanlines.ensure_capacity(context.height);
-    switch (context.interlace_method) {
-    case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
-        break;
-    case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
-        break;
-    default:
-        context.state = PNGLoadingContext::State::Error;
-        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
-    }
-
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
 }
@@ -890,22 +954,7 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
     auto frame_rect = animation_frame.rect();
     auto frame_context = context.create_subimage_context(frame_rect.width(), frame_rect.height());
 
-    auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
-    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
-
-    frame_context.scanlines.ensure_capacity(frame_context.height);
-    switch (context.interlace_method) {
-    case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
-        break;
-    case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
-        break;
-    default:
-        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
-    }
+    TRY(decode_png_image_data(frame_context, animation_frame.compressed_data));
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return move(frame_context.bitmap);
@@ -21,6 +21,8 @@
 #include <AK/Memory.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Stack.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
@@ -862,6 +864,43 @@ static void do_blit_with_opacity(BlitState& state)
     }
 }
 
+// Blends BGRA source pixels onto BGRx destination pixels, for a single pixel or a whole vector of them at once.
+// This is equivalent to Color::blend() with an opaque destination: every channel becomes
+// (source * alpha + destination * (255 - alpha)) / 255, which is computed without a division.
+template<typename T>
+ALWAYS_INLINE static T blend_opaque_destination(T source, T destination)
+{
+    T alpha = source >> 24;
+    T inverse_alpha = 255 - alpha;
+
+    // Red and blue are far enough apart in a pixel that they can be multiplied together.
+    T red_and_blue = (source & 0x00ff00ff) * alpha + (destination & 0x00ff00ff) * inverse_alpha;
+    T green = ((source >> 8) & 0xff) * alpha + ((destination >> 8) & 0xff) * inverse_alpha;
+
+    // x / 255 == (x + 1 + (x >> 8)) >> 8 for all x <= 255 * 255.
+    red_and_blue = ((red_and_blue + 0x00010001 + ((red_and_blue >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    green = (green + 1 + (green >> 8)) >> 8;
+    return 0xff000000 | red_and_blue | (green << 8);
+}
+
+static void do_blit_with_alpha_onto_opaque(BlitState& state)
+{
+    using AK::SIMD::u32x4;
+
+    for (int row = 0; row < state.row_count; ++row) {
+        int x = 0;
+        for (; x + 4 <= state.column_count; x += 4) {
+            auto source = AK::SIMD::load_unaligned<u32x4>(state.src + x);
+            auto destination = AK::SIMD::load_unaligned<u32x4>(state.dst + x);
+            AK::SIMD::store_unaligned(state.dst + x, blend_opaque_destination(source, destination));
+        }
+        for (; x < state.column_count; ++x)
+            state.dst[x] = blend_opaque_destination<u32>(state.src[x], state.dst[x]);
+        state.dst += state.dst_pitch;
+        state.src += state.src_pitch;
+    }
+}
+
 void Painter::blit_with_opacity(IntPoint position, Gfx::Bitmap const& source, IntRect const& a_src_rect, float opacity, bool apply_alpha)
 {
     VERIFY(scale() >= source.scale() && "painter doesn't support downsampling scale factors");
@@ -900,7 +939,10 @@ void Painter::blit_with_opacity(IntPoint position, Gfx::Bitmap const& source, In
     };
 
     if (source.has_alpha_channel() && apply_alpha) {
-        if (target().has_alpha_channel())
+        // This is how windows with an alpha channel are composited, so it gets a vectorized path.
+        if (opacity >= 1.0f && source.format() == BitmapFormat::BGRA8888 && !target().has_alpha_channel())
+            do_blit_with_alpha_onto_opaque(blit_state);
+        else if (target().has_alpha_channel())
             do_blit_with_opacity<BlitState::BothAlpha>(blit_state);
         else
             do_blit_with_opacity<BlitState::SrcAlpha>(blit_state);
@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/Function.h>
+#include <AK/SIMDMath.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
@@ -153,6 +154,18 @@ public:
     // Fast conversion of 8-bit YUV to full-range RGB.
     template<MatrixCoefficients MC, VideoFullRangeFlag FR, UnsignedIntegral T>
     static ALWAYS_INLINE Gfx::Color convert_simple_yuv_to_rgb(T y_in, T u_in, T v_in)
+    {
+        i32 red;
+        i32 green;
+        i32 blue;
+        convert_simple_yuv_to_rgb_components<MC, FR>(static_cast<i32>(y_in), static_cast<i32>(u_in), static_cast<i32>(v_in), red, green, blue);
+        return Gfx::Color(u8(red), u8(green), u8(blue));
+    }
+
+    // The arithmetic of convert_simple_yuv_to_rgb(), applied either to a single sample or to a vector of samples
+    // (i.e. AK::SIMD::i32x8). The resulting components are in the range 0...255.
+    template<MatrixCoefficients MC, VideoFullRangeFlag FR, typename V>
+    static ALWAYS_INLINE void convert_simple_yuv_to_rgb_components(V y_in, V u_in, V v_in, V& red, V& green, V& blue)
     {
         static constexpr i32 bit_depth = 8;
         static constexpr i32 maximum_value = (1 << bit_depth) - 1;
@@ -197,13 +210,9 @@ public:
             return range_factors;
         }();
 
-        i32 y = y_in + range_factors.y_offset;
-        i32 u = u_in + range_factors.uv_offset;
-        i32 v = v_in + range_factors.uv_offset;
-
-        i32 red;
-        i32 green;
-        i32 blue;
+        V y = y_in + range_factors.y_offset;
+        V u = u_in + range_factors.uv_offset;
+        V v = v_in + range_factors.uv_offset;
 
         constexpr i32 y_scale = range_factors.y_scale;
         constexpr i32 uv_scale = range_factors.uv_scale;
@@ -231,16 +240,20 @@ public:
             blue = y * y_scale + u * multiply(coef(94070), uv_scale);
         }
 
-        red = clamp(red, 0, maximum_value * one);
-        green = clamp(green, 0, maximum_value * one);
-        blue = clamp(blue, 0, maximum_value * one);
+        if constexpr (IsSame<V, i32>) {
+            red = clamp(red, 0, maximum_value * one);
+            green = clamp(green, 0, maximum_value * one);
+            blue = clamp(blue, 0, maximum_value * one);
+        } else {
+            red = AK::SIMD::clamp(red, 0, maximum_value * one);
+            green = AK::SIMD::clamp(green, 0, maximum_value * one);
+            blue = AK::SIMD::clamp(blue, 0, maximum_value * one);
+        }
 
         // This compiles down to a bit shift if maximum_value == 255
         red /= fraction(maximum_value, 255);
         green /= fraction(maximum_value, 255);
         blue /= fraction(maximum_value, 255);
-
-        return Gfx::Color(u8(red), u8(green), u8(blue));
     }
 
 private:
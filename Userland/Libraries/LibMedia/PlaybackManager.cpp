@@ -131,7 +131,7 @@ void PlaybackManager::dispatch_decoder_error(DecoderError error)
     }
 }
 
-void PlaybackManager::dispatch_new_frame(RefPtr<Gfx::Bitmap> frame)
+void PlaybackManager::dispatch_new_frame(RefPtr<VideoFrame> frame)
 {
     if (on_video_frame)
         on_video_frame(move(frame));
@@ -145,7 +145,7 @@ bool PlaybackManager::dispatch_frame_queue_item(FrameQueueItem&& item)
     }
 
     dbgln_if(PLAYBACK_MANAGER_DEBUG, "Sent frame for presentation with timestamp {}ms, late by {}ms", item.timestamp().to_milliseconds(), (current_playback_time() - item.timestamp()).to_milliseconds());
-    dispatch_new_frame(item.bitmap());
+    dispatch_new_frame(item.frame());
     return false;
 }
 
@@ -204,7 +204,7 @@ void PlaybackManager::decode_and_queue_one_sample()
     FrameQueueItem item_to_enqueue;
 
     while (item_to_enqueue.is_empty()) {
-        OwnPtr<VideoFrame> decoded_frame = nullptr;
+        RefPtr<VideoFrame> decoded_frame = nullptr;
         CodingIndependentCodePoints container_cicp;
 
         {
@@ -243,7 +243,8 @@ void PlaybackManager::decode_and_queue_one_sample()
             }
         }
 
-        // Convert the frame for display.
+        // Prepare the frame for display. Converting it to RGB is left to whoever paints it, so that frames that end up
+        // being skipped are never converted.
         if (decoded_frame != nullptr) {
             auto& cicp = decoded_frame->cicp();
             cicp.adopt_specified_values(container_cicp);
@@ -266,12 +267,8 @@ void PlaybackManager::decode_and_queue_one_sample()
                 break;
             }
 
-            auto bitmap_result = decoded_frame->to_bitmap();
-
-            if (bitmap_result.is_error())
-                item_to_enqueue = FrameQueueItem::error_marker(bitmap_result.release_error(), decoded_frame->timestamp());
-            else
-                item_to_enqueue = FrameQueueItem::frame(bitmap_result.release_value(), decoded_frame->timestamp());
+            auto timestamp = decoded_frame->timestamp();
+            item_to_enqueue = FrameQueueItem::frame(move(decoded_frame), timestamp);
             break;
         }
     }
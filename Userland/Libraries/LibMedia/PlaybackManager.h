@@ -12,7 +12,6 @@
 #include <AK/Queue.h>
 #include <AK/Time.h>
 #include <LibCore/SharedCircularQueue.h>
-#include <LibGfx/Bitmap.h>
 #include <LibMedia/Containers/Matroska/Document.h>
 #include <LibMedia/Demuxer.h>
 #include <LibThreading/ConditionVariable.h>
@@ -20,6 +19,7 @@
 #include <LibThreading/Thread.h>
 
 #include "VideoDecoder.h"
+#include "VideoFrame.h"
 
 namespace Media {
 
@@ -38,9 +38,9 @@ public:
         Error,
     };
 
-    static FrameQueueItem frame(RefPtr<Gfx::Bitmap> bitmap, Duration timestamp)
+    static FrameQueueItem frame(RefPtr<VideoFrame> frame, Duration timestamp)
     {
-        return FrameQueueItem(move(bitmap), timestamp);
+        return FrameQueueItem(move(frame), timestamp);
     }
 
     static FrameQueueItem error_marker(DecoderError&& error, Duration timestamp)
@@ -48,8 +48,8 @@ public:
         return FrameQueueItem(move(error), timestamp);
     }
 
-    bool is_frame() const { return m_data.has<RefPtr<Gfx::Bitmap>>(); }
-    RefPtr<Gfx::Bitmap> bitmap() const { return m_data.get<RefPtr<Gfx::Bitmap>>(); }
+    bool is_frame() const { return m_data.has<RefPtr<VideoFrame>>(); }
+    RefPtr<VideoFrame> frame() const { return m_data.get<RefPtr<VideoFrame>>(); }
     Duration timestamp() const { return m_timestamp; }
 
     bool is_error() const { return m_data.has<DecoderError>(); }
@@ -71,8 +71,8 @@ public:
     }
 
 private:
-    FrameQueueItem(RefPtr<Gfx::Bitmap> bitmap, Duration timestamp)
-        : m_data(move(bitmap))
+    FrameQueueItem(RefPtr<VideoFrame> frame, Duration timestamp)
+        : m_data(move(frame))
         , m_timestamp(timestamp)
     {
         VERIFY(m_timestamp != no_timestamp);
@@ -84,7 +84,7 @@ private:
     {
     }
 
-    Variant<Empty, RefPtr<Gfx::Bitmap>, DecoderError> m_data { Empty() };
+    Variant<Empty, RefPtr<VideoFrame>, DecoderError> m_data { Empty() };
     Duration m_timestamp { no_timestamp };
 };
 
@@ -138,7 +138,8 @@ public:
     Duration current_playback_time();
     Duration duration();
 
-    Function<void(RefPtr<Gfx::Bitmap>)> on_video_frame;
+    // Frames are passed on in their decoded format, so that they are only converted for display if they are painted.
+    Function<void(RefPtr<VideoFrame>)> on_video_frame;
     Function<void()> on_playback_state_change;
     Function<void(DecoderError)> on_decoder_error;
     Function<void(Error)> on_fatal_playback_error;
@@ -167,7 +168,7 @@ private:
     void decode_and_queue_one_sample();
 
     void dispatch_decoder_error(DecoderError error);
-    void dispatch_new_frame(RefPtr<Gfx::Bitmap> frame);
+    void dispatch_new_frame(RefPtr<VideoFrame> frame);
     // Returns whether we changed playback states. If so, any PlaybackStateHandler processing must cease.
     [[nodiscard]] bool dispatch_frame_queue_item(FrameQueueItem&&);
     void dispatch_state_change();
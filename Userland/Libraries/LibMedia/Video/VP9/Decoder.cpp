@@ -5,10 +5,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
+#include <AK/CPUFeatures.h>
 #include <AK/IntegralMath.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/TypedTransfer.h>
+#include <LibCore/System.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
+#include <LibThreading/WorkerThread.h>
 
 #include "Context.h"
 #include "Decoder.h"
@@ -18,13 +25,77 @@
 #    pragma GCC optimize("O3")
 #endif
 
+// Beware, threading is unstable in Serenity with smp=on, and performs worse than with it off.
+#define VP9_THREADING
+
 namespace Media::Video::VP9 {
 
+using AK::SIMD::i32x4;
+using AK::SIMD::i32x8;
+using AK::SIMD::i64x4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::simd_cast;
+using AK::SIMD::store_unaligned;
+using AK::SIMD::u16x4;
+using AK::SIMD::u16x8;
+
+// Passes over whole frames are split into bands of this many rows to spread them over the worker threads.
+static constexpr size_t rows_per_band = 64;
+
 Decoder::Decoder()
     : m_parser(make<Parser>(*this))
 {
 }
 
+Decoder::~Decoder() = default;
+
+DecoderErrorOr<void> Decoder::for_each_in_parallel(size_t count, Function<DecoderErrorOr<void>(size_t)> const& task)
+{
+#ifdef VP9_THREADING
+    // The calling thread takes part in the work, and there is no point in having more threads than cores.
+    auto thread_count = min(count, max<size_t>(Core::System::hardware_concurrency(), 1));
+    auto worker_count = thread_count > 0 ? thread_count - 1 : 0;
+
+    while (m_worker_threads.size() < worker_count)
+        m_worker_threads.append(DECODER_TRY_ALLOC(Threading::WorkerThread<DecoderError>::create("Decoder Worker"sv)));
+
+    // Every thread keeps taking the next index until all of them are handed out, so that tasks of uneven size
+    // even out. Once a task fails, the remaining ones are skipped.
+    Atomic<size_t> next_index { 0 };
+    auto run_tasks = [&]() -> DecoderErrorOr<void> {
+        while (true) {
+            auto index = next_index.fetch_add(1);
+            if (index >= count)
+                return {};
+            if (auto result = task(index); result.is_error()) {
+                next_index.store(count);
+                return result;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < worker_count; i++) {
+        m_worker_threads[i]->start_task([&run_tasks]() -> DecoderErrorOr<void> {
+            return run_tasks();
+        });
+    }
+
+    auto result = run_tasks();
+
+    for (size_t i = 0; i < worker_count; i++) {
+        auto task_result = m_worker_threads[i]->wait_until_task_is_finished();
+        if (!result.is_error() && task_result.is_error())
+            result = move(task_result);
+    }
+
+    return result;
+#else
+    for (size_t i = 0; i < count; i++)
+        TRY(task(i));
+    return {};
+#endif
+}
+
 DecoderErrorOr<void> Decoder::receive_sample(Duration timestamp, ReadonlyBytes chunk_data)
 {
     auto superframe_sizes = m_parser->parse_superframe_sizes(chunk_data);
@@ -172,10 +243,15 @@ DecoderErrorOr<void> Decoder::create_video_frame(Duration timestamp, FrameContex
         auto output_size = plane == 0 ? output_y_size : output_uv_size;
         auto const* decoded_buffer = get_output_buffer(plane).data();
 
-        for (u32 row = 0; row < output_size.height(); row++) {
-            for (u32 column = 0; column < output_size.width(); column++)
-                buffer[row * output_size.width() + column] = static_cast<T>(decoded_buffer[row * decoded_width + column]);
-        }
+        auto band_count = ceil_div(output_size.height(), rows_per_band);
+        TRY(for_each_in_parallel(band_count, [&](size_t band) -> DecoderErrorOr<void> {
+            auto rows_end = min((band + 1) * rows_per_band, output_size.height());
+            for (auto row = band * rows_per_band; row < rows_end; row++) {
+                for (u32 column = 0; column < output_size.width(); column++)
+                    buffer[row * output_size.width() + column] = static_cast<T>(decoded_buffer[row * decoded_width + column]);
+            }
+            return {};
+        }));
     }
 
     m_video_frame_queue.enqueue(move(frame));
@@ -200,7 +276,7 @@ Vector<u16>& Decoder::get_output_buffer(u8 plane)
     return m_output_buffers[plane];
 }
 
-DecoderErrorOr<NonnullOwnPtr<VideoFrame>> Decoder::get_decoded_frame()
+DecoderErrorOr<NonnullRefPtr<VideoFrame>> Decoder::get_decoded_frame()
 {
     if (m_video_frame_queue.is_empty())
         return DecoderError::format(DecoderErrorCategory::NeedsMoreInput, "No video frame in queue.");
@@ -837,6 +913,70 @@ DecoderErrorOr<void> Decoder::prepare_referenced_frame(Gfx::Size<u32> frame_size
     return {};
 }
 
+// Filters as many output samples as there are lanes in Accumulator at once. Samples and filter taps both fit in 16 bits
+// for 8-bit video, so this matches the spec's arithmetic exactly.
+template<typename Accumulator>
+ALWAYS_INLINE static void convolve_8bit_samples(u16* destination, u16 const* source, size_t tap_stride, i16 const* filter)
+{
+    using Samples = Conditional<IsSame<Accumulator, i32x8>, u16x8, u16x4>;
+
+    Accumulator accumulated_samples {};
+    for (auto t = 0u; t < 8; t++)
+        accumulated_samples += filter[t] * simd_cast<Accumulator>(load_unaligned<Samples>(source + t * tap_stride));
+    accumulated_samples = (accumulated_samples + (1 << 6)) >> 7;
+    store_unaligned(destination, simd_cast<Samples>(AK::SIMD::clamp(accumulated_samples, 0, 255)));
+}
+
+// Applies an 8-tap subpixel filter to a block of 8-bit samples. The taps for an output sample are read from source
+// samples that are tap_stride apart, so this does horizontal convolutions with a tap stride of 1, and vertical ones
+// with a tap stride equal to the source stride.
+ALWAYS_INLINE static void convolve_8bit_block(u16* destination, u32 width, u32 height, u16 const* source, size_t source_stride, size_t tap_stride, i16 const* filter)
+{
+    for (auto row = 0u; row < height; row++) {
+        auto column = 0u;
+        for (; column + 8 <= width; column += 8)
+            convolve_8bit_samples<i32x8>(destination + column, source + column, tap_stride, filter);
+        if (column + 4 <= width) {
+            convolve_8bit_samples<i32x4>(destination + column, source + column, tap_stride, filter);
+            column += 4;
+        }
+        for (; column < width; column++) {
+            i32 accumulated_samples = 0;
+            for (auto t = 0u; t < 8; t++)
+                accumulated_samples += filter[t] * source[column + t * tap_stride];
+            destination[column] = clip_1(8, rounded_right_shift(accumulated_samples, 7));
+        }
+
+        destination += width;
+        source += source_stride;
+    }
+}
+
+template<CPUFeatures>
+static void convolve_8bit_impl(u16* destination, u32 width, u32 height, u16 const* source, size_t source_stride, size_t tap_stride, i16 const* filter)
+{
+    convolve_8bit_block(destination, width, height, source, source_stride, tap_stride, filter);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] void convolve_8bit_impl<CPUFeatures::X86_AVX2>(u16* destination, u32 width, u32 height, u16 const* source, size_t source_stride, size_t tap_stride, i16 const* filter)
+{
+    convolve_8bit_block(destination, width, height, source, source_stride, tap_stride, filter);
+}
+#endif
+
+static auto const convolve_8bit = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &convolve_8bit_impl<CPUFeatures::X86_AVX2>;
+    }
+
+    return &convolve_8bit_impl<CPUFeatures::None>;
+}();
+
 DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const& block_context, ReferenceIndex reference_index, u32 block_row, u32 block_column, u32 x, u32 y, u32 width, u32 height, u32 block_index, Span<u16> block_buffer)
 {
     VERIFY(width <= maximum_block_dimensions && height <= maximum_block_dimensions);
@@ -965,13 +1105,6 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const&
     auto const bit_depth = block_context.frame_context.color_config.bit_depth;
     auto const* reference_start = reference_frame_buffer.data() + reference_block_y * reference_frame_width + reference_block_x;
 
-    // FIXME: We are using 16-bit products to vectorize the filter loops, but when filtering in a high bit-depth video, they will truncate.
-    //        Instead of hardcoding them, we should have the bit depth as a template parameter, and the accumulators can select a size based
-    //        on whether the bit depth > 8.
-    //        Note that we only get a benefit from this on the default CPU target. If we enable AVX2 here, we may want to specialize the
-    //        function for the CPU target and remove the cast to i16 so that it doesn't have to truncate on AVX2, where it can do the full
-    //        unrolled 32-bit product loops in one vector.
-
     if (unscaled_x && unscaled_y && bit_depth == 8) {
         if (copy_x && copy_y) {
             // We can memcpy here to avoid doing any real work.
@@ -987,63 +1120,25 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const&
             return {};
         }
 
-        auto horizontal_convolution_unscaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_x) {
-            source -= sample_offset;
-            auto const source_end_skip = source_stride - width;
-
-            for (auto row = 0u; row < height; row++) {
-                for (auto column = 0u; column < width; column++) {
-                    i32 accumulated_samples = 0;
-                    for (auto t = 0; t < 8; t++) {
-                        auto sample = source[t];
-                        accumulated_samples += static_cast<i16>(subpel_filters[filter][subpixel_x][t] * sample);
-                    }
-
-                    *destination = clip_1(bit_depth, rounded_right_shift(accumulated_samples, 7));
-                    source++;
-                    destination++;
-                }
-                source += source_end_skip;
-            }
-        };
+        auto const* horizontal_filter = subpel_filters[block_context.interpolation_filter][reference_subpixel_x];
+        auto const* vertical_filter = subpel_filters[block_context.interpolation_filter][reference_subpixel_y];
 
         if (copy_y) {
-            horizontal_convolution_unscaled(bit_depth, block_buffer.data(), width, height, reference_start, reference_frame_width, block_context.interpolation_filter, reference_subpixel_x);
+            convolve_8bit(block_buffer.data(), width, height, reference_start - sample_offset, reference_frame_width, 1, horizontal_filter);
             return {};
         }
 
-        auto vertical_convolution_unscaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_y) {
-            auto const source_end_skip = source_stride - width;
-
-            for (auto row = 0u; row < height; row++) {
-                for (auto column = 0u; column < width; column++) {
-                    auto const* scan_column = source;
-                    i32 accumulated_samples = 0;
-                    for (auto t = 0; t < 8; t++) {
-                        auto sample = *scan_column;
-                        accumulated_samples += static_cast<i16>(subpel_filters[filter][subpixel_y][t] * sample);
-                        scan_column += source_stride;
-                    }
-                    *destination = clip_1(bit_depth, rounded_right_shift(accumulated_samples, 7));
-                    source++;
-                    destination++;
-                }
-                source += source_end_skip;
-            }
-        };
-
         if (copy_x) {
-            vertical_convolution_unscaled(bit_depth, block_buffer.data(), width, height, reference_start - (sample_offset * reference_frame_width), reference_frame_width, block_context.interpolation_filter, reference_subpixel_y);
+            convolve_8bit(block_buffer.data(), width, height, reference_start - (sample_offset * reference_frame_width), reference_frame_width, reference_frame_width, vertical_filter);
             return {};
         }
 
-        horizontal_convolution_unscaled(bit_depth, intermediate_buffer.data(), width, intermediate_height, reference_start - (sample_offset * reference_frame_width), reference_frame_width, block_context.interpolation_filter, reference_subpixel_x);
-        vertical_convolution_unscaled(bit_depth, block_buffer.data(), width, height, intermediate_buffer.data(), width, block_context.interpolation_filter, reference_subpixel_y);
+        convolve_8bit(intermediate_buffer.data(), width, intermediate_height, reference_start - (sample_offset * reference_frame_width) - sample_offset, reference_frame_width, 1, horizontal_filter);
+        convolve_8bit(block_buffer.data(), width, height, intermediate_buffer.data(), width, width, vertical_filter);
         return {};
     }
 
     // NOTE: Accumulators below are 32-bit to allow high bit-depth videos to decode without overflows.
-    //       These should be changed when the accumulators above are.
 
     auto horizontal_convolution_scaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_x, auto scale_x) {
         source -= sample_offset;
@@ -1317,7 +1412,7 @@ inline DecoderErrorOr<void> Decoder::inverse_walsh_hadamard_transform(Span<Inter
     return {};
 }
 
-inline i32 Decoder::cos64(u8 angle)
+static inline i32 cos64(u8 angle)
 {
     i32 const cos64_lookup[33] = { 16384, 16364, 16305, 16207, 16069, 15893, 15679, 15426, 15137, 14811, 14449, 14053, 13623, 13160, 12665, 12140, 11585, 11003, 10394, 9760, 9102, 8423, 7723, 7005, 6270, 5520, 4756, 3981, 3196, 2404, 1606, 804, 0 };
 
@@ -1336,7 +1431,7 @@ inline i32 Decoder::cos64(u8 angle)
     return cos64_lookup[128 - angle];
 }
 
-inline i32 Decoder::sin64(u8 angle)
+static inline i32 sin64(u8 angle)
 {
     if (angle < 32)
         angle += 128;
@@ -1344,18 +1439,34 @@ inline i32 Decoder::sin64(u8 angle)
 }
 
 // (8.7.1.1) The function B( a, b, angle, 0 ) performs a butterfly rotation.
-inline void Decoder::butterfly_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, u8 angle, bool flip)
+// T is either a single Intermediate, or a vector holding the same element of several rows or columns.
+template<typename T>
+ALWAYS_INLINE static void butterfly_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, u8 angle, bool flip)
 {
     auto cos = cos64(angle);
     auto sin = sin64(angle);
-    // 1. The variable x is set equal to T[ a ] * cos64( angle ) - T[ b ] * sin64( angle ).
-    i64 rotated_a = static_cast<i64>(data[index_a]) * cos - static_cast<i64>(data[index_b]) * sin;
-    // 2. The variable y is set equal to T[ a ] * sin64( angle ) + T[ b ] * cos64( angle ).
-    i64 rotated_b = static_cast<i64>(data[index_a]) * sin + static_cast<i64>(data[index_b]) * cos;
-    // 3. T[ a ] is set equal to Round2( x, 14 ).
-    data[index_a] = rounded_right_shift(rotated_a, 14);
-    // 4. T[ b ] is set equal to Round2( y, 14 ).
-    data[index_b] = rounded_right_shift(rotated_b, 14);
+    if constexpr (IsSame<T, i32>) {
+        // 1. The variable x is set equal to T[ a ] * cos64( angle ) - T[ b ] * sin64( angle ).
+        i64 rotated_a = static_cast<i64>(data[index_a]) * cos - static_cast<i64>(data[index_b]) * sin;
+        // 2. The variable y is set equal to T[ a ] * sin64( angle ) + T[ b ] * cos64( angle ).
+        i64 rotated_b = static_cast<i64>(data[index_a]) * sin + static_cast<i64>(data[index_b]) * cos;
+        // 3. T[ a ] is set equal to Round2( x, 14 ).
+        data[index_a] = rounded_right_shift(rotated_a, 14);
+        // 4. T[ b ] is set equal to Round2( y, 14 ).
+        data[index_b] = rounded_right_shift(rotated_b, 14);
+    } else {
+        // NOTE: Non-conforming streams can have coefficients large enough for the products to overflow 32 bits, so
+        //       like above, they are computed in 64-bit lanes and truncated back to 32 bits after rounding.
+        using i64x8 = i64 __attribute__((vector_size(64)));
+        using WideVector = Conditional<sizeof(T) == sizeof(i32x4), i64x4, i64x8>;
+        static_assert(sizeof(WideVector) == sizeof(T) * 2);
+        auto a = __builtin_convertvector(data[index_a], WideVector);
+        auto b = __builtin_convertvector(data[index_b], WideVector);
+        WideVector rotated_a = a * cos - b * sin;
+        WideVector rotated_b = a * sin + b * cos;
+        data[index_a] = __builtin_convertvector((rotated_a + (1 << 13)) >> 14, T);
+        data[index_b] = __builtin_convertvector((rotated_b + (1 << 13)) >> 14, T);
+    }
 
     // The function B( a ,b, angle, 1 ) performs a butterfly rotation and flip specified by the following ordered steps:
     // 1. The function B( a, b, angle, 0 ) is invoked.
@@ -1370,7 +1481,8 @@ inline void Decoder::butterfly_rotation_in_place(Span<Intermediate> data, size_t
 }
 
 // (8.7.1.1) The function H( a, b, 0 ) performs a Hadamard rotation.
-inline void Decoder::hadamard_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, bool flip)
+template<typename T>
+ALWAYS_INLINE static void hadamard_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, bool flip)
 {
     // The function H( a, b, 1 ) performs a Hadamard rotation with flipped indices and is specified as follows:
     // 1. The function H( b, a, 0 ) is invoked.
@@ -1394,8 +1506,8 @@ inline void Decoder::hadamard_rotation_in_place(Span<Intermediate> data, size_t
     // to allow these bounds to be violated. Therefore, we can avoid the performance cost here.
 }
 
-template<u8 log2_of_block_size>
-inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_permutation(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+ALWAYS_INLINE static DecoderErrorOr<void> inverse_discrete_cosine_transform_array_permutation(Span<T> data)
 {
     static_assert(log2_of_block_size >= 2 && log2_of_block_size <= 5, "Block size out of range.");
 
@@ -1407,8 +1519,8 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
         return DecoderError::corrupted("Block size was out of range"sv);
 
     // 1.1. A temporary array named copyT is set equal to T.
-    Array<Intermediate, block_size> data_copy;
-    AK::TypedTransfer<Intermediate>::copy(data_copy.data(), data.data(), block_size);
+    Array<T, block_size> data_copy;
+    AK::TypedTransfer<T>::copy(data_copy.data(), data.data(), block_size);
 
     // 1.2. T[ i ] is set equal to copyT[ brev( n, i ) ] for i = 0..((1<<n) - 1).
     for (auto i = 0u; i < block_size; i++)
@@ -1417,8 +1529,8 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
     return {};
 }
 
-template<u8 log2_of_block_size>
-ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+ALWAYS_INLINE static DecoderErrorOr<void> inverse_discrete_cosine_transform(Span<T> data)
 {
     static_assert(log2_of_block_size >= 2 && log2_of_block_size <= 5, "Block size out of range.");
 
@@ -1518,6 +1630,91 @@ ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Sp
     return {};
 }
 
+// Performs the 2D inverse DCT of (8.7) on as many rows or columns at a time as there are lanes in Vector. The results
+// match inverse_discrete_cosine_transform() exactly, see butterfly_rotation_in_place().
+template<u8 log2_of_block_size, typename Vector>
+ALWAYS_INLINE static DecoderErrorOr<void> inverse_dct_2d_vectorized(Span<i32> dequantized)
+{
+    constexpr auto block_size = 1u << log2_of_block_size;
+    constexpr auto lanes = sizeof(Vector) / sizeof(i32);
+    static_assert(block_size % lanes == 0);
+
+    Array<Vector, block_size> vectors;
+    auto* coefficients = dequantized.data();
+
+    // The row transforms, where lane l of T[ j ] holds Dequant[ i + l ][ j ].
+    for (auto i = 0u; i < block_size; i += lanes) {
+        for (auto j = 0u; j < block_size; j++) {
+            for (auto lane = 0u; lane < lanes; lane++)
+                vectors[j][lane] = coefficients[(i + lane) * block_size + j];
+        }
+
+        TRY(inverse_discrete_cosine_transform_array_permutation<log2_of_block_size>(vectors.span()));
+        TRY(inverse_discrete_cosine_transform<log2_of_block_size>(vectors.span()));
+
+        for (auto j = 0u; j < block_size; j++) {
+            for (auto lane = 0u; lane < lanes; lane++)
+                coefficients[(i + lane) * block_size + j] = vectors[j][lane];
+        }
+    }
+
+    // The column transforms, where lane l of T[ i ] holds Dequant[ i ][ j + l ]. These are adjacent in memory.
+    constexpr auto shift = min(6u, log2_of_block_size + 2u);
+    for (auto j = 0u; j < block_size; j += lanes) {
+        for (auto i = 0u; i < block_size; i++)
+            vectors[i] = load_unaligned<Vector>(&coefficients[i * block_size + j]);
+
+        TRY(inverse_discrete_cosine_transform_array_permutation<log2_of_block_size>(vectors.span()));
+        TRY(inverse_discrete_cosine_transform<log2_of_block_size>(vectors.span()));
+
+        for (auto i = 0u; i < block_size; i++)
+            store_unaligned(&coefficients[i * block_size + j], (vectors[i] + (1 << (shift - 1))) >> shift);
+    }
+
+    return {};
+}
+
+ALWAYS_INLINE static DecoderErrorOr<void> inverse_dct_2d_8bit_block(u8 log2_of_block_size, Span<i32> dequantized)
+{
+    switch (log2_of_block_size) {
+    case 2:
+        return inverse_dct_2d_vectorized<2, i32x4>(dequantized);
+    case 3:
+        return inverse_dct_2d_vectorized<3, i32x8>(dequantized);
+    case 4:
+        return inverse_dct_2d_vectorized<4, i32x8>(dequantized);
+    case 5:
+        return inverse_dct_2d_vectorized<5, i32x8>(dequantized);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+template<CPUFeatures>
+static DecoderErrorOr<void> inverse_dct_2d_8bit_impl(u8 log2_of_block_size, Span<i32> dequantized)
+{
+    return inverse_dct_2d_8bit_block(log2_of_block_size, dequantized);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] DecoderErrorOr<void> inverse_dct_2d_8bit_impl<CPUFeatures::X86_AVX2>(u8 log2_of_block_size, Span<i32> dequantized)
+{
+    return inverse_dct_2d_8bit_block(log2_of_block_size, dequantized);
+}
+#endif
+
+static auto const inverse_dct_2d_8bit = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &inverse_dct_2d_8bit_impl<CPUFeatures::X86_AVX2>;
+    }
+
+    return &inverse_dct_2d_8bit_impl<CPUFeatures::None>;
+}();
+
 template<u8 log2_of_block_size>
 inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<Intermediate> data)
 {
@@ -1816,6 +2013,11 @@ ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext co
     // This process performs a 2D inverse transform for an array of size 2^n by 2^n stored in the 2D array Dequant.
     // The input to this process is a variable n (log2_of_block_size) that specifies the base 2 logarithm of the width of the transform.
 
+    // OPTIMIZATION: Most blocks in 8-bit video use DCT_DCT, so transform several of their rows and columns at once.
+    if (block_context.frame_context.color_config.bit_depth == 8 && !block_context.frame_context.lossless
+        && transform_set.first_transform == TransformType::DCT && transform_set.second_transform == TransformType::DCT)
+        return inverse_dct_2d_8bit(log2_of_block_size, dequantized);
+
     // 1. Set the variable n0 (block_size) equal to 1 << n.
     constexpr auto block_size = 1u << log2_of_block_size;
 
@@ -1954,31 +2156,32 @@ DecoderErrorOr<void> Decoder::update_reference_frames(FrameContext const& frame_
                 frame_store_buffer.resize_and_keep_capacity(frame_store_width * frame_store_height);
 
                 VERIFY(original_buffer.size() >= width * height);
-                for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
-                    // Offset the source row by the motion vector border and then clamp it to the range of 0...height.
-                    // This will create an extended border on the top and bottom of the reference frame to avoid having to bounds check
-                    // inter-prediction.
-                    auto source_y = min(destination_y >= MV_BORDER ? destination_y - MV_BORDER : 0, height - 1);
-                    auto const* source = &original_buffer[source_y * stride];
-                    auto* destination = &frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
-                    AK::TypedTransfer<RemoveReference<decltype(*destination)>>::copy(destination, source, width);
-                }
 
-                for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
-                    // Stretch the leftmost samples out into the border.
-                    auto sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
-
-                    for (auto destination_x = 0u; destination_x < MV_BORDER; destination_x++) {
-                        frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
+                // Each row of the frame store only depends on one row of the frame, so the rows are filled in bands.
+                auto band_count = ceil_div(frame_store_height, rows_per_band);
+                TRY(for_each_in_parallel(band_count, [&](size_t band) -> DecoderErrorOr<void> {
+                    auto rows_end = min<size_t>((band + 1) * rows_per_band, frame_store_height);
+                    for (auto destination_y = band * rows_per_band; destination_y < rows_end; destination_y++) {
+                        // Offset the source row by the motion vector border and then clamp it to the range of 0...height.
+                        // This will create an extended border on the top and bottom of the reference frame to avoid having to bounds check
+                        // inter-prediction.
+                        auto source_y = min<size_t>(destination_y >= MV_BORDER ? destination_y - MV_BORDER : 0, height - 1);
+                        auto const* source = &original_buffer[source_y * stride];
+                        auto* row = &frame_store_buffer[destination_y * frame_store_width];
+                        AK::TypedTransfer<RemoveReference<decltype(*row)>>::copy(row + MV_BORDER, source, width);
+
+                        // Stretch the leftmost samples out into the border.
+                        auto sample = row[MV_BORDER];
+                        for (auto destination_x = 0u; destination_x < MV_BORDER; destination_x++)
+                            row[destination_x] = sample;
+
+                        // Stretch the rightmost samples out into the border.
+                        sample = row[MV_BORDER + width - 1];
+                        for (auto destination_x = MV_BORDER + width; destination_x < frame_store_width; destination_x++)
+                            row[destination_x] = sample;
                     }
-
-                    // Stretch the rightmost samples out into the border.
-                    sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER + width - 1];
-
-                    for (auto destination_x = MV_BORDER + width; destination_x < frame_store_width; destination_x++) {
-                        frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
-                    }
-                }
+                    return {};
+                }));
             }
         }
     }
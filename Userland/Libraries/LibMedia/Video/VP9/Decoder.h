@@ -9,6 +9,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
+#include <AK/Function.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Queue.h>
 #include <AK/Span.h>
@@ -16,6 +17,7 @@
 #include <LibMedia/DecoderError.h>
 #include <LibMedia/VideoDecoder.h>
 #include <LibMedia/VideoFrame.h>
+#include <LibThreading/Forward.h>
 
 #include "Parser.h"
 
@@ -26,11 +28,11 @@ class Decoder final : public VideoDecoder {
 
 public:
     Decoder();
-    ~Decoder() override { }
+    ~Decoder() override;
     /* (8.1) General */
     DecoderErrorOr<void> receive_sample(Duration timestamp, ReadonlyBytes) override;
 
-    DecoderErrorOr<NonnullOwnPtr<VideoFrame>> get_decoded_frame() override;
+    DecoderErrorOr<NonnullRefPtr<VideoFrame>> get_decoded_frame() override;
 
     void flush() override;
 
@@ -44,6 +46,10 @@ private:
     static constexpr size_t maximum_transform_size = 32ULL * 32ULL;
 
     DecoderErrorOr<void> decode_frame(Duration timestamp, ReadonlyBytes);
+
+    // Calls task(i) for every i in [0, count), spreading the calls over the calling thread and the worker threads.
+    DecoderErrorOr<void> for_each_in_parallel(size_t count, Function<DecoderErrorOr<void>(size_t)> const& task);
+
     template<typename T>
     DecoderErrorOr<void> create_video_frame(Duration timestamp, FrameContext const&);
 
@@ -93,13 +99,9 @@ private:
 
     // (8.7.1) 1D Transforms
     // (8.7.1.1) Butterfly functions
+    // NOTE: cos64(), sin64(), B() and H() as well as the inverse DCT are defined as free functions in Decoder.cpp, so
+    //       that they can be applied to vectors of rows or columns as well as single rows and columns.
 
-    inline i32 cos64(u8 angle);
-    inline i32 sin64(u8 angle);
-    // The function B( a, b, angle, 0 ) performs a butterfly rotation.
-    inline void butterfly_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, u8 angle, bool flip);
-    // The function H( a, b, 0 ) performs a Hadamard rotation.
-    inline void hadamard_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, bool flip);
     // The function SB( a, b, angle, 0 ) performs a butterfly rotation.
     // Spec defines the source as array T, and the destination array as S.
     template<typename S, typename D>
@@ -112,13 +114,6 @@ private:
     // (8.7.1.10) This process does an in-place Walsh-Hadamard transform of the array T (of length 4).
     inline DecoderErrorOr<void> inverse_walsh_hadamard_transform(Span<Intermediate> data, u8 log2_of_block_size, u8 shift);
 
-    // (8.7.1.2) Inverse DCT array permutation process
-    template<u8 log2_of_block_size>
-    inline DecoderErrorOr<void> inverse_discrete_cosine_transform_array_permutation(Span<Intermediate> data);
-    // (8.7.1.3) Inverse DCT process
-    template<u8 log2_of_block_size>
-    inline DecoderErrorOr<void> inverse_discrete_cosine_transform(Span<Intermediate> data);
-
     // (8.7.1.4) This process performs the in-place permutation of the array T of length 2 n which is required as the first step of
     // the inverse ADST.
     template<u8 log2_of_block_size>
@@ -147,7 +142,9 @@ private:
 
     Vector<u16> m_output_buffers[3];
 
-    Queue<NonnullOwnPtr<VideoFrame>, 1> m_video_frame_queue;
+    Queue<NonnullRefPtr<VideoFrame>, 1> m_video_frame_queue;
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<DecoderError>>> m_worker_threads;
 };
 
 }
@@ -8,7 +8,6 @@
 #include <AK/MemoryStream.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/Size.h>
-#include <LibThreading/WorkerThread.h>
 
 #include "Context.h"
 #include "Decoder.h"
@@ -19,9 +18,6 @@
 #    pragma GCC optimize("O3")
 #endif
 
-// Beware, threading is unstable in Serenity with smp=on, and performs worse than with it off.
-#define VP9_TILE_THREADING
-
 namespace Media::Video::VP9 {
 
 #define TRY_READ(expression) DECODER_TRY(DecoderErrorCategory::Corrupted, expression)
@@ -940,40 +936,10 @@ DecoderErrorOr<void> Parser::decode_tiles(FrameContext& frame_context)
         return {};
     };
 
-#ifdef VP9_TILE_THREADING
-    auto const worker_count = tile_cols - 1;
-
-    if (m_worker_threads.size() < worker_count) {
-        m_worker_threads.clear();
-        m_worker_threads.ensure_capacity(worker_count);
-        for (auto i = 0u; i < worker_count; i++)
-            m_worker_threads.append(DECODER_TRY_ALLOC(Threading::WorkerThread<DecoderError>::create("Decoder Worker"sv)));
-    }
-    VERIFY(m_worker_threads.size() >= worker_count);
-
-    // Start tile column decoding tasks in thread workers starting from the second column.
-    for (auto tile_col = 1u; tile_col < tile_cols; tile_col++) {
-        auto& column_workload = tile_workloads[tile_col];
-        m_worker_threads[tile_col - 1]->start_task([&decode_tile_column, &column_workload]() -> DecoderErrorOr<void> {
-            return decode_tile_column(column_workload);
-        });
-    }
-
-    // Decode the first column in this thread.
-    auto result = decode_tile_column(tile_workloads[0]);
-
-    for (auto& worker_thread : m_worker_threads) {
-        auto task_result = worker_thread->wait_until_task_is_finished();
-        if (!result.is_error() && task_result.is_error())
-            result = move(task_result);
-    }
-
-    if (result.is_error())
-        return result;
-#else
-    for (auto& column_workloads : tile_workloads)
-        TRY(decode_tile_column(column_workloads));
-#endif
+    // Tile columns can be decoded independently of each other, tile rows within a column have to be decoded in order.
+    TRY(m_decoder.for_each_in_parallel(tile_cols, [&](size_t tile_col) {
+        return decode_tile_column(tile_workloads[tile_col]);
+    }));
 
     // Sum up all tile contexts' syntax element counters after all decodes have finished.
     for (auto& tile_contexts : tile_workloads) {
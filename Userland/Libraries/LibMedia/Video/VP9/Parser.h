@@ -14,7 +14,6 @@
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
 #include <LibMedia/DecoderError.h>
 #include <LibMedia/Forward.h>
-#include <LibThreading/Forward.h>
 
 #include "ContextStorage.h"
 #include "LookupTables.h"
@@ -140,8 +139,6 @@ private:
 
     OwnPtr<ProbabilityTables> m_probability_tables;
     Decoder& m_decoder;
-
-    Vector<NonnullOwnPtr<Threading::WorkerThread<DecoderError>>> m_worker_threads;
 };
 
 }
@@ -6,13 +6,22 @@
 
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibMedia/Color/ColorConverter.h>
 
 #include "VideoFrame.h"
 
 namespace Media {
 
-ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create(
+using AK::SIMD::i32x8;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::store_unaligned;
+
+// Keep the planes aligned to a cache line, so that no two planes share one.
+static constexpr size_t plane_alignment = 64;
+
+ErrorOr<NonnullRefPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create(
     Duration timestamp,
     Gfx::Size<u32> size,
     u8 bit_depth, CodingIndependentCodePoints cicp,
@@ -20,26 +29,15 @@ ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create(
 {
     VERIFY(bit_depth < 16);
     size_t component_size = bit_depth > 8 ? sizeof(u16) : sizeof(u8);
-    size_t alignment_size = max(bit_depth > 8 ? sizeof(u16) : sizeof(u8), sizeof(void*));
-
-    auto alloc_buffer = [&](size_t size) -> ErrorOr<u8*> {
-        void* buffer = nullptr;
-        auto result = posix_memalign(&buffer, alignment_size, size);
-        if (result != 0)
-            return Error::from_errno(result);
-        return reinterpret_cast<u8*>(buffer);
-    };
 
-    auto y_data_size = size.to_type<size_t>().area() * component_size;
-    auto uv_data_size = subsampling.subsampled_size(size).to_type<size_t>().area() * component_size;
-    auto* y_buffer = TRY(alloc_buffer(y_data_size));
-    auto* u_buffer = TRY(alloc_buffer(uv_data_size));
-    auto* v_buffer = TRY(alloc_buffer(uv_data_size));
+    auto y_data_size = align_up_to(size.to_type<size_t>().area() * component_size, plane_alignment);
+    auto uv_data_size = align_up_to(subsampling.subsampled_size(size).to_type<size_t>().area() * component_size, plane_alignment);
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(max(y_data_size + uv_data_size * 2, 1uz)));
 
-    return adopt_nonnull_own_or_enomem(new (nothrow) SubsampledYUVFrame(timestamp, size, bit_depth, cicp, subsampling, y_buffer, u_buffer, v_buffer));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) SubsampledYUVFrame(timestamp, size, bit_depth, cicp, subsampling, move(buffer), y_data_size, y_data_size + uv_data_size));
 }
 
-ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_data(
+ErrorOr<NonnullRefPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_data(
     Duration timestamp,
     Gfx::Size<u32> size,
     u8 bit_depth, CodingIndependentCodePoints cicp,
@@ -62,13 +60,6 @@ ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_d
     return frame;
 }
 
-SubsampledYUVFrame::~SubsampledYUVFrame()
-{
-    free(m_y_buffer);
-    free(m_u_buffer);
-    free(m_v_buffer);
-}
-
 template<u32 subsampling_horizontal, typename T>
 ALWAYS_INLINE void interpolate_row(u32 const row, u32 const width, T const* plane_u, T const* plane_v, T* __restrict__ u_row, T* __restrict__ v_row)
 {
@@ -174,6 +165,14 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
     return {};
 }
 
+static constexpr auto output_cicp = CodingIndependentCodePoints(ColorPrimaries::BT709, TransferCharacteristics::SRGB, MatrixCoefficients::BT709, VideoFullRangeFlag::Full);
+
+// Whether the frame can be converted with ColorConverter::convert_simple_yuv_to_rgb(), given its matrix coefficients.
+static bool can_use_simple_conversion(CodingIndependentCodePoints cicp, u8 bit_depth)
+{
+    return bit_depth == 8 && cicp.transfer_characteristics() == output_cicp.transfer_characteristics() && cicp.color_primaries() == output_cicp.color_primaries() && cicp.video_full_range_flag() == VideoFullRangeFlag::Studio;
+}
+
 template<u32 subsampling_horizontal, u32 subsampling_vertical, typename T>
 static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_selecting_converter(CodingIndependentCodePoints cicp, u8 bit_depth, u32 const width, u32 const height, void* plane_y_data, void* plane_u_data, void* plane_v_data, Gfx::Bitmap& bitmap)
 {
@@ -181,9 +180,7 @@ static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_selecting_converter(
     auto const* plane_u = reinterpret_cast<T const*>(plane_u_data);
     auto const* plane_v = reinterpret_cast<T const*>(plane_v_data);
 
-    constexpr auto output_cicp = CodingIndependentCodePoints(ColorPrimaries::BT709, TransferCharacteristics::SRGB, MatrixCoefficients::BT709, VideoFullRangeFlag::Full);
-
-    if (bit_depth == 8 && cicp.transfer_characteristics() == output_cicp.transfer_characteristics() && cicp.color_primaries() == output_cicp.color_primaries() && cicp.video_full_range_flag() == VideoFullRangeFlag::Studio) {
+    if (can_use_simple_conversion(cicp, bit_depth)) {
         switch (cicp.matrix_coefficients()) {
         case MatrixCoefficients::BT470BG:
         case MatrixCoefficients::BT601:
@@ -231,4 +228,139 @@ DecoderErrorOr<void> SubsampledYUVFrame::output_to_bitmap(Gfx::Bitmap& bitmap)
     return convert_to_bitmap_selecting_subsampling(m_subsampling, cicp(), bit_depth(), width(), height(), m_y_buffer, m_u_buffer, m_v_buffer, bitmap);
 }
 
+// The two source samples that a destination sample is bilinearly interpolated from, and the weight of the second one.
+struct SamplePosition {
+    u32 index;
+    u32 next_index;
+    i32 weight;
+};
+
+static constexpr i32 interpolation_weight_bits = 8;
+static constexpr i32 interpolation_weight_one = 1 << interpolation_weight_bits;
+
+// Computes the sample positions for destination samples first...(first + count - 1) when scaling source_size samples
+// to destination_size samples, keeping the centers of the first and last samples aligned.
+static ErrorOr<FixedArray<SamplePosition>> compute_sample_positions(u32 source_size, i32 destination_size, i32 first, i32 count)
+{
+    VERIFY(source_size > 0 && destination_size > 0);
+    auto positions = TRY(FixedArray<SamplePosition>::create(count));
+    auto const last_position = static_cast<i64>(source_size - 1) * interpolation_weight_one;
+
+    for (i32 i = 0; i < count; i++) {
+        i64 destination = first + i;
+        // ((destination + 0.5) * source_size / destination_size) - 0.5, with interpolation_weight_bits of fraction.
+        auto position = ((2 * destination + 1) * source_size * interpolation_weight_one) / (2 * static_cast<i64>(destination_size)) - interpolation_weight_one / 2;
+        position = clamp(position, 0, last_position);
+
+        auto index = static_cast<u32>(position >> interpolation_weight_bits);
+        positions[i] = {
+            .index = index,
+            .next_index = min(index + 1, source_size - 1),
+            .weight = static_cast<i32>(position & (interpolation_weight_one - 1)),
+        };
+    }
+
+    return positions;
+}
+
+template<typename T>
+ALWAYS_INLINE static void interpolate_scaled_row(T const* above, T const* below, i32 vertical_weight, ReadonlySpan<SamplePosition> columns, i32* output)
+{
+    for (size_t i = 0; i < columns.size(); i++) {
+        auto const& column = columns[i];
+        i32 top = above[column.index] * (interpolation_weight_one - column.weight) + above[column.next_index] * column.weight;
+        i32 bottom = below[column.index] * (interpolation_weight_one - column.weight) + below[column.next_index] * column.weight;
+        output[i] = (top * (interpolation_weight_one - vertical_weight) + bottom * vertical_weight + (1 << (2 * interpolation_weight_bits - 1))) >> (2 * interpolation_weight_bits);
+    }
+}
+
+template<typename T, typename ConvertRow>
+static DecoderErrorOr<void> convert_to_bitmap_scaled(ConvertRow convert_row, Gfx::Size<u32> size, Subsampling subsampling, T const* plane_y, T const* plane_u, T const* plane_v, Gfx::Bitmap& bitmap, Gfx::IntRect const& destination_rect, Gfx::IntRect const& clip_rect)
+{
+    auto rect = destination_rect.intersected(clip_rect).intersected(bitmap.rect());
+    if (rect.is_empty())
+        return {};
+
+    auto uv_size = subsampling.subsampled_size(size);
+    auto first_column = rect.left() - destination_rect.left();
+    auto first_row = rect.top() - destination_rect.top();
+
+    auto luma_columns = DECODER_TRY_ALLOC(compute_sample_positions(size.width(), destination_rect.width(), first_column, rect.width()));
+    auto luma_rows = DECODER_TRY_ALLOC(compute_sample_positions(size.height(), destination_rect.height(), first_row, rect.height()));
+    auto chroma_columns = DECODER_TRY_ALLOC(compute_sample_positions(uv_size.width(), destination_rect.width(), first_column, rect.width()));
+    auto chroma_rows = DECODER_TRY_ALLOC(compute_sample_positions(uv_size.height(), destination_rect.height(), first_row, rect.height()));
+
+    auto row_buffer = DECODER_TRY_ALLOC(FixedArray<i32>::create(static_cast<size_t>(rect.width()) * 3));
+    auto* y_row = row_buffer.data();
+    auto* u_row = y_row + rect.width();
+    auto* v_row = u_row + rect.width();
+
+    for (i32 row = 0; row < rect.height(); row++) {
+        auto const& luma_row = luma_rows[row];
+        interpolate_scaled_row(plane_y + luma_row.index * size.width(), plane_y + luma_row.next_index * size.width(), luma_row.weight, luma_columns.span(), y_row);
+
+        auto const& chroma_row = chroma_rows[row];
+        interpolate_scaled_row(plane_u + chroma_row.index * uv_size.width(), plane_u + chroma_row.next_index * uv_size.width(), chroma_row.weight, chroma_columns.span(), u_row);
+        interpolate_scaled_row(plane_v + chroma_row.index * uv_size.width(), plane_v + chroma_row.next_index * uv_size.width(), chroma_row.weight, chroma_columns.span(), v_row);
+
+        convert_row(y_row, u_row, v_row, bitmap.scanline(rect.top() + row) + rect.left(), static_cast<size_t>(rect.width()));
+    }
+
+    return {};
+}
+
+template<MatrixCoefficients MC>
+static void convert_simple_row(i32 const* y, i32 const* u, i32 const* v, Gfx::ARGB32* output, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        i32x8 red;
+        i32x8 green;
+        i32x8 blue;
+        ColorConverter::convert_simple_yuv_to_rgb_components<MC, VideoFullRangeFlag::Studio>(load_unaligned<i32x8>(y + i), load_unaligned<i32x8>(u + i), load_unaligned<i32x8>(v + i), red, green, blue);
+        store_unaligned(output + i, static_cast<i32>(0xff000000) | (red << 16) | (green << 8) | blue);
+    }
+    for (; i < count; i++)
+        output[i] = ColorConverter::convert_simple_yuv_to_rgb<MC, VideoFullRangeFlag::Studio>(static_cast<u8>(y[i]), static_cast<u8>(u[i]), static_cast<u8>(v[i])).value();
+}
+
+template<typename T>
+static DecoderErrorOr<void> convert_to_bitmap_scaled_selecting_converter(CodingIndependentCodePoints cicp, u8 bit_depth, Gfx::Size<u32> size, Subsampling subsampling, void* plane_y_data, void* plane_u_data, void* plane_v_data, Gfx::Bitmap& bitmap, Gfx::IntRect const& destination_rect, Gfx::IntRect const& clip_rect)
+{
+    auto const* plane_y = reinterpret_cast<T const*>(plane_y_data);
+    auto const* plane_u = reinterpret_cast<T const*>(plane_u_data);
+    auto const* plane_v = reinterpret_cast<T const*>(plane_v_data);
+
+    if (can_use_simple_conversion(cicp, bit_depth)) {
+        switch (cicp.matrix_coefficients()) {
+        case MatrixCoefficients::BT470BG:
+        case MatrixCoefficients::BT601:
+            return convert_to_bitmap_scaled(convert_simple_row<MatrixCoefficients::BT601>, size, subsampling, plane_y, plane_u, plane_v, bitmap, destination_rect, clip_rect);
+        case MatrixCoefficients::BT709:
+            return convert_to_bitmap_scaled(convert_simple_row<MatrixCoefficients::BT709>, size, subsampling, plane_y, plane_u, plane_v, bitmap, destination_rect, clip_rect);
+        default:
+            break;
+        }
+    }
+
+    auto converter = TRY(ColorConverter::create(bit_depth, cicp, output_cicp));
+    auto convert_row = [&](i32 const* y, i32 const* u, i32 const* v, Gfx::ARGB32* output, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            output[i] = converter.convert_yuv(static_cast<T>(y[i]), static_cast<T>(u[i]), static_cast<T>(v[i])).value();
+    };
+    return convert_to_bitmap_scaled(convert_row, size, subsampling, plane_y, plane_u, plane_v, bitmap, destination_rect, clip_rect);
+}
+
+DecoderErrorOr<void> SubsampledYUVFrame::output_to_bitmap(Gfx::Bitmap& bitmap, Gfx::IntRect const& destination_rect, Gfx::IntRect const& clip_rect)
+{
+    // The unscaled conversion interpolates the chroma planes in its own way, so keep using it for full size bitmaps.
+    auto frame_rect = Gfx::IntRect { {}, size().to_type<int>() };
+    if (destination_rect == frame_rect && bitmap.rect() == frame_rect && clip_rect.contains(frame_rect))
+        return output_to_bitmap(bitmap);
+
+    if (bit_depth() <= 8)
+        return convert_to_bitmap_scaled_selecting_converter<u8>(cicp(), bit_depth(), size(), m_subsampling, m_y_buffer, m_u_buffer, m_v_buffer, bitmap, destination_rect, clip_rect);
+    return convert_to_bitmap_scaled_selecting_converter<u16>(cicp(), bit_depth(), size(), m_subsampling, m_y_buffer, m_u_buffer, m_v_buffer, bitmap, destination_rect, clip_rect);
+}
+
 }
@@ -8,8 +8,11 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/FixedArray.h>
+#include <AK/RefCounted.h>
 #include <AK/Time.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
 
@@ -18,12 +21,15 @@
 
 namespace Media {
 
-class VideoFrame {
+class VideoFrame : public RefCounted<VideoFrame> {
 
 public:
     virtual ~VideoFrame() { }
 
     virtual DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap) = 0;
+    // Converts the frame and scales it to destination_rect of the bitmap in a single pass, only writing the pixels
+    // within clip_rect. This allows painting a frame without converting it to a full size bitmap first.
+    virtual DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap, Gfx::IntRect const& destination_rect, Gfx::IntRect const& clip_rect) = 0;
     virtual DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> to_bitmap()
     {
         auto bitmap = DECODER_TRY_ALLOC(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { width(), height() }));
@@ -57,16 +63,18 @@ protected:
     CodingIndependentCodePoints m_cicp;
 };
 
+// A frame stored as planar YUV, with all the planes in a single anonymous buffer, so that it can be shared with other
+// threads or processes without being copied.
 class SubsampledYUVFrame : public VideoFrame {
 
 public:
-    static ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> try_create(
+    static ErrorOr<NonnullRefPtr<SubsampledYUVFrame>> try_create(
         Duration timestamp,
         Gfx::Size<u32> size,
         u8 bit_depth, CodingIndependentCodePoints cicp,
         Subsampling subsampling);
 
-    static ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> try_create_from_data(
+    static ErrorOr<NonnullRefPtr<SubsampledYUVFrame>> try_create_from_data(
         Duration timestamp,
         Gfx::Size<u32> size,
         u8 bit_depth, CodingIndependentCodePoints cicp,
@@ -78,21 +86,22 @@ public:
         Gfx::Size<u32> size,
         u8 bit_depth, CodingIndependentCodePoints cicp,
         Subsampling subsampling,
-        u8* plane_y_data, u8* plane_u_data, u8* plane_v_data)
+        Core::AnonymousBuffer buffer, size_t plane_u_offset, size_t plane_v_offset)
         : VideoFrame(timestamp, size, bit_depth, cicp)
         , m_subsampling(subsampling)
-        , m_y_buffer(plane_y_data)
-        , m_u_buffer(plane_u_data)
-        , m_v_buffer(plane_v_data)
+        , m_buffer(move(buffer))
+        , m_y_buffer(m_buffer.data<u8>())
+        , m_u_buffer(m_y_buffer + plane_u_offset)
+        , m_v_buffer(m_y_buffer + plane_v_offset)
     {
-        VERIFY(m_y_buffer != nullptr);
-        VERIFY(m_u_buffer != nullptr);
-        VERIFY(m_v_buffer != nullptr);
+        VERIFY(m_buffer.is_valid());
     }
 
-    ~SubsampledYUVFrame();
-
     DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap) override;
+    DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap, Gfx::IntRect const& destination_rect, Gfx::IntRect const& clip_rect) override;
+
+    Subsampling subsampling() const { return m_subsampling; }
+    Core::AnonymousBuffer const& anonymous_buffer() const { return m_buffer; }
 
     u8* get_raw_plane_data(u32 plane)
     {
@@ -116,6 +125,7 @@ public:
 
 protected:
     Subsampling m_subsampling;
+    Core::AnonymousBuffer m_buffer;
     u8* m_y_buffer = nullptr;
     u8* m_u_buffer = nullptr;
     u8* m_v_buffer = nullptr;
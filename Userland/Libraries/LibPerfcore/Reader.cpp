@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/LEB128.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibPerfcore/Reader.h>
+#include <serenity.h>
+
+namespace Perfcore {
+
+class JsonReader final : public Reader {
+public:
+    static ErrorOr<NonnullOwnPtr<Reader>> create(ReadonlyBytes data)
+    {
+        auto json = JsonValue::from_string(StringView { data });
+        if (json.is_error() || !json.value().is_object())
+            return Error::from_string_literal("Invalid perfcore format (not a JSON object)");
+
+        auto reader = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JsonReader(move(json.value().as_object()))));
+
+        auto strings = reader->m_object.get_array("strings"sv);
+        if (!strings.has_value())
+            return Error::from_string_literal("Malformed profile (strings is not an array)");
+        for (auto const& string : strings->values())
+            TRY(reader->m_strings.try_append(string.as_string()));
+
+        if (!reader->m_object.get_array("events"sv).has_value())
+            return Error::from_string_literal("Malformed profile (events is not an array)");
+        return reader;
+    }
+
+    virtual ErrorOr<bool> next_event(Event& event) override
+    {
+        auto const& events = m_object.get_array("events"sv).value();
+        if (m_next_event_index >= events.size())
+            return false;
+        auto const& perf_event = events.at(m_next_event_index++).as_object();
+
+        event = {};
+        event.timestamp = perf_event.get_u64("timestamp"sv).value_or(0);
+        event.lost_samples = perf_event.get_u32("lost_samples"sv).value_or(0);
+        event.pid = perf_event.get_i32("pid"sv).value_or(0);
+        event.tid = perf_event.get_i32("tid"sv).value_or(0);
+
+        auto type_string = perf_event.get_byte_string("type"sv).value_or({});
+        if (type_string == "sample"sv) {
+            event.type = PERF_EVENT_SAMPLE;
+        } else if (type_string == "malloc"sv) {
+            event.type = PERF_EVENT_MALLOC;
+        } else if (type_string == "free"sv) {
+            event.type = PERF_EVENT_FREE;
+        } else if (type_string == "mmap"sv) {
+            event.type = PERF_EVENT_MMAP;
+        } else if (type_string == "munmap"sv) {
+            event.type = PERF_EVENT_MUNMAP;
+        } else if (type_string == "process_create"sv) {
+            event.type = PERF_EVENT_PROCESS_CREATE;
+        } else if (type_string == "process_exec"sv) {
+            event.type = PERF_EVENT_PROCESS_EXEC;
+        } else if (type_string == "process_exit"sv) {
+            event.type = PERF_EVENT_PROCESS_EXIT;
+        } else if (type_string == "thread_create"sv) {
+            event.type = PERF_EVENT_THREAD_CREATE;
+        } else if (type_string == "thread_exit"sv) {
+            event.type = PERF_EVENT_THREAD_EXIT;
+        } else if (type_string == "context_switch"sv) {
+            event.type = PERF_EVENT_CONTEXT_SWITCH;
+        } else if (type_string == "kmalloc"sv) {
+            event.type = PERF_EVENT_KMALLOC;
+        } else if (type_string == "kfree"sv) {
+            event.type = PERF_EVENT_KFREE;
+        } else if (type_string == "page_fault"sv) {
+            event.type = PERF_EVENT_PAGE_FAULT;
+        } else if (type_string == "syscall"sv) {
+            event.type = PERF_EVENT_SYSCALL;
+        } else if (type_string == "signpost"sv) {
+            event.type = PERF_EVENT_SIGNPOST;
+        } else if (type_string == "filesystem"sv) {
+            event.type = PERF_EVENT_FILESYSTEM;
+        } else {
+            dbgln("Unknown event type '{}'", type_string);
+        }
+
+        event.ptr = perf_event.get_addr("ptr"sv).value_or(0);
+        event.size = perf_event.get_integer<size_t>("size"sv).value_or(0);
+        event.name = perf_event.get_byte_string("name"sv).value_or({});
+        event.parent_pid = perf_event.get_integer<pid_t>("parent_pid"sv).value_or(0);
+        event.parent_tid = perf_event.get_integer<pid_t>("parent_tid"sv).value_or(0);
+        event.executable = perf_event.get_byte_string("executable"sv).value_or({});
+        event.next_pid = perf_event.get_integer<pid_t>("next_pid"sv).value_or(0);
+        event.next_tid = perf_event.get_integer<pid_t>("next_tid"sv).value_or(0);
+        event.arg1 = perf_event.get_addr("arg1"sv).value_or(0);
+        event.arg2 = perf_event.get_addr("arg2"sv).value_or(0);
+
+        if (event.type == PERF_EVENT_FILESYSTEM) {
+            auto& filesystem = event.filesystem;
+            auto filesystem_event_type = perf_event.get_byte_string("fs_event_type"sv).value_or({});
+            if (filesystem_event_type == "open"sv)
+                filesystem.type = FilesystemEventType::Open;
+            else if (filesystem_event_type == "close"sv)
+                filesystem.type = FilesystemEventType::Close;
+            else if (filesystem_event_type == "preadv"sv)
+                filesystem.type = FilesystemEventType::Preadv;
+            else if (filesystem_event_type == "read"sv)
+                filesystem.type = FilesystemEventType::Read;
+            else if (filesystem_event_type == "pread"sv)
+                filesystem.type = FilesystemEventType::Pread;
+            filesystem.duration_ns = perf_event.get_integer<u64>("durationNs"sv).value_or(0);
+            filesystem.fd = perf_event.get_integer<int>(filesystem.type == FilesystemEventType::Open ? "dirfd"sv : "fd"sv).value_or(0);
+            filesystem.filename_index = perf_event.get_addr("filename_index"sv).value_or(0);
+            filesystem.options = perf_event.get_integer<int>("options"sv).value_or(0);
+            filesystem.mode = perf_event.get_integer<u64>("mode"sv).value_or(0);
+            filesystem.offset = perf_event.get_integer<off_t>("offset"sv).value_or(0);
+            filesystem.buffer_ptr = perf_event.get_integer<FlatPtr>("buffer_ptr"sv).value_or(0);
+            filesystem.size = event.size;
+        }
+
+        m_stack.clear_with_capacity();
+        if (auto stack = perf_event.get_array("stack"sv); stack.has_value()) {
+            for (auto const& frame : stack->values())
+                TRY(m_stack.try_append(frame.as_integer<u64>()));
+        }
+        event.stack = m_stack.span();
+        return true;
+    }
+
+private:
+    explicit JsonReader(JsonObject object)
+        : m_object(move(object))
+    {
+    }
+
+    JsonObject m_object;
+    size_t m_next_event_index { 0 };
+    Vector<FlatPtr> m_stack;
+};
+
+class BinaryReader final : public Reader {
+public:
+    static ErrorOr<NonnullOwnPtr<Reader>> create(ReadonlyBytes data, OwnPtr<Core::MappedFile> mapped_file, ByteBuffer buffer)
+    {
+        auto reader = TRY(adopt_nonnull_own_or_enomem(new (nothrow) BinaryReader(data, move(mapped_file), move(buffer))));
+        TRY(reader->m_stream.discard(sizeof(magic)));
+        auto format_version = TRY(reader->read_unsigned());
+        if (format_version != version)
+            return Error::from_string_literal("Unsupported perfcore format version");
+        // Stack numbers start at 1, 0 means there is no stack.
+        TRY(reader->m_stack_offsets.try_append(0));
+        return reader;
+    }
+
+    virtual ErrorOr<bool> next_event(Event& event) override
+    {
+        while (!m_stream.is_eof()) {
+            auto record_type = static_cast<RecordType>(TRY(m_stream.read_value<u8>()));
+            switch (record_type) {
+            case RecordType::String:
+                TRY(m_strings.try_append(TRY(read_string())));
+                break;
+            case RecordType::Stack:
+                TRY(read_stack());
+                break;
+            case RecordType::Event:
+                TRY(read_event(event));
+                return true;
+            default:
+                return Error::from_string_literal("Malformed profile (unknown record type)");
+            }
+        }
+        return false;
+    }
+
+private:
+    BinaryReader(ReadonlyBytes data, OwnPtr<Core::MappedFile> mapped_file, ByteBuffer buffer)
+        : m_mapped_file(move(mapped_file))
+        , m_buffer(move(buffer))
+        , m_stream(data)
+    {
+    }
+
+    ErrorOr<u64> read_unsigned() { return TRY(m_stream.read_value<LEB128<u64>>()); }
+    ErrorOr<i64> read_signed() { return TRY(m_stream.read_value<LEB128<i64>>()); }
+
+    ErrorOr<ByteString> read_string()
+    {
+        auto length = TRY(read_unsigned());
+        if (length > m_stream.remaining())
+            return Error::from_string_literal("Malformed profile (string is too long)");
+        auto bytes = TRY(m_stream.read_in_place<u8 const>(length));
+        return ByteString { bytes };
+    }
+
+    ErrorOr<void> read_stack()
+    {
+        auto frame_count = TRY(read_unsigned());
+        if (frame_count == 0 || frame_count > m_stream.remaining())
+            return Error::from_string_literal("Malformed profile (invalid stack)");
+        FlatPtr frame = TRY(read_unsigned());
+        TRY(m_stack_frames.try_append(frame));
+        for (size_t i = 1; i < frame_count; ++i) {
+            frame += TRY(read_signed());
+            TRY(m_stack_frames.try_append(frame));
+        }
+        TRY(m_stack_offsets.try_append(m_stack_frames.size() - frame_count));
+        return {};
+    }
+
+    ErrorOr<void> read_event(Event& event)
+    {
+        event = {};
+        event.type = TRY(read_unsigned());
+        event.pid = TRY(read_unsigned());
+        event.tid = TRY(read_unsigned());
+        m_timestamp += TRY(read_signed());
+        event.timestamp = m_timestamp;
+        event.lost_samples = TRY(read_unsigned());
+
+        event.stack_id = TRY(read_unsigned());
+        if (event.stack_id >= m_stack_offsets.size())
+            return Error::from_string_literal("Malformed profile (unknown stack)");
+        if (event.stack_id != 0) {
+            auto start = m_stack_offsets[event.stack_id];
+            auto end = event.stack_id + 1 < m_stack_offsets.size() ? m_stack_offsets[event.stack_id + 1] : m_stack_frames.size();
+            event.stack = m_stack_frames.span().slice(start, end - start);
+        }
+
+        switch (event.type) {
+        case PERF_EVENT_MALLOC:
+        case PERF_EVENT_FREE:
+        case PERF_EVENT_MUNMAP:
+        case PERF_EVENT_KMALLOC:
+        case PERF_EVENT_KFREE:
+            event.size = TRY(read_unsigned());
+            event.ptr = TRY(read_unsigned());
+            break;
+        case PERF_EVENT_MMAP:
+            event.size = TRY(read_unsigned());
+            event.ptr = TRY(read_unsigned());
+            event.name = TRY(read_string());
+            break;
+        case PERF_EVENT_PROCESS_CREATE:
+            event.parent_pid = TRY(read_signed());
+            event.executable = TRY(read_string());
+            break;
+        case PERF_EVENT_PROCESS_EXEC:
+            event.executable = TRY(read_string());
+            break;
+        case PERF_EVENT_THREAD_CREATE:
+            event.parent_tid = TRY(read_signed());
+            break;
+        case PERF_EVENT_CONTEXT_SWITCH:
+            event.next_pid = TRY(read_signed());
+            event.next_tid = TRY(read_unsigned());
+            break;
+        case PERF_EVENT_SIGNPOST:
+            event.arg1 = TRY(read_unsigned());
+            event.arg2 = TRY(read_unsigned());
+            break;
+        case PERF_EVENT_FILESYSTEM: {
+            auto& filesystem = event.filesystem;
+            filesystem.type = static_cast<FilesystemEventType>(TRY(m_stream.read_value<u8>()));
+            filesystem.duration_ns = TRY(read_unsigned());
+            switch (filesystem.type) {
+            case FilesystemEventType::Open:
+                filesystem.fd = TRY(read_signed());
+                filesystem.filename_index = TRY(read_unsigned());
+                filesystem.options = TRY(read_signed());
+                filesystem.mode = TRY(read_unsigned());
+                break;
+            case FilesystemEventType::Close:
+            case FilesystemEventType::Read:
+                filesystem.fd = TRY(read_signed());
+                filesystem.filename_index = TRY(read_unsigned());
+                break;
+            case FilesystemEventType::Preadv:
+                filesystem.fd = TRY(read_signed());
+                filesystem.filename_index = TRY(read_unsigned());
+                filesystem.offset = TRY(read_signed());
+                break;
+            case FilesystemEventType::Pread:
+                filesystem.fd = TRY(read_signed());
+                filesystem.filename_index = TRY(read_unsigned());
+                filesystem.buffer_ptr = TRY(read_unsigned());
+                filesystem.size = TRY(read_unsigned());
+                filesystem.offset = TRY(read_signed());
+                break;
+            default:
+                return Error::from_string_literal("Malformed profile (unknown filesystem event type)");
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        return {};
+    }
+
+    // NOTE: Only one of these is used, depending on whether the file could be mapped.
+    OwnPtr<Core::MappedFile> m_mapped_file;
+    ByteBuffer m_buffer;
+
+    FixedMemoryStream m_stream;
+    u64 m_timestamp { 0 };
+
+    // All interned stacks are kept in one flat vector, m_stack_offsets[n] is where stack number n starts.
+    Vector<FlatPtr> m_stack_frames;
+    Vector<size_t> m_stack_offsets;
+};
+
+ErrorOr<NonnullOwnPtr<Reader>> Reader::open(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto stat = TRY(Core::System::fstat(file->fd()));
+
+    // Files in ProcFS and SysFS have no size and can't be mapped, so we read those into memory instead.
+    // NOTE: We must only open those once, as reading /sys/kernel/profile may consume the events it returns.
+    OwnPtr<Core::MappedFile> mapped_file;
+    ByteBuffer buffer;
+    ReadonlyBytes data;
+    if (stat.st_size > 0) {
+        mapped_file = TRY(Core::MappedFile::map_from_file(move(file), path));
+        data = mapped_file->bytes();
+    } else {
+        buffer = TRY(file->read_until_eof());
+        data = buffer.bytes();
+    }
+
+    if (data.starts_with({ magic, sizeof(magic) }))
+        return BinaryReader::create(data, move(mapped_file), move(buffer));
+    return JsonReader::create(data);
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <Kernel/API/Perfcore.h>
+
+namespace Perfcore {
+
+// An event as it was recorded by the kernel, independent of the format of the perfcore file it was read from.
+struct Event {
+    int type { 0 };
+    pid_t pid { 0 };
+    pid_t tid { 0 };
+    u64 timestamp { 0 };
+    u32 lost_samples { 0 };
+
+    // Stacks are interned in binary perfcore files, this is 0 if the stack has no number.
+    u32 stack_id { 0 };
+    ReadonlySpan<FlatPtr> stack;
+
+    FlatPtr ptr { 0 };
+    size_t size { 0 };
+    ByteString name;
+    pid_t parent_pid { 0 };
+    pid_t parent_tid { 0 };
+    ByteString executable;
+    pid_t next_pid { 0 };
+    pid_t next_tid { 0 };
+    FlatPtr arg1 { 0 };
+    FlatPtr arg2 { 0 };
+
+    struct Filesystem {
+        FilesystemEventType type { FilesystemEventType::Open };
+        u64 duration_ns { 0 };
+        int fd { 0 };
+        FlatPtr filename_index { 0 };
+        int options { 0 };
+        u64 mode { 0 };
+        off_t offset { 0 };
+        FlatPtr buffer_ptr { 0 };
+        size_t size { 0 };
+    } filesystem;
+};
+
+class Reader {
+public:
+    // Binary perfcore files are decoded one event at a time straight from the mapped file,
+    // JSON perfcore files (like /proc/PID/perf_events) are parsed up front.
+    // The format is detected from the contents of the file.
+    static ErrorOr<NonnullOwnPtr<Reader>> open(StringView path);
+
+    virtual ~Reader() = default;
+
+    // Returns false once there are no more events. The stack of the event is only valid until the next call.
+    virtual ErrorOr<bool> next_event(Event&) = 0;
+
+    // NOTE: In binary perfcore files, strings are only known once an event that refers to them has been read.
+    Vector<ByteString> const& strings() const { return m_strings; }
+
+protected:
+    Vector<ByteString> m_strings;
+};
+
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/Stream.h>
+#include <LibPerfcore/Writer.h>
+#include <serenity.h>
+
+namespace Perfcore {
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(Stream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    ErrorOr<void> write_record_type(RecordType type) { return m_stream.write_value(to_underlying(type)); }
+
+    ErrorOr<void> write_unsigned(u64 value)
+    {
+        u8 buffer[max_leb128_size];
+        auto size = encode_unsigned(value, buffer);
+        return m_stream.write_until_depleted({ buffer, size });
+    }
+
+    ErrorOr<void> write_signed(i64 value)
+    {
+        u8 buffer[max_leb128_size];
+        auto size = encode_signed(value, buffer);
+        return m_stream.write_until_depleted({ buffer, size });
+    }
+
+    ErrorOr<void> write_string(StringView string)
+    {
+        TRY(write_unsigned(string.length()));
+        return m_stream.write_until_depleted(string.bytes());
+    }
+
+private:
+    Stream& m_stream;
+};
+
+struct StackTraits : public DefaultTraits<Vector<FlatPtr>> {
+    static unsigned hash(Vector<FlatPtr> const& stack)
+    {
+        unsigned hash = stack.size();
+        for (auto frame : stack)
+            hash = pair_int_hash(hash, Traits<FlatPtr>::hash(frame));
+        return hash;
+    }
+};
+
+ErrorOr<void> write_binary(Reader& reader, Stream& stream)
+{
+    BinaryWriter writer { stream };
+    TRY(stream.write_until_depleted({ magic, sizeof(magic) }));
+    TRY(writer.write_unsigned(version));
+
+    HashMap<Vector<FlatPtr>, u32, StackTraits> stack_ids;
+    size_t written_string_count = 0;
+    u64 previous_timestamp = 0;
+
+    Event event;
+    while (TRY(reader.next_event(event))) {
+        for (; written_string_count < reader.strings().size(); ++written_string_count) {
+            TRY(writer.write_record_type(RecordType::String));
+            TRY(writer.write_string(reader.strings()[written_string_count]));
+        }
+
+        u32 stack_id = 0;
+        if (!event.stack.is_empty()) {
+            Vector<FlatPtr> stack;
+            TRY(stack.try_append(event.stack.data(), event.stack.size()));
+            if (auto it = stack_ids.find(stack); it != stack_ids.end()) {
+                stack_id = it->value;
+            } else {
+                stack_id = stack_ids.size() + 1;
+                TRY(writer.write_record_type(RecordType::Stack));
+                TRY(writer.write_unsigned(stack.size()));
+                TRY(writer.write_unsigned(stack[0]));
+                for (size_t i = 1; i < stack.size(); ++i)
+                    TRY(writer.write_signed(static_cast<i64>(stack[i] - stack[i - 1])));
+                TRY(stack_ids.try_set(move(stack), stack_id));
+            }
+        }
+
+        TRY(writer.write_record_type(RecordType::Event));
+        TRY(writer.write_unsigned(event.type));
+        TRY(writer.write_unsigned(event.pid));
+        TRY(writer.write_unsigned(event.tid));
+        TRY(writer.write_signed(static_cast<i64>(event.timestamp - previous_timestamp)));
+        TRY(writer.write_unsigned(event.lost_samples));
+        TRY(writer.write_unsigned(stack_id));
+        previous_timestamp = event.timestamp;
+
+        switch (event.type) {
+        case PERF_EVENT_MALLOC:
+        case PERF_EVENT_FREE:
+        case PERF_EVENT_MUNMAP:
+        case PERF_EVENT_KMALLOC:
+        case PERF_EVENT_KFREE:
+            TRY(writer.write_unsigned(event.size));
+            TRY(writer.write_unsigned(event.ptr));
+            break;
+        case PERF_EVENT_MMAP:
+            TRY(writer.write_unsigned(event.size));
+            TRY(writer.write_unsigned(event.ptr));
+            TRY(writer.write_string(event.name));
+            break;
+        case PERF_EVENT_PROCESS_CREATE:
+            TRY(writer.write_signed(event.parent_pid));
+            TRY(writer.write_string(event.executable));
+            break;
+        case PERF_EVENT_PROCESS_EXEC:
+            TRY(writer.write_string(event.executable));
+            break;
+        case PERF_EVENT_THREAD_CREATE:
+            TRY(writer.write_signed(event.parent_tid));
+            break;
+        case PERF_EVENT_CONTEXT_SWITCH:
+            TRY(writer.write_signed(event.next_pid));
+            TRY(writer.write_unsigned(event.next_tid));
+            break;
+        case PERF_EVENT_SIGNPOST:
+            TRY(writer.write_unsigned(event.arg1));
+            TRY(writer.write_unsigned(event.arg2));
+            break;
+        case PERF_EVENT_FILESYSTEM: {
+            auto const& filesystem = event.filesystem;
+            TRY(stream.write_value(to_underlying(filesystem.type)));
+            TRY(writer.write_unsigned(filesystem.duration_ns));
+            switch (filesystem.type) {
+            case FilesystemEventType::Open:
+                TRY(writer.write_signed(filesystem.fd));
+                TRY(writer.write_unsigned(filesystem.filename_index));
+                TRY(writer.write_signed(filesystem.options));
+                TRY(writer.write_unsigned(filesystem.mode));
+                break;
+            case FilesystemEventType::Close:
+            case FilesystemEventType::Read:
+                TRY(writer.write_signed(filesystem.fd));
+                TRY(writer.write_unsigned(filesystem.filename_index));
+                break;
+            case FilesystemEventType::Preadv:
+                TRY(writer.write_signed(filesystem.fd));
+                TRY(writer.write_unsigned(filesystem.filename_index));
+                TRY(writer.write_signed(filesystem.offset));
+                break;
+            case FilesystemEventType::Pread:
+                TRY(writer.write_signed(filesystem.fd));
+                TRY(writer.write_unsigned(filesystem.filename_index));
+                TRY(writer.write_unsigned(filesystem.buffer_ptr));
+                TRY(writer.write_unsigned(filesystem.size));
+                TRY(writer.write_signed(filesystem.offset));
+                break;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return {};
+}
+
+}
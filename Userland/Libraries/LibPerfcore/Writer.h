@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <LibPerfcore/Reader.h>
+
+namespace Perfcore {
+
+// Writes all remaining events of the reader to the stream in the binary perfcore format.
+ErrorOr<void> write_binary(Reader&, Stream&);
+
+}
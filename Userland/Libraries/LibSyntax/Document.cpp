@@ -57,8 +57,8 @@ bool TextDocumentLine::can_select() const
 size_t TextDocumentLine::leading_spaces() const
 {
     size_t count = 0;
-    for (; count < m_text.size(); ++count) {
-        if (m_text[count] != ' ') {
+    for (; count < length(); ++count) {
+        if (code_points()[count] != ' ') {
             break;
         }
     }
@@ -67,6 +67,9 @@ size_t TextDocumentLine::leading_spaces() const
 
 ByteString TextDocumentLine::to_utf8() const
 {
+    if (!m_undecoded_text.is_null())
+        return ByteString { m_undecoded_text };
+
     StringBuilder builder;
     builder.append(view());
     return builder.to_byte_string();
@@ -84,37 +87,87 @@ TextDocumentLine::TextDocumentLine(Document& document, StringView text)
 
 void TextDocumentLine::clear(Document& document)
 {
+    m_undecoded_text = {};
     m_text.clear();
     document.update_views({});
 }
 
 void TextDocumentLine::set_text(Document& document, Vector<u32> const text)
 {
+    m_undecoded_text = {};
     m_text = move(text);
     document.update_views({});
 }
 
+// In valid UTF-8, every byte that isn't a continuation byte starts a code point.
+static size_t count_code_points(StringView text)
+{
+    size_t code_point_count = 0;
+    for (auto byte : text.bytes())
+        code_point_count += (byte & 0xc0) != 0x80;
+    return code_point_count;
+}
+
+static void decode_utf8(Vector<u32>& code_points, StringView text, size_t code_point_count)
+{
+    code_points.ensure_capacity(code_point_count);
+    if (code_point_count == text.length()) {
+        for (auto byte : text.bytes())
+            code_points.unchecked_append(byte);
+    } else {
+        for (auto code_point : Utf8View(text))
+            code_points.unchecked_append(code_point);
+    }
+}
+
 bool TextDocumentLine::set_text(Document& document, StringView text)
 {
     if (text.is_empty()) {
         clear(document);
         return true;
     }
+    m_undecoded_text = {};
     m_text.clear();
     Utf8View utf8_view(text);
     if (!utf8_view.validate()) {
         return false;
     }
-    for (auto code_point : utf8_view)
-        m_text.append(code_point);
+
+    decode_utf8(m_text, text, count_code_points(text));
+    document.update_views({});
+    return true;
+}
+
+bool TextDocumentLine::set_text_without_copying(Document& document, StringView text)
+{
+    if (text.is_empty()) {
+        clear(document);
+        return true;
+    }
+    m_undecoded_text = {};
+    m_text.clear();
+    if (!Utf8View(text).validate())
+        return false;
+
+    m_undecoded_text = text;
+    m_undecoded_length = count_code_points(text);
     document.update_views({});
     return true;
 }
 
+void TextDocumentLine::decode() const
+{
+    VERIFY(!m_undecoded_text.is_null());
+    VERIFY(m_text.is_empty());
+    decode_utf8(m_text, m_undecoded_text, m_undecoded_length);
+    m_undecoded_text = {};
+}
+
 void TextDocumentLine::append(Document& document, u32 const* code_points, size_t length)
 {
     if (length == 0)
         return;
+    ensure_decoded();
     m_text.append(code_points, length);
     document.update_views({});
 }
@@ -131,6 +184,7 @@ void TextDocumentLine::prepend(Document& document, u32 code_point)
 
 void TextDocumentLine::insert(Document& document, size_t index, u32 code_point)
 {
+    ensure_decoded();
     if (index == length()) {
         m_text.append(code_point);
     } else {
@@ -141,6 +195,7 @@ void TextDocumentLine::insert(Document& document, size_t index, u32 code_point)
 
 void TextDocumentLine::remove(Document& document, size_t index)
 {
+    ensure_decoded();
     if (index == length()) {
         m_text.take_last();
     } else {
@@ -151,6 +206,7 @@ void TextDocumentLine::remove(Document& document, size_t index)
 
 void TextDocumentLine::remove_range(Document& document, size_t start, size_t length)
 {
+    ensure_decoded();
     VERIFY(length <= m_text.size());
 
     Vector<u32> new_data;
@@ -165,6 +221,7 @@ void TextDocumentLine::remove_range(Document& document, size_t start, size_t len
 
 void TextDocumentLine::keep_range(Document& document, size_t start_index, size_t length)
 {
+    ensure_decoded();
     VERIFY(start_index + length < m_text.size());
 
     Vector<u32> new_data;
@@ -178,6 +235,7 @@ void TextDocumentLine::keep_range(Document& document, size_t start_index, size_t
 
 void TextDocumentLine::truncate(Document& document, size_t length)
 {
+    ensure_decoded();
     m_text.resize(length);
     document.update_views({});
 }
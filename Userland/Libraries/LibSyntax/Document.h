@@ -36,9 +36,19 @@ public:
     ByteString to_utf8() const;
 
     Utf32View view() const { return { code_points(), length() }; }
-    u32 const* code_points() const { return m_text.data(); }
-    size_t length() const { return m_text.size(); }
+    u32 const* code_points() const
+    {
+        ensure_decoded();
+        return m_text.data();
+    }
+    size_t length() const { return m_undecoded_text.is_null() ? m_text.size() : m_undecoded_length; }
     bool set_text(Document&, StringView);
+    // Like set_text(), but only keeps a view of the UTF-8 text, which has to outlive the line. The text is
+    // decoded into code points the first time they are needed, so lines that are never looked at or edited
+    // cost no more than the text itself.
+    bool set_text_without_copying(Document&, StringView);
+    // The UTF-8 text of a line that hasn't been decoded yet, a null view otherwise.
+    StringView undecoded_text() const { return m_undecoded_text; }
     void set_text(Document&, Vector<u32>);
     void append(Document&, u32);
     void prepend(Document&, u32);
@@ -58,8 +68,17 @@ public:
     size_t leading_spaces() const;
 
 private:
+    void ensure_decoded() const
+    {
+        if (!m_undecoded_text.is_null())
+            decode();
+    }
+    void decode() const;
+
     // NOTE: This vector is null terminated.
-    Vector<u32> m_text;
+    mutable Vector<u32> m_text;
+    mutable StringView m_undecoded_text;
+    size_t m_undecoded_length { 0 };
 };
 
 class Document : public RefCounted<Document> {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Optional.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ParallelFor.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+using ParallelPool = ThreadPool<Function<void()>>;
+
+static Atomic<size_t> s_worker_count { 0 };
+static Mutex s_pool_mutex;
+static ParallelPool* s_pool { nullptr };
+
+void set_parallel_worker_count(size_t count)
+{
+    s_worker_count.store(count);
+}
+
+size_t parallel_worker_count()
+{
+    return s_worker_count.load();
+}
+
+static ParallelPool& pool()
+{
+    MutexLocker locker(s_pool_mutex);
+    // The pool is intentionally leaked, its workers live as long as the process.
+    if (!s_pool)
+        s_pool = new ParallelPool([](Function<void()> work) { work(); }, s_worker_count.load());
+    return *s_pool;
+}
+
+class ParallelLoop : public AtomicRefCounted<ParallelLoop> {
+public:
+    ParallelLoop(size_t count, Function<ErrorOr<void>(size_t)> const& callback)
+        : m_count(count)
+        , m_callback(callback)
+    {
+    }
+
+    void run()
+    {
+        while (!m_has_failed.load(AK::MemoryOrder::memory_order_relaxed)) {
+            auto index = m_next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= m_count)
+                return;
+
+            if (auto result = m_callback(index); result.is_error()) {
+                MutexLocker locker(m_mutex);
+                if (!m_error.has_value())
+                    m_error = result.release_error();
+                m_has_failed.store(true);
+            }
+        }
+    }
+
+    void run_as_helper()
+    {
+        {
+            MutexLocker locker(m_mutex);
+            // The loop may have finished before this helper got to run, in which case m_callback is gone.
+            if (m_is_closed)
+                return;
+            ++m_running_helpers;
+        }
+
+        run();
+
+        MutexLocker locker(m_mutex);
+        --m_running_helpers;
+        m_helpers_done.signal();
+    }
+
+    ErrorOr<void> finish()
+    {
+        MutexLocker locker(m_mutex);
+        m_is_closed = true;
+        m_helpers_done.wait_while([this] { return m_running_helpers > 0; });
+
+        if (m_error.has_value())
+            return m_error.release_value();
+        return {};
+    }
+
+private:
+    size_t const m_count;
+    Function<ErrorOr<void>(size_t)> const& m_callback;
+
+    Atomic<size_t> m_next_index { 0 };
+    Atomic<bool> m_has_failed { false };
+
+    Mutex m_mutex;
+    ConditionVariable m_helpers_done { m_mutex };
+    size_t m_running_helpers { 0 };
+    bool m_is_closed { false };
+    Optional<Error> m_error;
+};
+
+ErrorOr<void> for_each_in_parallel(size_t count, Function<ErrorOr<void>(size_t)> const& callback)
+{
+    auto worker_count = min(parallel_worker_count(), count > 0 ? count - 1 : 0);
+    if (worker_count == 0) {
+        for (size_t i = 0; i < count; ++i)
+            TRY(callback(i));
+        return {};
+    }
+
+    auto loop = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) ParallelLoop(count, callback)));
+
+    // The calling thread works on the loop as well, so this can't deadlock when all workers are busy,
+    // even when called from one of the workers.
+    auto& thread_pool = pool();
+    for (size_t i = 0; i < worker_count; ++i)
+        thread_pool.submit([loop] { loop->run_as_helper(); });
+
+    loop->run();
+    return loop->finish();
+}
+
+}
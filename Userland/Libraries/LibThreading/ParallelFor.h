@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+
+namespace Threading {
+
+// Calls callback(i) for every i in [0, count), spreading the calls over the calling thread and the workers of a
+// process-wide thread pool. The calls may run concurrently and in any order. If a call fails, the remaining ones
+// are skipped and one of the errors is returned once all calls that were already started have finished.
+ErrorOr<void> for_each_in_parallel(size_t count, Function<ErrorOr<void>(size_t)> const& callback);
+
+// Starting threads requires the "thread" pledge, so worker threads are only used once a process opts in by calling
+// this. Until then, for_each_in_parallel() makes all the calls on the calling thread.
+// The pool is created with the worker count that is set the first time it is needed.
+void set_parallel_worker_count(size_t);
+size_t parallel_worker_count();
+
+}
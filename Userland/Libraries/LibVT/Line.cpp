@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <LibVT/Line.h>
 
 namespace VT {
@@ -20,6 +21,17 @@ void Line::rewrap(size_t new_length, Line* next_line, CursorPosition* cursor, bo
     if (old_length == new_length)
         return;
 
+    // A line that ends in a line break and still fits neither takes cells from the next line nor pushes any
+    // into it, so there's no need to expand it (or the next line). Most lines in the scrollback are like that.
+    if (m_terminated_at.has_value() && m_terminated_at.value() <= new_length) {
+        set_length(m_terminated_at.value());
+        return set_length(new_length);
+    }
+
+    expand();
+    if (next_line)
+        next_line->expand();
+
     // Drop the empty cells
     if (m_terminated_at.has_value() && m_cells.size() > m_terminated_at.value())
         m_cells.remove(m_terminated_at.value(), m_cells.size() - m_terminated_at.value());
@@ -35,7 +47,10 @@ void Line::rewrap(size_t new_length, Line* next_line, CursorPosition* cursor, bo
 
 void Line::set_length(size_t new_length)
 {
-    m_cells.try_resize(new_length).release_value_but_fixme_should_propagate_errors();
+    if (m_is_compact)
+        compact_set_length(new_length);
+    else
+        m_cells.try_resize(new_length).release_value_but_fixme_should_propagate_errors();
     if (m_terminated_at.has_value())
         m_terminated_at = min(*m_terminated_at, new_length);
 }
@@ -119,6 +134,7 @@ void Line::take_cells_from_next_line(size_t new_length, Line* next_line, bool cu
 
 void Line::clear_range(size_t first_column, size_t last_column, Attribute const& attribute)
 {
+    expand();
     VERIFY(first_column <= last_column);
     VERIFY(last_column < m_cells.size());
     for (size_t i = first_column; i <= last_column; ++i) {
@@ -133,6 +149,10 @@ bool Line::has_only_one_background_color() const
 {
     if (!length())
         return true;
+    if (m_is_compact) {
+        auto color = m_compact_attribute_runs.first().attribute.effective_background_color();
+        return all_of(m_compact_attribute_runs, [&](auto& run) { return run.attribute.effective_background_color() == color; });
+    }
     // FIXME: Cache this result?
     auto color = attribute_at(0).effective_background_color();
     for (size_t i = 1; i < length(); ++i) {
@@ -142,4 +162,106 @@ bool Line::has_only_one_background_color() const
     return true;
 }
 
+// Attribute::operator== ignores hyperlinks, but a compact line has to keep them.
+static bool is_same_attribute(Attribute const& a, Attribute const& b)
+{
+#ifndef KERNEL
+    if (a.href != b.href || a.href_id != b.href_id)
+        return false;
+#endif
+    return a == b;
+}
+
+void Line::compact()
+{
+    if (m_is_compact)
+        return;
+
+    // Blank cells at the end that look like the last cell are covered by the last attribute run.
+    size_t stored_code_point_count = m_cells.size();
+    while (stored_code_point_count > 0) {
+        auto const& cell = m_cells[stored_code_point_count - 1];
+        if (cell.code_point != ' ' || !is_same_attribute(cell.attribute, m_cells.last().attribute))
+            break;
+        --stored_code_point_count;
+    }
+
+    size_t run_count = 0;
+    for (size_t i = 0; i < m_cells.size(); ++i) {
+        if (i == 0 || !is_same_attribute(m_cells[i].attribute, m_cells[i - 1].attribute))
+            ++run_count;
+    }
+
+    m_compact_code_points.ensure_capacity(stored_code_point_count);
+    for (size_t i = 0; i < stored_code_point_count; ++i)
+        m_compact_code_points.unchecked_append(m_cells[i].code_point);
+
+    m_compact_attribute_runs.ensure_capacity(run_count);
+    for (size_t i = 0; i < m_cells.size(); ++i) {
+        if (i == 0 || !is_same_attribute(m_cells[i].attribute, m_compact_attribute_runs.last().attribute))
+            m_compact_attribute_runs.unchecked_append({ i, move(m_cells[i].attribute) });
+    }
+
+    m_compact_length = m_cells.size();
+    m_cells.clear();
+    m_is_compact = true;
+}
+
+void Line::expand()
+{
+    if (!m_is_compact)
+        return;
+
+    m_cells.ensure_capacity(m_compact_length);
+    for (size_t run_index = 0; run_index < m_compact_attribute_runs.size(); ++run_index) {
+        auto const& run = m_compact_attribute_runs[run_index];
+        auto end_column = run_index + 1 < m_compact_attribute_runs.size() ? m_compact_attribute_runs[run_index + 1].start_column : m_compact_length;
+        for (size_t column = run.start_column; column < end_column; ++column)
+            m_cells.unchecked_append({ code_point(column), run.attribute });
+    }
+
+    m_compact_length = 0;
+    m_compact_code_points.clear();
+    m_compact_attribute_runs.clear();
+    m_is_compact = false;
+}
+
+Attribute const& Line::compact_attribute_at(size_t index) const
+{
+    VERIFY(index < m_compact_length);
+
+    // Find the last run that starts at or before the index.
+    size_t low = 0;
+    size_t high = m_compact_attribute_runs.size();
+    while (high - low > 1) {
+        auto middle = low + (high - low) / 2;
+        if (m_compact_attribute_runs[middle].start_column <= index)
+            low = middle;
+        else
+            high = middle;
+    }
+    return m_compact_attribute_runs[low].attribute;
+}
+
+void Line::compact_set_length(size_t new_length)
+{
+    if (new_length < m_compact_length) {
+        if (m_compact_code_points.size() > new_length)
+            m_compact_code_points.shrink(new_length);
+        while (!m_compact_attribute_runs.is_empty() && m_compact_attribute_runs.last().start_column >= new_length)
+            m_compact_attribute_runs.take_last();
+    } else if (new_length > m_compact_length) {
+        // New cells are blank, which code_point() already returns past the stored code points.
+        if (m_compact_attribute_runs.is_empty() || !is_same_attribute(m_compact_attribute_runs.last().attribute, Attribute()))
+            m_compact_attribute_runs.append({ m_compact_length, Attribute() });
+    }
+    m_compact_length = new_length;
+}
+
+bool Line::compact_is_empty() const
+{
+    return all_of(m_compact_code_points, [](auto code_point) { return code_point == ' '; })
+        && all_of(m_compact_attribute_runs, [](auto& run) { return run.attribute == Attribute(); });
+}
+
 }
@@ -36,14 +36,28 @@ public:
         bool operator!=(Cell const& other) const { return code_point != other.code_point || attribute != other.attribute; }
     };
 
-    Attribute const& attribute_at(size_t index) const { return m_cells[index].attribute; }
-    Attribute& attribute_at(size_t index) { return m_cells[index].attribute; }
+    Attribute const& attribute_at(size_t index) const
+    {
+        if (m_is_compact)
+            return compact_attribute_at(index);
+        return m_cells[index].attribute;
+    }
+    Attribute& attribute_at(size_t index)
+    {
+        expand();
+        return m_cells[index].attribute;
+    }
 
-    Cell& cell_at(size_t index) { return m_cells[index]; }
-    Cell const& cell_at(size_t index) const { return m_cells[index]; }
+    Cell& cell_at(size_t index)
+    {
+        expand();
+        return m_cells[index];
+    }
+    Cell cell_at(size_t index) const { return { code_point(index), attribute_at(index) }; }
 
     void clear(Attribute const& attribute = Attribute())
     {
+        expand();
         m_terminated_at.clear();
         m_mark = Unmarked;
         clear_range(0, m_cells.size() - 1, attribute);
@@ -53,23 +67,28 @@ public:
 
     bool is_empty() const
     {
+        if (m_is_compact)
+            return compact_is_empty();
         return !any_of(m_cells, [](auto& cell) { return cell != Cell(); });
     }
 
     size_t length() const
     {
-        return m_cells.size();
+        return m_is_compact ? m_compact_length : m_cells.size();
     }
     void set_length(size_t);
     void rewrap(size_t new_length, Line* next_line, CursorPosition* cursor, bool cursor_is_on_next_line = true);
 
     u32 code_point(size_t index) const
     {
+        if (m_is_compact)
+            return index < m_compact_code_points.size() ? m_compact_code_points[index] : ' ';
         return m_cells[index].code_point;
     }
 
     void set_code_point(size_t index, u32 code_point)
     {
+        expand();
         if (m_terminated_at.has_value()) {
             if (index > *m_terminated_at) {
                 m_terminated_at = index + 1;
@@ -95,15 +114,36 @@ public:
     Optional<u16> termination_column() const { return m_terminated_at; }
     void set_terminated(u16 column) { m_terminated_at = column; }
 
+    // Lines in the scrollback are rarely modified, so they are stored compactly: trailing blank cells
+    // are dropped, and attributes are only stored once for every run of cells that share them.
+    // Anything that modifies the cells turns the line back into a regular one.
+    bool is_compact() const { return m_is_compact; }
+    void compact();
+
 private:
+    struct AttributeRun {
+        size_t start_column { 0 };
+        Attribute attribute;
+    };
+
+    void expand();
+    Attribute const& compact_attribute_at(size_t index) const;
+    void compact_set_length(size_t);
+    bool compact_is_empty() const;
     void take_cells_from_next_line(size_t new_length, Line* next_line, bool cursor_is_on_next_line, CursorPosition* cursor);
     void push_cells_into_next_line(size_t new_length, Line* next_line, bool cursor_is_on_next_line, CursorPosition* cursor);
 
     Vector<Cell> m_cells;
     Mark m_mark { Unmarked };
     bool m_dirty { false };
+    bool m_is_compact { false };
     // Note: The alignment is 8, so this member lives in the padding (that already existed before it was introduced)
     [[no_unique_address]] Optional<u16> m_terminated_at;
+
+    // Only used while the line is compact, m_cells is empty then.
+    size_t m_compact_length { 0 };
+    Vector<u32> m_compact_code_points;
+    Vector<AttributeRun> m_compact_attribute_runs;
 };
 
 }
@@ -1735,6 +1735,10 @@ void Terminal::set_size(u16 columns, u16 rows)
 
     cursor_tracker.row -= m_history.size();
 
+    // Rewrapping only expands the lines whose cells actually moved, and those that were on the screen before.
+    for (auto& line : m_history)
+        line->compact();
+
     if (m_history.size() != old_history_size) {
         m_client.terminal_history_changed(-old_history_size);
         m_client.terminal_history_changed(m_history.size());
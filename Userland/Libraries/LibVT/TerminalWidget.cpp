@@ -310,7 +310,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     Vector<Gfx::IntRect> hovered_href_rects;
     if (m_hovered_href_id.has_value()) {
         for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
-            auto& line = m_terminal.line(first_row_from_history + visual_row);
+            auto const& line = m_terminal.line(first_row_from_history + visual_row);
             for (size_t column = 0; column < line.length(); ++column) {
                 if (m_hovered_href_id == line.attribute_at(column).href_id) {
                     bool merged_with_existing_rect = false;
@@ -334,7 +334,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         auto row_rect = this->row_rect(visual_row);
         if (!event.rect().contains(row_rect))
             continue;
-        auto& line = m_terminal.line(first_row_from_history + visual_row);
+        auto const& line = m_terminal.line(first_row_from_history + visual_row);
         bool has_only_one_background_color = line.has_only_one_background_color();
         if (visual_beep_active)
             painter.clear_rect(row_rect, terminal_color_to_rgb(VT::Color::named(VT::Color::ANSIColor::Red)));
@@ -413,7 +413,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         auto row_rect = this->row_rect(visual_row);
         if (!event.rect().contains(row_rect))
             continue;
-        auto& line = m_terminal.line(first_row_from_history + visual_row);
+        auto const& line = m_terminal.line(first_row_from_history + visual_row);
         for (size_t column = 0; column < line.length(); ++column) {
             auto attribute = line.attribute_at(column);
             bool should_reverse_fill_for_cursor_or_selection = m_cursor_blink_state
@@ -449,7 +449,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
 
     // Draw cursor.
     if (m_cursor_blink_state && row_with_cursor < m_terminal.rows()) {
-        auto& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
+        auto const& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
         if (m_terminal.cursor_row() >= (m_terminal.rows() - rows_from_history))
             return;
 
@@ -629,7 +629,7 @@ VT::Position TerminalWidget::buffer_position_at(Gfx::IntPoint position) const
         column = 0;
     if (row >= m_terminal.rows())
         row = m_terminal.rows() - 1;
-    auto& line = m_terminal.line(row);
+    auto const& line = m_terminal.line(row);
     if (column >= (int)line.length())
         column = line.length() - 1;
     row += m_scrollbar->value();
@@ -640,7 +640,7 @@ u32 TerminalWidget::code_point_at(const VT::Position& position) const
 {
     VERIFY(position.is_valid());
     VERIFY(position.row() >= 0 && static_cast<size_t>(position.row()) < m_terminal.line_count());
-    auto& line = m_terminal.line(position.row());
+    auto const& line = m_terminal.line(position.row());
     if (static_cast<size_t>(position.column()) == line.length())
         return '\n';
     return line.code_point(position.column());
@@ -650,7 +650,7 @@ VT::Position TerminalWidget::next_position_after(const VT::Position& position, b
 {
     VERIFY(position.is_valid());
     VERIFY(position.row() >= 0 && static_cast<size_t>(position.row()) < m_terminal.line_count());
-    auto& line = m_terminal.line(position.row());
+    auto const& line = m_terminal.line(position.row());
     if (static_cast<size_t>(position.column()) == line.length()) {
         if (static_cast<size_t>(position.row()) == m_terminal.line_count() - 1) {
             if (should_wrap)
@@ -668,12 +668,12 @@ VT::Position TerminalWidget::previous_position_before(const VT::Position& positi
     if (position.column() == 0) {
         if (position.row() == 0) {
             if (should_wrap) {
-                auto& last_line = m_terminal.line(m_terminal.line_count() - 1);
+                auto const& last_line = m_terminal.line(m_terminal.line_count() - 1);
                 return { static_cast<int>(m_terminal.line_count() - 1), static_cast<int>(last_line.length()) };
             }
             return {};
         }
-        auto& prev_line = m_terminal.line(position.row() - 1);
+        auto const& prev_line = m_terminal.line(position.row() - 1);
         return { position.row() - 1, static_cast<int>(prev_line.length()) };
     }
     return { position.row(), position.column() - 1 };
@@ -788,7 +788,7 @@ void TerminalWidget::doubleclick_event(GUI::MouseEvent& event)
         m_triple_click_timer.start();
 
         auto position = buffer_position_at(event.position());
-        auto& line = m_terminal.line(position.row());
+        auto const& line = m_terminal.line(position.row());
         bool want_whitespace = line.code_point(position.column()) == ' ';
 
         int start_column = 0;
@@ -1019,7 +1019,7 @@ ByteString TerminalWidget::selected_text() const
         int first_column = first_selection_column_on_row(row);
         int last_column = last_selection_column_on_row(row);
         for (int column = first_column; column <= last_column; ++column) {
-            auto& line = m_terminal.line(row);
+            auto const& line = m_terminal.line(row);
             if (line.attribute_at(column).is_untouched()) {
                 builder.append('\n');
                 break;
@@ -6,6 +6,7 @@
  */
 
 #include <LibGfx/Bitmap.h>
+#include <LibMedia/VideoFrame.h>
 #include <LibWeb/Bindings/HTMLVideoElementPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Document.h>
@@ -110,13 +111,42 @@ void HTMLVideoElement::set_video_track(JS::GCPtr<HTML::VideoTrack> video_track)
     m_video_track = video_track;
 }
 
-void HTMLVideoElement::set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::Bitmap> frame, double position)
+void HTMLVideoElement::set_current_frame(Badge<VideoTrack>, RefPtr<Media::VideoFrame> frame, double position)
 {
     m_current_frame = { move(frame), position };
+    m_current_frame_bitmap = nullptr;
     if (paintable())
         paintable()->set_needs_display();
 }
 
+RefPtr<Gfx::Bitmap> HTMLVideoElement::current_frame_bitmap(Gfx::IntSize size) const
+{
+    if (!m_current_frame.frame || size.is_empty())
+        return nullptr;
+    if (m_current_frame_bitmap && m_current_frame_bitmap->size() == size)
+        return m_current_frame_bitmap;
+
+    auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size);
+    if (bitmap_or_error.is_error())
+        return nullptr;
+    auto bitmap = bitmap_or_error.release_value();
+
+    if (auto result = m_current_frame.frame->output_to_bitmap(*bitmap, bitmap->rect(), bitmap->rect()); result.is_error()) {
+        dbgln("Failed to convert video frame: {}", result.error().description());
+        return nullptr;
+    }
+
+    m_current_frame_bitmap = move(bitmap);
+    return m_current_frame_bitmap;
+}
+
+RefPtr<Gfx::Bitmap> HTMLVideoElement::bitmap() const
+{
+    if (!m_current_frame.frame)
+        return nullptr;
+    return current_frame_bitmap(m_current_frame.frame->size().to_type<int>());
+}
+
 void HTMLVideoElement::on_playing()
 {
     if (m_video_track)
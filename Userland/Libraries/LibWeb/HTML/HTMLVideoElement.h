@@ -8,6 +8,7 @@
 
 #include <AK/Optional.h>
 #include <LibGfx/Forward.h>
+#include <LibMedia/Forward.h>
 #include <LibWeb/DOM/DocumentLoadEventDelayer.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/HTML/HTMLMediaElement.h>
@@ -16,7 +17,7 @@
 namespace Web::HTML {
 
 struct VideoFrame {
-    RefPtr<Gfx::Bitmap> frame;
+    RefPtr<Media::VideoFrame> frame;
     double position { 0.0 };
 };
 
@@ -38,15 +39,16 @@ public:
 
     void set_video_track(JS::GCPtr<VideoTrack>);
 
-    void set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::Bitmap> frame, double position);
+    void set_current_frame(Badge<VideoTrack>, RefPtr<Media::VideoFrame> frame, double position);
     VideoFrame const& current_frame() const { return m_current_frame; }
     RefPtr<Gfx::Bitmap> const& poster_frame() const { return m_poster_frame; }
 
+    // Returns the current frame converted to RGB and scaled to the given size. The frame is only converted when this
+    // is called, and the result is kept until the frame or the requested size change.
+    RefPtr<Gfx::Bitmap> current_frame_bitmap(Gfx::IntSize) const;
+
     // FIXME: This is a hack for images used as CanvasImageSource. Do something more elegant.
-    RefPtr<Gfx::Bitmap> bitmap() const
-    {
-        return current_frame().frame;
-    }
+    RefPtr<Gfx::Bitmap> bitmap() const;
 
 private:
     HTMLVideoElement(DOM::Document&, DOM::QualifiedName);
@@ -70,6 +72,7 @@ private:
 
     JS::GCPtr<HTML::VideoTrack> m_video_track;
     VideoFrame m_current_frame;
+    mutable RefPtr<Gfx::Bitmap> m_current_frame_bitmap;
     RefPtr<Gfx::Bitmap> m_poster_frame;
 
     u32 m_video_width { 0 };
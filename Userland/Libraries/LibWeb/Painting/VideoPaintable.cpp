@@ -6,6 +6,7 @@
 
 #include <AK/Array.h>
 #include <LibGfx/AntiAliasingPainter.h>
+#include <LibMedia/VideoFrame.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/HTMLMediaElement.h>
 #include <LibWeb/HTML/HTMLVideoElement.h>
@@ -133,6 +134,24 @@ void VideoPaintable::paint(PaintContext& context, PaintPhase phase) const
         context.display_list_recorder().draw_scaled_bitmap(video_rect.to_type<int>(), *frame, frame->rect(), scaling_mode);
     };
 
+    auto paint_video_frame = [&]() {
+        // Video frames are converted and smoothly scaled to the size they are displayed at in one go. For the other
+        // rendering modes, the full size frame is scaled when painting instead.
+        auto bitmap_size = current_frame.frame->size().to_type<int>();
+        switch (computed_values().image_rendering()) {
+        case CSS::ImageRendering::Auto:
+        case CSS::ImageRendering::HighQuality:
+        case CSS::ImageRendering::Smooth:
+            bitmap_size = video_rect.size().to_type<int>();
+            break;
+        default:
+            break;
+        }
+
+        if (auto bitmap = video_element.current_frame_bitmap(bitmap_size))
+            paint_frame(bitmap);
+    };
+
     auto paint_transparent_black = [&]() {
         static constexpr auto transparent_black = Gfx::Color::from_argb(0x00'00'00'00);
         context.display_list_recorder().fill_rect(video_rect.to_type<int>(), transparent_black);
@@ -155,7 +174,7 @@ void VideoPaintable::paint(PaintContext& context, PaintPhase phase) const
         // FIXME: We likely need to cache all (or a subset of) decoded video frames along with their position. We at least
         //        will need the first video frame and the last-rendered video frame.
         if (current_frame.frame)
-            paint_frame(current_frame.frame);
+            paint_video_frame();
         if (paint_user_agent_controls)
             paint_loaded_video_controls();
         break;
@@ -25,7 +25,7 @@ bool ClientAudioStream::is_connected() const
     return m_client && m_client->is_open();
 }
 
-ErrorOr<Audio::Sample, ClientAudioStream::ErrorState> ClientAudioStream::get_next_sample(u32 audiodevice_sample_rate)
+ErrorOr<size_t, ClientAudioStream::ErrorState> ClientAudioStream::read_samples(Span<Audio::Sample> buffer, u32 audiodevice_sample_rate)
 {
     // Note: Even though we only check client state here, we will probably close the client much earlier.
     if (!is_connected())
@@ -34,30 +34,50 @@ ErrorOr<Audio::Sample, ClientAudioStream::ErrorState> ClientAudioStream::get_nex
     if (m_paused)
         return ErrorState::ClientUnderrun;
 
-    if (m_in_chunk_location >= m_current_audio_chunk.size()) {
-        auto result = m_buffer->dequeue();
-        if (result.is_error()) {
-            if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
-                dbgln_if(AUDIO_DEBUG, "Audio client {} can't keep up!", m_client->client_id());
+    size_t samples_written = 0;
+    while (samples_written < buffer.size()) {
+        if (m_in_chunk_location >= m_current_audio_chunk.size()) {
+            auto result = m_buffer->dequeue();
+            if (result.is_error()) {
+                if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
+                    dbgln_if(AUDIO_DEBUG, "Audio client {} can't keep up!", m_client->client_id());
+                }
+
+                if (samples_written == 0)
+                    return ErrorState::ClientUnderrun;
+                break;
             }
-
-            return ErrorState::ClientUnderrun;
+            auto chunk = result.release_value();
+            u32 sample_rate = m_sample_rate;
+            if (sample_rate == 0)
+                sample_rate = audiodevice_sample_rate;
+
+            // The chunk's storage is reused, so that this doesn't allocate once playback is running.
+            m_current_audio_chunk.clear_with_capacity();
+            if (sample_rate == audiodevice_sample_rate) {
+                if (m_current_audio_chunk.try_append(chunk.data(), chunk.size()).is_error())
+                    return ErrorState::ResamplingError;
+            } else {
+                // The resampler carries its state over between chunks, so it is only recreated if either sample rate changes.
+                if (!m_resampler.has_value() || m_resampler->source() != sample_rate || m_resampler->target() != audiodevice_sample_rate) {
+                    auto resampler_or_error = Audio::SincResampler::create(sample_rate, audiodevice_sample_rate);
+                    if (resampler_or_error.is_error())
+                        return ErrorState::ResamplingError;
+                    m_resampler = resampler_or_error.release_value();
+                }
+                if (m_resampler->try_resample_into_end(m_current_audio_chunk, chunk.span()).is_error())
+                    return ErrorState::ResamplingError;
+            }
+            m_in_chunk_location = 0;
         }
-        // FIXME: Our resampler and the way we resample here are bad.
-        //        Ideally, we should both do perfect band-corrected resampling,
-        //        as well as carry resampling state over between buffers.
-        auto maybe_resampled = Audio::ResampleHelper<Audio::Sample> { m_sample_rate == 0 ? audiodevice_sample_rate : m_sample_rate, audiodevice_sample_rate }
-                                   .try_resample(result.release_value());
-        if (maybe_resampled.is_error())
-            return ErrorState::ResamplingError;
-
-        // If the sample rate changes underneath us, we will still play the existing buffer unchanged until we're done.
-        // This is not a significant problem since the buffers are very small (~100 samples or less).
-        m_current_audio_chunk = maybe_resampled.release_value();
-        m_in_chunk_location = 0;
+
+        auto samples_to_copy = min(buffer.size() - samples_written, m_current_audio_chunk.size() - m_in_chunk_location);
+        m_current_audio_chunk.span().slice(m_in_chunk_location, samples_to_copy).copy_to(buffer.slice(samples_written));
+        m_in_chunk_location += samples_to_copy;
+        samples_written += samples_to_copy;
     }
 
-    return m_current_audio_chunk[m_in_chunk_location++];
+    return samples_written;
 }
 
 void ClientAudioStream::set_buffer(NonnullOwnPtr<Audio::AudioQueue> buffer)
@@ -78,9 +98,12 @@ void ClientAudioStream::set_paused(bool paused)
     m_paused = paused;
 }
 
-FadingProperty<double>& ClientAudioStream::volume()
+FadingProperty<double>& ClientAudioStream::mixing_volume()
 {
-    return m_volume;
+    double volume = m_volume;
+    if (m_mixing_volume.target() != volume)
+        m_mixing_volume = volume;
+    return m_mixing_volume;
 }
 
 double ClientAudioStream::volume() const
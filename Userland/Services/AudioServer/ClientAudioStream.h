@@ -14,6 +14,7 @@
 #include <AK/RefCounted.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Queue.h>
+#include <LibAudio/Resampler.h>
 
 namespace AudioServer {
 
@@ -29,7 +30,9 @@ public:
     explicit ClientAudioStream(ConnectionFromClient&);
     ~ClientAudioStream() = default;
 
-    ErrorOr<Audio::Sample, ErrorState> get_next_sample(u32 audiodevice_sample_rate);
+    // Fills as much of the buffer as the client has provided samples for, and returns how many samples were written.
+    // This is called on the mixer thread and never blocks.
+    ErrorOr<size_t, ErrorState> read_samples(Span<Audio::Sample> buffer, u32 audiodevice_sample_rate);
     void clear();
 
     bool is_connected() const;
@@ -39,7 +42,8 @@ public:
     void set_buffer(NonnullOwnPtr<Audio::AudioQueue> buffer);
 
     void set_paused(bool paused);
-    FadingProperty<double>& volume();
+    // The volume as seen by the mixer thread, which fades towards the volume last set by the client.
+    FadingProperty<double>& mixing_volume();
     double volume() const;
     void set_volume(double volume);
     bool is_muted() const;
@@ -50,14 +54,17 @@ public:
 private:
     OwnPtr<Audio::AudioQueue> m_buffer;
     Vector<Audio::Sample> m_current_audio_chunk;
-    size_t m_in_chunk_location;
+    size_t m_in_chunk_location { 0 };
+    Optional<Audio::SincResampler> m_resampler;
 
-    bool m_paused { true };
-    bool m_muted { false };
-    u32 m_sample_rate;
+    // These are set from the client's IPC handlers while the mixer thread reads them.
+    Atomic<bool> m_paused { true };
+    Atomic<bool> m_muted { false };
+    Atomic<u32> m_sample_rate { 0 };
+    Atomic<double> m_volume { 1 };
 
     WeakPtr<ConnectionFromClient> m_client;
-    FadingProperty<double> m_volume { 1 };
+    FadingProperty<double> m_mixing_volume { 1 };
 };
 
 }
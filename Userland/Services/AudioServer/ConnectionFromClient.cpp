@@ -72,7 +72,7 @@ void ConnectionFromClient::set_self_sample_rate(u32 sample_rate)
 
 Messages::AudioServer::GetSelfVolumeResponse ConnectionFromClient::get_self_volume()
 {
-    return m_queue->volume().target();
+    return m_queue->volume();
 }
 
 void ConnectionFromClient::set_self_volume(double volume)
@@ -61,6 +61,16 @@ void ConnectionFromManagerClient::set_device_sample_rate(u32 sample_rate)
     m_mixer.audiodevice_set_sample_rate(sample_rate);
 }
 
+Messages::AudioManagerServer::GetDevicePeriodSizeResponse ConnectionFromManagerClient::get_device_period_size()
+{
+    return { static_cast<u32>(m_mixer.period_size()) };
+}
+
+void ConnectionFromManagerClient::set_device_period_size(u32 period_size)
+{
+    m_mixer.set_period_size(period_size);
+}
+
 Messages::AudioManagerServer::IsMainMixMutedResponse ConnectionFromManagerClient::is_main_mix_muted()
 {
     return m_mixer.is_muted();
@@ -36,6 +36,8 @@ private:
     virtual void set_main_mix_muted(bool) override;
     virtual void set_device_sample_rate(u32 sample_rate) override;
     virtual Messages::AudioManagerServer::GetDeviceSampleRateResponse get_device_sample_rate() override;
+    virtual void set_device_period_size(u32 period_size) override;
+    virtual Messages::AudioManagerServer::GetDevicePeriodSizeResponse get_device_period_size() override;
 
     Mixer& m_mixer;
 };
@@ -8,9 +8,8 @@
 
 namespace AudioServer {
 
-// This is in buffer counts.
-// As each buffer is approx 1/40 of a second, this means about 1/4 of a second of fade time.
-constexpr int DEFAULT_FADE_TIME = 10;
+// This is in milliseconds, so that fades take the same time regardless of the mixer's period size.
+constexpr double DEFAULT_FADE_TIME = 250;
 
 // A property of an audio system that needs to fade briefly whenever changed.
 template<typename T>
@@ -20,7 +19,7 @@ public:
         : FadingProperty(value, DEFAULT_FADE_TIME)
     {
     }
-    FadingProperty(T const value, int const fade_time)
+    FadingProperty(T const value, double const fade_time)
         : m_old_value(value)
         , m_new_value(move(value))
         , m_fade_time(fade_time)
@@ -49,9 +48,9 @@ public:
         return m_old_value * (1 - m_current_fade) + m_new_value * (m_current_fade);
     }
 
-    void advance_time()
+    void advance_time(double const elapsed_time)
     {
-        m_current_fade += 1.0 / static_cast<double>(m_fade_time);
+        m_current_fade += elapsed_time / m_fade_time;
         m_current_fade = clamp(m_current_fade, 0.0, 1.0);
     }
 
@@ -66,7 +65,7 @@ private:
     T m_old_value {};
     T m_new_value {};
     double m_current_fade { 0 };
-    int const m_fade_time;
+    double const m_fade_time;
 };
 
 }
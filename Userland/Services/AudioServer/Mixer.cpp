@@ -6,10 +6,12 @@
  */
 
 #include "Mixer.h"
-#include <AK/Array.h>
+#include <AK/Endian.h>
 #include <AK/Format.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AudioServer/ConnectionFromClient.h>
 #include <AudioServer/ConnectionFromManagerClient.h>
 #include <AudioServer/Mixer.h>
@@ -20,6 +22,73 @@
 
 namespace AudioServer {
 
+using AK::SIMD::expand4;
+using AK::SIMD::f32x4;
+using AK::SIMD::i16x4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::simd_cast;
+using AK::SIMD::store_unaligned;
+
+// The mixing kernels treat sample buffers as interleaved left/right floats, so that each vector holds two samples.
+static_assert(sizeof(Audio::Sample) == 2 * sizeof(float));
+// The device expects little-endian samples, which we write without swapping.
+static_assert(AK::HostIsLittleEndian);
+
+// This is the same curve as Audio::Sample::log_multiply() uses.
+static float logarithmic_gain(double volume)
+{
+    return Audio::VOLUME_A * AK::exp(Audio::VOLUME_B * static_cast<float>(volume));
+}
+
+// Adds the source samples to the mix, while the gain ramps linearly from start_gain to end_gain over the whole mix buffer.
+// Ramping per sample instead of per period avoids audible steps (zipper noise) when a volume fades.
+static void mix_with_gain_ramp(Span<Audio::Sample> mix, ReadonlySpan<Audio::Sample> source, float start_gain, float end_gain)
+{
+    VERIFY(source.size() <= mix.size());
+    float const gain_step = (end_gain - start_gain) / static_cast<float>(mix.size());
+
+    auto* mix_data = reinterpret_cast<float*>(mix.data());
+    auto const* source_data = reinterpret_cast<float const*>(source.data());
+    f32x4 gain { start_gain, start_gain, start_gain + gain_step, start_gain + gain_step };
+    f32x4 const gain_increment = expand4(2 * gain_step);
+
+    size_t i = 0;
+    for (; i + 2 <= source.size(); i += 2) {
+        auto mixed = load_unaligned<f32x4>(mix_data + i * 2);
+        auto sample = load_unaligned<f32x4>(source_data + i * 2);
+        store_unaligned(mix_data + i * 2, mixed + sample * gain);
+        gain += gain_increment;
+    }
+    for (; i < source.size(); ++i)
+        mix[i] += source[i] * (start_gain + gain_step * static_cast<float>(i));
+}
+
+// Applies the main volume ramp to the mix, clips it and converts it to the device's interleaved 16-bit format.
+static void convert_to_device_samples(ReadonlySpan<Audio::Sample> mix, Span<i16> output, float start_gain, float end_gain)
+{
+    VERIFY(output.size() == mix.size() * 2);
+    float const gain_step = (end_gain - start_gain) / static_cast<float>(mix.size());
+    constexpr float scale = NumericLimits<i16>::max();
+
+    auto const* mix_data = reinterpret_cast<float const*>(mix.data());
+    f32x4 gain { start_gain, start_gain, start_gain + gain_step, start_gain + gain_step };
+    f32x4 const gain_increment = expand4(2 * gain_step);
+
+    size_t i = 0;
+    for (; i + 2 <= mix.size(); i += 2) {
+        auto sample = load_unaligned<f32x4>(mix_data + i * 2) * gain;
+        sample = AK::SIMD::clamp(sample, expand4(-1.f), expand4(1.f)) * scale;
+        store_unaligned(output.data() + i * 2, simd_cast<i16x4>(sample));
+        gain += gain_increment;
+    }
+    for (; i < mix.size(); ++i) {
+        auto sample = mix[i] * (start_gain + gain_step * static_cast<float>(i));
+        sample.clip();
+        output[i * 2] = static_cast<i16>(sample.left * scale);
+        output[i * 2 + 1] = static_cast<i16>(sample.right * scale);
+    }
+}
+
 Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config, OwnPtr<Core::File> device)
     : m_device(move(device))
     , m_sound_thread(Threading::Thread::construct(
@@ -32,6 +101,9 @@ Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config, OwnPtr<Core::File> device)
 {
     m_muted = m_config->read_bool_entry("Master", "Mute", false);
     m_main_volume = static_cast<double>(m_config->read_num_entry("Master", "Volume", 100)) / 100.0;
+    m_requested_main_volume = m_main_volume.target();
+    auto period_size = m_config->read_num_entry("Master", "PeriodSize", static_cast<i32>(DEFAULT_PERIOD_SIZE));
+    m_period_size = clamp(static_cast<size_t>(max(period_size, 0)), MINIMUM_PERIOD_SIZE, MAXIMUM_PERIOD_SIZE);
 
     m_sound_thread->start();
 }
@@ -43,6 +115,7 @@ NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& clien
     {
         Threading::MutexLocker const locker(m_pending_mutex);
         m_pending_mixing.append(*queue);
+        m_has_pending_mixing = true;
     }
     // Signal the mixer thread to start back up, in case nobody was connected before.
     m_mixing_necessary.signal();
@@ -55,7 +128,7 @@ void Mixer::mix()
     decltype(m_pending_mixing) active_mix_queues;
 
     for (;;) {
-        {
+        if (m_has_pending_mixing || active_mix_queues.is_empty()) {
             Threading::MutexLocker const locker(m_pending_mutex);
             // While we have nothing to mix, wait on the condition.
             m_mixing_necessary.wait_while([this, &active_mix_queues]() { return m_pending_mixing.is_empty() && active_mix_queues.is_empty(); });
@@ -63,13 +136,28 @@ void Mixer::mix()
                 active_mix_queues.extend(move(m_pending_mixing));
                 m_pending_mixing.clear();
             }
+            m_has_pending_mixing = false;
         }
 
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->is_connected(); });
 
-        Array<Audio::Sample, HARDWARE_BUFFER_SIZE> mixed_buffer;
+        size_t period_size = m_period_size;
+        if (m_mixed_buffer.size() != period_size)
+            resize_period_buffers(period_size);
+        m_mixed_buffer.span().fill({});
+
+        auto device_sample_rate = audiodevice_get_sample_rate();
+        // Fades are specified in milliseconds.
+        auto period_duration = static_cast<double>(period_size) * 1000.0 / static_cast<double>(max(device_sample_rate, 1u));
+
+        double requested_main_volume = m_requested_main_volume;
+        if (m_main_volume.target() != requested_main_volume)
+            m_main_volume = requested_main_volume;
+        auto main_start_gain = logarithmic_gain(m_main_volume);
+        m_main_volume.advance_time(period_duration);
+        auto main_end_gain = logarithmic_gain(m_main_volume);
 
-        m_main_volume.advance_time();
+        auto headroom_gain = logarithmic_gain(SAMPLE_HEADROOM);
 
         // Mix the buffers together into the output
         for (auto& queue : active_mix_queues) {
@@ -77,58 +165,44 @@ void Mixer::mix()
                 queue->clear();
                 continue;
             }
-            queue->volume().advance_time();
-
-            // FIXME: Perform sample extraction and mixing in two separate loops so they can be more easily vectorized.
-            for (auto& mixed_sample : mixed_buffer) {
-                auto sample_or_error = queue->get_next_sample(audiodevice_get_sample_rate());
-                if (sample_or_error.is_error())
-                    break;
-                if (queue->is_muted())
-                    continue;
-                auto sample = sample_or_error.release_value();
-                sample.log_multiply(SAMPLE_HEADROOM);
-                sample.log_multiply(static_cast<float>(queue->volume()));
-                mixed_sample += sample;
-            }
+            auto& volume = queue->mixing_volume();
+            auto start_gain = headroom_gain * logarithmic_gain(volume);
+            volume.advance_time(period_duration);
+            auto end_gain = headroom_gain * logarithmic_gain(volume);
+
+            auto sample_count_or_error = queue->read_samples(m_stream_samples.span(), device_sample_rate);
+            if (sample_count_or_error.is_error() || queue->is_muted())
+                continue;
+            mix_with_gain_ramp(m_mixed_buffer.span(), m_stream_samples.span().trim(sample_count_or_error.value()), start_gain, end_gain);
         }
 
         // Even though it's not realistic, the user expects no sound at 0%.
-        if (m_muted || m_main_volume < 0.01) {
-            if (m_device)
-                m_device->write_until_depleted(m_zero_filled_buffer).release_value_but_fixme_should_propagate_errors();
-        } else {
-            FixedMemoryStream stream { m_stream_buffer.span() };
-
-            for (auto& mixed_sample : mixed_buffer) {
-                mixed_sample.log_multiply(static_cast<float>(m_main_volume));
-                mixed_sample.clip();
-
-                LittleEndian<i16> out_sample;
-                out_sample = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
-
-                out_sample = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
-            }
+        if (m_muted || m_main_volume < 0.01)
+            m_output_buffer.span().fill(0);
+        else
+            convert_to_device_samples(m_mixed_buffer.span(), m_output_buffer.span(), main_start_gain, main_end_gain);
 
-            auto buffered_bytes = MUST(stream.tell());
-            VERIFY(buffered_bytes == m_stream_buffer.size());
-            if (m_device)
-                m_device->write_until_depleted({ m_stream_buffer.data(), buffered_bytes })
-                    .release_value_but_fixme_should_propagate_errors();
-        }
+        if (m_device)
+            m_device->write_until_depleted(ReadonlyBytes { m_output_buffer.data(), m_output_buffer.size() * sizeof(i16) })
+                .release_value_but_fixme_should_propagate_errors();
     }
 }
 
+void Mixer::resize_period_buffers(size_t period_size)
+{
+    m_mixed_buffer.resize(period_size);
+    m_stream_samples.resize(period_size);
+    m_output_buffer.resize(period_size * 2);
+}
+
 void Mixer::set_main_volume(double volume)
 {
     if (volume < 0)
-        m_main_volume = 0;
+        m_requested_main_volume = 0;
     else if (volume > 2)
-        m_main_volume = 2;
+        m_requested_main_volume = 2;
     else
-        m_main_volume = volume;
+        m_requested_main_volume = volume;
 
     m_config->write_num_entry("Master", "Volume", static_cast<int>(volume * 100));
     request_setting_sync();
@@ -138,6 +212,17 @@ void Mixer::set_main_volume(double volume)
     });
 }
 
+void Mixer::set_period_size(size_t period_size)
+{
+    period_size = clamp(period_size, MINIMUM_PERIOD_SIZE, MAXIMUM_PERIOD_SIZE);
+    if (m_period_size == period_size)
+        return;
+    m_period_size = period_size;
+
+    m_config->write_num_entry("Master", "PeriodSize", static_cast<int>(period_size));
+    request_setting_sync();
+}
+
 void Mixer::set_muted(bool muted)
 {
     if (m_muted == muted)
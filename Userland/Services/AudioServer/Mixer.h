@@ -16,6 +16,7 @@
 #include <AK/Debug.h>
 #include <AK/Queue.h>
 #include <AK/RefCounted.h>
+#include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Queue.h>
 #include <LibAudio/Resampler.h>
@@ -31,10 +32,12 @@ namespace AudioServer {
 // Headroom, i.e. fixed attenuation for all audio streams.
 // This is to prevent clipping when two streams with low headroom (e.g. normalized & compressed) are playing.
 constexpr double SAMPLE_HEADROOM = 0.95;
-// The size of the buffer in samples that the hardware receives through write() calls to the audio device.
-constexpr size_t HARDWARE_BUFFER_SIZE = 512;
-// The hardware buffer size in bytes; there's two channels of 16-bit samples.
-constexpr size_t HARDWARE_BUFFER_SIZE_BYTES = HARDWARE_BUFFER_SIZE * 2 * sizeof(i16);
+// The period is the amount of samples that the hardware receives through each write() call to the audio device.
+// Since the mixer thread blocks on the device while a period is being played, this is the main contributor to output latency.
+constexpr size_t DEFAULT_PERIOD_SIZE = 512;
+// At 48 kHz, this is about 1.3 ms.
+constexpr size_t MINIMUM_PERIOD_SIZE = 64;
+constexpr size_t MAXIMUM_PERIOD_SIZE = 8192;
 
 class Mixer : public Core::EventReceiver {
     C_OBJECT_ABSTRACT(Mixer)
@@ -56,7 +59,7 @@ public:
     NonnullRefPtr<ClientAudioStream> create_queue(ConnectionFromClient&);
 
     // To the outside world, we pretend that the target volume is already reached, even though it may be still fading.
-    double main_volume() const { return m_main_volume.target(); }
+    double main_volume() const { return m_requested_main_volume; }
     void set_main_volume(double volume);
 
     bool is_muted() const { return m_muted; }
@@ -65,12 +68,19 @@ public:
     int audiodevice_set_sample_rate(u32 sample_rate);
     u32 audiodevice_get_sample_rate() const;
 
+    // The new period size takes effect at the start of the next period.
+    size_t period_size() const { return m_period_size; }
+    void set_period_size(size_t);
+
 private:
     Mixer(NonnullRefPtr<Core::ConfigFile> config, OwnPtr<Core::File> device);
 
     void request_setting_sync();
 
+    // New streams are handed to the mixer thread through this list. The mixer only takes the mutex
+    // when m_has_pending_mixing is set or when it has nothing to mix, so it never blocks on it while playing.
     Vector<NonnullRefPtr<ClientAudioStream>> m_pending_mixing;
+    Atomic<bool> m_has_pending_mixing { false };
     Threading::Mutex m_pending_mutex;
     Threading::ConditionVariable m_mixing_necessary { m_pending_mutex };
 
@@ -79,16 +89,23 @@ private:
 
     NonnullRefPtr<Threading::Thread> m_sound_thread;
 
-    bool m_muted { false };
+    Atomic<bool> m_muted { false };
+    // Only touched by the mixer thread; m_requested_main_volume is how other threads change it.
     FadingProperty<double> m_main_volume { 1 };
+    Atomic<double> m_requested_main_volume { 1 };
+    Atomic<size_t> m_period_size { DEFAULT_PERIOD_SIZE };
 
     NonnullRefPtr<Core::ConfigFile> m_config;
     RefPtr<Core::Timer> m_config_write_timer;
 
-    Array<u8, HARDWARE_BUFFER_SIZE_BYTES> m_stream_buffer;
-    Array<u8, HARDWARE_BUFFER_SIZE_BYTES> const m_zero_filled_buffer {};
+    // These are owned by the mixer thread and only reallocated when the period size changes.
+    Vector<Audio::Sample> m_mixed_buffer;
+    Vector<Audio::Sample> m_stream_samples;
+    // The device receives two channels of 16-bit samples.
+    Vector<i16> m_output_buffer;
 
     void mix();
+    void resize_period_buffers(size_t period_size);
 };
 
 // Interval in ms when the server tries to save its configuration to disk.
@@ -9,6 +9,7 @@
 #include <LibCore/System.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ParallelFor.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
@@ -19,5 +20,9 @@ ErrorOr<int> serenity_main(Main::Arguments)
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
 
     TRY(Core::System::pledge("stdio recvfd sendfd thread"));
+
+    // Let decoders split up the work for large images.
+    Threading::set_parallel_worker_count(Core::System::hardware_concurrency() - 1);
+
     return event_loop.exec();
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "SampleAggregator.h"
+#include <AK/LexicalPath.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+#include <LibSymbolication/Symbolication.h>
+#include <serenity.h>
+
+namespace ProfilingDaemon {
+
+SampleAggregator::SampleAggregator()
+    : m_kernel_base(Symbolication::kernel_base())
+{
+}
+
+ErrorOr<void> SampleAggregator::consume(Perfcore::Reader& reader)
+{
+    // Stack numbers are only unique within one profile, and the same stack may fold differently
+    // once the libraries of its process change.
+    HashMap<u64, ByteString> folded_stacks;
+
+    Perfcore::Event event;
+    while (TRY(reader.next_event(event))) {
+        switch (event.type) {
+        case PERF_EVENT_PROCESS_CREATE:
+        case PERF_EVENT_PROCESS_EXEC:
+            TRY(m_processes.try_set(event.pid, Process { LexicalPath::basename(event.executable), {} }));
+            folded_stacks.clear();
+            break;
+        case PERF_EVENT_PROCESS_EXIT:
+            m_processes.remove(event.pid);
+            folded_stacks.clear();
+            break;
+        case PERF_EVENT_MMAP:
+            if (auto process = m_processes.find(event.pid); process != m_processes.end())
+                handle_mmap(process->value, event.ptr, event.size, event.name);
+            folded_stacks.clear();
+            break;
+        case PERF_EVENT_SAMPLE: {
+            if (event.stack.is_empty())
+                break;
+            Process const* process = nullptr;
+            if (auto it = m_processes.find(event.pid); it != m_processes.end())
+                process = &it->value;
+            ByteString folded_stack;
+            if (event.stack_id != 0) {
+                auto key = (static_cast<u64>(static_cast<u32>(event.pid)) << 32) | event.stack_id;
+                if (auto it = folded_stacks.find(key); it != folded_stacks.end()) {
+                    folded_stack = it->value;
+                } else {
+                    folded_stack = TRY(fold_stack(process, event.stack));
+                    TRY(folded_stacks.try_set(key, folded_stack));
+                }
+            } else {
+                folded_stack = TRY(fold_stack(process, event.stack));
+            }
+            auto& count = m_folded_stack_counts.ensure(folded_stack, [] { return 0; });
+            count += 1 + event.lost_samples;
+            m_sample_count += 1 + event.lost_samples;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return {};
+}
+
+void SampleAggregator::handle_mmap(Process& process, FlatPtr base, size_t size, StringView name)
+{
+    // Loaded objects are mapped as several regions named "path: .text", "path: .rodata" and so on,
+    // we keep track of a single range per object that spans all of them.
+    StringView path;
+    if (name.contains("Loader.so"sv))
+        path = "/usr/lib/Loader.so"sv;
+    else if (auto colon = name.find(':'); colon.has_value())
+        path = name.substring_view(0, colon.value());
+    else
+        return;
+
+    for (auto& object : process.objects) {
+        if (object.path != path)
+            continue;
+        auto end = max(object.base + object.size, base + size);
+        object.base = min(object.base, base);
+        object.size = end - object.base;
+        return;
+    }
+    process.objects.append({ path, base, size });
+}
+
+ErrorOr<ByteString> SampleAggregator::fold_stack(Process const* process, ReadonlySpan<FlatPtr> stack)
+{
+    StringBuilder builder;
+    TRY(builder.try_append(process ? process->name.view() : "??"sv));
+    // The innermost frame comes first in the stack, every frame but that one is a return address.
+    for (ssize_t i = stack.size() - 1; i >= 0; --i) {
+        TRY(builder.try_append(';'));
+        TRY(builder.try_append(symbolicate(process, stack[i], i != 0)));
+    }
+    return builder.to_byte_string();
+}
+
+ByteString const& SampleAggregator::symbolicate(Process const* process, FlatPtr address, bool is_return_address)
+{
+    StringView path;
+    FlatPtr offset = 0;
+    if (m_kernel_base.has_value() && address >= m_kernel_base.value()) {
+        path = "/boot/Kernel.debug"sv;
+        offset = address - m_kernel_base.value();
+    } else if (process) {
+        for (auto const& object : process->objects) {
+            if (address >= object.base && address - object.base < object.size) {
+                path = object.path;
+                offset = address - object.base;
+                break;
+            }
+        }
+    }
+
+    // Return addresses point to the instruction after the call, so we look up the call itself.
+    if (is_return_address && offset > 0)
+        --offset;
+
+    auto& symbols = m_symbols.ensure(path);
+    return symbols.ensure(path.is_empty() ? address : offset, [&] {
+        if (path.is_empty())
+            return ByteString::formatted("{:p}", address);
+        auto symbol = Symbolication::symbolicate(path, offset, Symbolication::IncludeSourcePosition::No);
+        if (!symbol.has_value() || symbol->name.is_empty())
+            return ByteString::formatted("{}+{:#x}", LexicalPath::basename(path), offset);
+        return symbol->name;
+    });
+}
+
+ErrorOr<void> SampleAggregator::write_folded_stacks(Stream& stream) const
+{
+    for (auto const& it : m_folded_stack_counts) {
+        TRY(stream.write_until_depleted(it.key.bytes()));
+        TRY(stream.write_formatted(" {}\n", it.value));
+    }
+    return {};
+}
+
+void SampleAggregator::clear_samples()
+{
+    m_folded_stack_counts.clear();
+    m_sample_count = 0;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibPerfcore/Reader.h>
+
+namespace ProfilingDaemon {
+
+// Turns the samples of a system-wide profile into folded stacks ("process;outermost;...;innermost count"),
+// which is what flame graph tools consume. Process and library state is kept across profiles, so that a
+// profile can be consumed in chunks.
+class SampleAggregator {
+public:
+    SampleAggregator();
+
+    ErrorOr<void> consume(Perfcore::Reader&);
+
+    ErrorOr<void> write_folded_stacks(Stream&) const;
+    void clear_samples();
+    u64 sample_count() const { return m_sample_count; }
+
+private:
+    struct MappedObject {
+        ByteString path;
+        FlatPtr base { 0 };
+        size_t size { 0 };
+    };
+
+    struct Process {
+        ByteString name;
+        Vector<MappedObject> objects;
+    };
+
+    static void handle_mmap(Process&, FlatPtr base, size_t size, StringView name);
+    ErrorOr<ByteString> fold_stack(Process const*, ReadonlySpan<FlatPtr>);
+    ByteString const& symbolicate(Process const*, FlatPtr address, bool is_return_address);
+
+    Optional<FlatPtr> m_kernel_base;
+    HashMap<pid_t, Process> m_processes;
+
+    // Symbol names by object path and offset, the ELF images themselves are cached by LibSymbolication.
+    HashMap<ByteString, HashMap<FlatPtr, ByteString>> m_symbols;
+
+    HashMap<ByteString, u64> m_folded_stack_counts;
+    u64 m_sample_count { 0 };
+};
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "SampleAggregator.h"
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibMain/Main.h>
+#include <LibPerfcore/Reader.h>
+#include <serenity.h>
+
+static ErrorOr<void> enable_continuous_profiling()
+{
+    auto variable = TRY(Core::File::open("/sys/kernel/conf/profile_continuously"sv, Core::File::OpenMode::Write));
+    TRY(variable->write_until_depleted("1"sv.bytes()));
+    TRY(Core::System::profiling_enable(-1, PERF_EVENT_SAMPLE | PERF_EVENT_MMAP | PERF_EVENT_PROCESS_CREATE | PERF_EVENT_PROCESS_EXEC | PERF_EVENT_PROCESS_EXIT));
+    return {};
+}
+
+static ErrorOr<void> write_window(ProfilingDaemon::SampleAggregator const& aggregator, StringView output_directory)
+{
+    auto path = LexicalPath::join(output_directory, ByteString::formatted("{}.folded", Core::DateTime::now().to_byte_string("%Y-%m-%d-%H%M%S"sv))).string();
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    auto stream = TRY(Core::OutputBufferedFile::create(move(file)));
+    TRY(aggregator.write_folded_stacks(*stream));
+    return {};
+}
+
+static ErrorOr<void> remove_old_windows(StringView output_directory, size_t windows_to_keep)
+{
+    Vector<ByteString> windows;
+    Core::DirIterator iterator(output_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto name = iterator.next_path();
+        if (name.ends_with(".folded"sv))
+            TRY(windows.try_append(move(name)));
+    }
+    if (windows.size() <= windows_to_keep)
+        return {};
+
+    // The file names sort in the order the windows were written.
+    quick_sort(windows);
+    for (size_t i = 0; i < windows.size() - windows_to_keep; ++i)
+        TRY(Core::System::unlink(LexicalPath::join(output_directory, windows[i]).string()));
+    return {};
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    StringView output_directory = "/var/profile"sv;
+    int interval_in_seconds = 10;
+    size_t windows_to_keep = 360;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Continuously sample all processes and keep a rolling history of flame graph data.");
+    args_parser.add_option(output_directory, "Directory to write the aggregated samples to", "output-directory", 'o', "path");
+    args_parser.add_option(interval_in_seconds, "Seconds of samples to aggregate into one file", "interval", 'i', "seconds");
+    args_parser.add_option(windows_to_keep, "Number of files to keep before removing the oldest one", "keep", 'k', "count");
+    args_parser.parse(arguments);
+
+    if (interval_in_seconds <= 0) {
+        warnln("The interval must be at least one second");
+        return 1;
+    }
+
+    Core::EventLoop event_loop;
+
+    // NOTE: Enabling profiling requires us to not have pledged anything yet.
+    TRY(enable_continuous_profiling());
+
+    TRY(Core::System::pledge("stdio rpath wpath cpath"));
+    TRY(Core::Directory::create(ByteString { output_directory }, Core::Directory::CreateDirectories::Yes));
+    // Samples may point into any executable on the system.
+    TRY(Core::System::unveil("/", "r"));
+    TRY(Core::System::unveil(output_directory, "rwc"sv));
+    TRY(Core::System::unveil(nullptr, nullptr));
+
+    ProfilingDaemon::SampleAggregator aggregator;
+    auto timer = Core::Timer::create_repeating(interval_in_seconds * 1000, [&] {
+        auto result = [&]() -> ErrorOr<void> {
+            // Every read of the profile only contains the events that were recorded since the previous one.
+            auto reader = TRY(Perfcore::Reader::open("/sys/kernel/profile"sv));
+            TRY(aggregator.consume(*reader));
+            if (aggregator.sample_count() == 0)
+                return {};
+            TRY(write_window(aggregator, output_directory));
+            aggregator.clear_samples();
+            return remove_old_windows(output_directory, windows_to_keep);
+        }();
+        if (result.is_error())
+            warnln("Failed to collect samples: {}", result.error());
+    });
+    timer->start();
+
+    return event_loop.exec();
+}
@@ -18,6 +18,7 @@
 #include <AK/Memory.h>
 #include <AK/ScopeGuard.h>
 #include <AK/TemporaryChange.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Timer.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Font/Font.h>
@@ -190,12 +191,25 @@ void Compositor::compose()
     // We should have recomputed occlusions if any overlay rects were changed
     VERIFY(!m_overlay_rects_changed);
 
+    auto compose_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
     auto dirty_screen_rects = move(m_dirty_screen_rects);
 
     bool window_stack_transition_in_progress = m_transitioning_to_window_stack != nullptr;
 
+    // A window without any visible rects is completely covered by the windows in front of it, so there
+    // is nothing to render for it. Its pending invalidations can be dropped as well: once any part of
+    // it becomes visible again, recompute_occlusions() invalidates that area of the screen.
+    auto is_fully_covered = [](Window& window) {
+        return window.opaque_rects().is_empty() && window.transparency_rects().is_empty();
+    };
+
     // Mark window regions as dirty that need to be re-rendered
     wm.for_each_visible_window_from_back_to_front([&](Window& window) {
+        if (is_fully_covered(window)) {
+            window.clear_dirty_rects();
+            return IterationDecision::Continue;
+        }
         auto transition_offset = window_transition_offset(window);
         auto frame_rect = window.frame().render_rect();
         auto frame_rect_on_screen = frame_rect.translated(transition_offset);
@@ -289,6 +303,7 @@ void Compositor::compose()
         VERIFY(!screen_data.m_flush_transparent_rects.intersects(rect));
         screen_data.m_have_flush_rects = true;
         screen_data.m_flush_rects.add(rect);
+        m_statistics.opaque_pixel_count += rect.size().area();
         check_restore_cursor_back(screen, rect);
     };
 
@@ -303,6 +318,7 @@ void Compositor::compose()
 
         screen_data.m_have_flush_rects = true;
         screen_data.m_flush_transparent_rects.add(rect);
+        m_statistics.transparent_pixel_count += rect.size().area();
         check_restore_cursor_back(screen, rect);
     };
 
@@ -534,6 +550,10 @@ void Compositor::compose()
             fullscreen_window->clear_dirty_rects();
         } else {
             wm.for_each_visible_window_from_back_to_front([&](Window& window) {
+                if (is_fully_covered(window)) {
+                    ++m_statistics.occluded_window_count;
+                    return IterationDecision::Continue;
+                }
                 compose_window(window);
                 window.clear_dirty_rects();
                 return IterationDecision::Continue;
@@ -602,6 +622,11 @@ void Compositor::compose()
         flush(screen);
         return IterationDecision::Continue;
     });
+
+    auto compose_time_us = static_cast<u64>(compose_timer.elapsed_time().to_microseconds());
+    ++m_statistics.frame_count;
+    m_statistics.total_compose_time_us += compose_time_us;
+    m_statistics.max_compose_time_us = max(m_statistics.max_compose_time_us, compose_time_us);
 }
 
 void Compositor::flush(Screen& screen)
@@ -806,6 +831,11 @@ bool Compositor::set_wallpaper_mode(ByteString const& mode)
     return succeeded;
 }
 
+ByteString Compositor::wallpaper_mode() const
+{
+    return g_config->read_entry("Background", "Mode", "Center");
+}
+
 bool Compositor::set_wallpaper(RefPtr<Gfx::Bitmap const> bitmap)
 {
     if (!bitmap)
@@ -106,6 +106,7 @@ public:
     bool set_background_color(ByteString const& background_color);
 
     bool set_wallpaper_mode(ByteString const& mode);
+    ByteString wallpaper_mode() const;
 
     bool set_wallpaper(RefPtr<Gfx::Bitmap const>);
     RefPtr<Gfx::Bitmap const> wallpaper_bitmap() const { return m_wallpaper; }
@@ -184,6 +185,19 @@ public:
 
     void set_flash_flush(bool b) { m_flash_flush = b; }
 
+    struct Statistics {
+        u64 frame_count { 0 };
+        u64 total_compose_time_us { 0 };
+        u64 max_compose_time_us { 0 };
+        // Pixels painted into the back buffer directly, and through the temporary buffer for transparency.
+        u64 opaque_pixel_count { 0 };
+        u64 transparent_pixel_count { 0 };
+        // Visible windows that were not painted at all because other windows cover them completely.
+        u64 occluded_window_count { 0 };
+    };
+    Statistics const& statistics() const { return m_statistics; }
+    void reset_statistics() { m_statistics = {}; }
+
     static NonnullOwnPtr<CompositorScreenData> create_screen_data(Badge<Screen>)
     {
         return adopt_own(*new CompositorScreenData());
@@ -224,6 +238,8 @@ private:
     bool m_overlay_rects_changed { false };
     bool m_animations_running { false };
 
+    Statistics m_statistics;
+
     IntrusiveList<&Overlay::m_list_node> m_overlay_list;
     Gfx::DisjointIntRectSet m_overlay_rects;
     Gfx::DisjointIntRectSet m_last_rendered_overlay_rects;
@@ -358,6 +358,11 @@ void ConnectionFromClient::set_wallpaper_mode(ByteString const& mode)
     Compositor::the().set_wallpaper_mode(mode);
 }
 
+Messages::WindowServer::GetWallpaperModeResponse ConnectionFromClient::get_wallpaper_mode()
+{
+    return Compositor::the().wallpaper_mode();
+}
+
 Messages::WindowServer::GetWallpaperResponse ConnectionFromClient::get_wallpaper()
 {
     return Compositor::the().wallpaper_bitmap()->to_shareable_bitmap();
@@ -1359,6 +1364,17 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetCompositorStatisticsResponse ConnectionFromClient::get_compositor_statistics()
+{
+    auto const& statistics = Compositor::the().statistics();
+    return { statistics.frame_count, statistics.total_compose_time_us, statistics.max_compose_time_us, statistics.opaque_pixel_count, statistics.transparent_pixel_count, statistics.occluded_window_count };
+}
+
+void ConnectionFromClient::reset_compositor_statistics()
+{
+    Compositor::the().reset_statistics();
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
@@ -9,6 +9,7 @@
 #include <LibAudio/Encoder.h>
 #include <LibAudio/FlacWriter.h>
 #include <LibAudio/Loader.h>
+#include <LibAudio/Resampler.h>
 #include <LibAudio/WavWriter.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/System.h>
@@ -65,6 +66,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView input_format {};
     StringView output_format {};
     StringView output_sample_format;
+    Optional<u32> output_sample_rate;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Convert between audio formats");
@@ -72,6 +74,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(input_format, "Force input codec and container (see manual for supported codecs and containers)", "input-audio-codec", 0, "input-codec");
     args_parser.add_option(output_format, "Set output codec", "audio-codec", 0, "output-codec");
     args_parser.add_option(output_sample_format, "Set output sample format (see manual for supported formats)", "audio-format", 0, "sample-format");
+    args_parser.add_option(output_sample_rate, "Set output sample rate, resampling the input if necessary", "audio-sample-rate", 0, "sample-rate");
     args_parser.add_option(output, "Target file (or '-' for standard output)", "output", 'o', "output");
     args_parser.parse(arguments);
 
@@ -106,6 +109,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         output_format = TRY(guess_format_from_extension(output));
     VERIFY(!output_format.is_empty());
 
+    auto sample_rate = output_sample_rate.value_or(input_loader->sample_rate());
+    Optional<Audio::SincResampler> resampler;
+    if (sample_rate != input_loader->sample_rate())
+        resampler = TRY(Audio::SincResampler::create(input_loader->sample_rate(), sample_rate));
+
     Optional<NonnullOwnPtr<Audio::Encoder>> writer;
     if (!output.is_empty()) {
         if (output_format == "wav"sv) {
@@ -115,7 +123,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
             writer.emplace(TRY(Audio::WavWriter::create_from_file(
                 output,
-                static_cast<int>(input_loader->sample_rate()),
+                static_cast<int>(sample_rate),
                 input_loader->num_channels(),
                 parsed_output_sample_format)));
         } else if (output_format == "flac"sv) {
@@ -131,7 +139,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             auto output_stream = TRY(Core::OutputBufferedFile::create(TRY(Core::File::open(output, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate))));
             auto flac_writer = TRY(Audio::FlacWriter::create(
                 move(output_stream),
-                static_cast<int>(input_loader->sample_rate()),
+                static_cast<int>(sample_rate),
                 input_loader->num_channels(),
                 Audio::pcm_bits_per_sample(parsed_output_sample_format)));
             writer.emplace(move(flac_writer));
@@ -141,7 +149,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
 
         if (writer.has_value()) {
-            (*writer)->sample_count_hint(input_loader->total_samples());
+            (*writer)->sample_count_hint(static_cast<size_t>(static_cast<u64>(input_loader->total_samples()) * sample_rate / input_loader->sample_rate()));
 
             auto metadata = input_loader->metadata();
             metadata.replace_encoder_with_serenity();
@@ -155,6 +163,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (output != "-"sv)
             out("Writing: \033[s");
 
+        Vector<Audio::Sample> resampled;
         auto start = MonotonicTime::now();
         while (input_loader->loaded_samples() < input_loader->total_samples()) {
             auto samples_or_error = input_loader->get_more_samples();
@@ -163,14 +172,26 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 return 1;
             }
             auto samples = samples_or_error.release_value();
-            if (writer.has_value())
+            if (resampler.has_value()) {
+                resampled.clear_with_capacity();
+                TRY(resampler->try_resample_into_end(resampled, samples));
+                if (writer.has_value())
+                    TRY((*writer)->write_samples(resampled));
+            } else if (writer.has_value()) {
                 TRY((*writer)->write_samples(samples));
+            }
             // TODO: Show progress updates like aplay by moving the progress calculation into a common utility function.
             if (output != "-"sv) {
                 out("\033[u{}/{}", input_loader->loaded_samples(), input_loader->total_samples());
                 fflush(stdout);
             }
         }
+        if (resampler.has_value()) {
+            resampled.clear_with_capacity();
+            TRY(resampler->try_flush_into_end(resampled));
+            if (writer.has_value())
+                TRY((*writer)->write_samples(resampled));
+        }
         auto end = MonotonicTime::now();
         auto seconds_to_write = (end - start).to_milliseconds() / 1000.0;
         dbgln("Wrote {} samples in {:.3f}s, {:3.2f}% realtime", input_loader->loaded_samples(), seconds_to_write, input_loader->loaded_samples() / static_cast<double>(input_loader->sample_rate()) / seconds_to_write * 100.0);
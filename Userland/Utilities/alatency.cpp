@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+#include <LibAudio/ConnectionToManagerServer.h>
+#include <LibAudio/ConnectionToServer.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <unistd.h>
+
+// How long we wait for the audio server to pick up a buffer before giving up.
+static constexpr i64 PICKUP_TIMEOUT_MS = 1000;
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    TRY(Core::System::pledge("stdio rpath wpath unix sendfd recvfd thread"));
+
+    int measurement_count = 100;
+    int period_size = 0;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure the latency of the audio server's playback path");
+    args_parser.add_option(measurement_count, "How many buffers to measure", "count", 'c', "count");
+    args_parser.add_option(period_size, "Mixer period size to measure with, in samples", "period", 'p', "samples");
+    args_parser.parse(arguments);
+
+    if (measurement_count <= 0) {
+        warnln("Error: Measurement count must be positive");
+        return 1;
+    }
+
+    TRY(Core::System::unveil("/tmp/session/%sid/portal/audio", "rw"));
+    TRY(Core::System::unveil("/tmp/session/%sid/portal/audiomanager", "rw"));
+    TRY(Core::System::unveil(nullptr, nullptr));
+
+    Core::EventLoop loop;
+    auto audio_client = TRY(Audio::ConnectionToServer::try_create());
+    auto manager_client = TRY(Audio::ConnectionToManagerServer::try_create());
+
+    TRY(Core::System::pledge("stdio sendfd recvfd thread"));
+
+    u32 previous_period_size = manager_client->get_device_period_size();
+    if (period_size > 0)
+        manager_client->set_device_period_size(period_size);
+    u32 effective_period_size = manager_client->get_device_period_size();
+    u32 sample_rate = manager_client->get_device_sample_rate();
+    auto period_duration_us = static_cast<i64>(effective_period_size) * 1'000'000 / max(sample_rate, 1u);
+
+    audio_client->set_self_sample_rate(sample_rate);
+    audio_client->async_start_playback();
+
+    // A short click, so that the measurement is audible.
+    Array<Audio::Sample, Audio::AUDIO_BUFFER_SIZE> click;
+    click.fill({ 0.25f, 0.25f });
+
+    i64 min_latency_us = NumericLimits<i64>::max();
+    i64 max_latency_us = 0;
+    i64 total_latency_us = 0;
+    int measured_count = 0;
+
+    for (int i = 0; i < measurement_count; ++i) {
+        // Let the queue drain completely, so that each buffer is measured from an idle client queue.
+        while (audio_client->remaining_buffers() > 0)
+            usleep(100);
+        // Vary the start time, so that the measurements don't lock onto the mixer's period.
+        usleep(1000 + (i % 7) * period_duration_us / 7);
+
+        auto played_samples_before = audio_client->total_played_samples();
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        if (audio_client->realtime_enqueue(click).is_error()) {
+            warnln("Error: Couldn't enqueue buffer {}", i);
+            continue;
+        }
+
+        bool picked_up = false;
+        while (timer.elapsed_milliseconds() < PICKUP_TIMEOUT_MS) {
+            if (audio_client->total_played_samples() != played_samples_before) {
+                picked_up = true;
+                break;
+            }
+            usleep(50);
+        }
+        if (!picked_up) {
+            warnln("Error: Audio server didn't pick up buffer {} within {} ms", i, PICKUP_TIMEOUT_MS);
+            continue;
+        }
+
+        auto latency_us = timer.elapsed_time().to_microseconds();
+        min_latency_us = min(min_latency_us, latency_us);
+        max_latency_us = max(max_latency_us, latency_us);
+        total_latency_us += latency_us;
+        ++measured_count;
+    }
+
+    if (period_size > 0)
+        manager_client->set_device_period_size(previous_period_size);
+
+    if (measured_count == 0) {
+        warnln("Error: No buffer was picked up by the audio server");
+        return 1;
+    }
+
+    auto average_latency_us = total_latency_us / measured_count;
+    outln("Period: {} samples at {} Hz ({} µs)", effective_period_size, sample_rate, period_duration_us);
+    outln("Pickup latency over {} buffers: min {} µs, average {} µs, max {} µs", measured_count, min_latency_us, average_latency_us, max_latency_us);
+    // Once the mixer has picked up a buffer, it is written to the device as part of a full period.
+    outln("Estimated output latency: min {} µs, average {} µs, max {} µs", min_latency_us + period_duration_us, average_latency_us + period_duration_us, max_latency_us + period_duration_us);
+
+    return 0;
+}
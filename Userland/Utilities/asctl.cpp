@@ -20,7 +20,8 @@
 enum AudioVariable : u32 {
     Volume,
     Mute,
-    SampleRate
+    SampleRate,
+    PeriodSize,
 };
 
 // asctl: audio server control utility
@@ -36,7 +37,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Send control signals to the audio server and hardware.");
     args_parser.add_option(human_mode, "Print human-readable output", "human-readable", 'h');
-    args_parser.add_positional_argument(command, "Command, either (g)et or (s)et\n\n\tThe get command accepts a list of variables to print.\n\tThey are printed in the given order.\n\tIf no value is specified, all are printed.\n\n\tThe set command accepts a any number of variables\n\tfollowed by the value they should be set to.\n\n\tPossible variables are (v)olume, (m)ute, sample(r)ate.\n", "command");
+    args_parser.add_positional_argument(command, "Command, either (g)et or (s)et\n\n\tThe get command accepts a list of variables to print.\n\tThey are printed in the given order.\n\tIf no value is specified, all are printed.\n\n\tThe set command accepts a any number of variables\n\tfollowed by the value they should be set to.\n\n\tPossible variables are (v)olume, (m)ute, sample(r)ate, (p)eriod.\n", "command");
     args_parser.add_positional_argument(command_arguments, "Arguments for the command", "args", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -50,6 +51,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             values_to_print.append(AudioVariable::Volume);
             values_to_print.append(AudioVariable::Mute);
             values_to_print.append(AudioVariable::SampleRate);
+            values_to_print.append(AudioVariable::PeriodSize);
         } else {
             for (auto& variable : command_arguments) {
                 if (variable.is_one_of("v"sv, "volume"sv))
@@ -58,6 +60,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     values_to_print.append(AudioVariable::Mute);
                 else if (variable.is_one_of("r"sv, "samplerate"sv))
                     values_to_print.append(AudioVariable::SampleRate);
+                else if (variable.is_one_of("p"sv, "period"sv))
+                    values_to_print.append(AudioVariable::PeriodSize);
                 else {
                     warnln("Error: Unrecognized variable {}", variable);
                     return 1;
@@ -91,6 +95,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     out("{} ", sample_rate);
                 break;
             }
+            case AudioVariable::PeriodSize: {
+                u32 period_size = audio_client->get_device_period_size();
+                if (human_mode)
+                    outln("Period: {} samples ({:.1} ms)", period_size, static_cast<double>(period_size) * 1000.0 / audio_client->get_device_sample_rate());
+                else
+                    out("{} ", period_size);
+                break;
+            }
             }
         }
         if (!human_mode)
@@ -134,6 +146,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     return 1;
                 }
                 values_to_set.set(AudioVariable::SampleRate, sample_rate.value());
+            } else if (variable.is_one_of("p"sv, "period"sv)) {
+                auto period_size = command_arguments[++i].to_number<int>();
+                if (!period_size.has_value() || period_size.value() <= 0) {
+                    warnln("Error: {} is not a positive integer period size", command_arguments[i - 1]);
+                    return 1;
+                }
+                values_to_set.set(AudioVariable::PeriodSize, period_size.value());
             } else {
                 warnln("Error: Unrecognized variable {}", command_arguments[i]);
                 return 1;
@@ -157,6 +176,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 audio_client->set_device_sample_rate(sample_rate);
                 break;
             }
+            case AudioVariable::PeriodSize: {
+                int& period_size = to_set.value.get<int>();
+                audio_client->set_device_period_size(period_size);
+                break;
+            }
             }
         }
     }
@@ -43,6 +43,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     u64 physical_available = json.get_u64("physical_available"sv).value_or(0);
     u64 physical_committed = json.get_u64("physical_committed"sv).value_or(0);
     u64 physical_uncommitted = json.get_u64("physical_uncommitted"sv).value_or(0);
+    u64 physical_cached = json.get_u64("physical_cached"sv).value_or(0);
+    u64 physical_zeroed = json.get_u64("physical_zeroed"sv).value_or(0);
+    u64 contiguous_2mib_blocks_allocated = json.get_u64("contiguous_2mib_blocks_allocated"sv).value_or(0);
+    u64 contiguous_2mib_block_allocation_failures = json.get_u64("contiguous_2mib_block_allocation_failures"sv).value_or(0);
     u32 kmalloc_call_count = json.get_u32("kmalloc_call_count"sv).value_or(0);
     u32 kfree_call_count = json.get_u32("kfree_call_count"sv).value_or(0);
 
@@ -55,14 +59,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         outln("Physical pages (in use) count: {}", TRY(String::formatted("{} / {}", human_readable_size_long(page_count_to_bytes(physical_pages_in_use), UseThousandsSeparator::Yes), human_readable_size_long(page_count_to_bytes(physical_pages_total), UseThousandsSeparator::Yes))));
         outln("Physical pages (committed) count: {}", TRY(String::formatted("{}", human_readable_size_long(page_count_to_bytes(physical_committed), UseThousandsSeparator::Yes))));
         outln("Physical pages (uncommitted) count: {}", TRY(String::formatted("{}", human_readable_size_long(page_count_to_bytes(physical_uncommitted), UseThousandsSeparator::Yes))));
+        outln("Physical pages (cached) count: {}", TRY(String::formatted("{} ({} zeroed)", human_readable_size_long(page_count_to_bytes(physical_cached), UseThousandsSeparator::Yes), human_readable_size_long(page_count_to_bytes(physical_zeroed), UseThousandsSeparator::Yes))));
         outln("Physical pages (total) count: {:'}", physical_pages_total);
     } else {
         outln("Kmalloc allocated: {}", TRY(String::formatted("{}/{}", kmalloc_allocated, kmalloc_bytes_total)));
         outln("Physical pages (in use) count: {}", TRY(String::formatted("{}/{}", page_count_to_bytes(physical_pages_in_use), page_count_to_bytes(physical_pages_total))));
         outln("Physical pages (committed) count: {}", TRY(String::formatted("{}", page_count_to_bytes(physical_committed))));
         outln("Physical pages (uncommitted) count: {}", TRY(String::formatted("{}", page_count_to_bytes(physical_uncommitted))));
+        outln("Physical pages (cached) count: {}", TRY(String::formatted("{} ({} zeroed)", page_count_to_bytes(physical_cached), page_count_to_bytes(physical_zeroed))));
         outln("Physical pages (total) count: {}", physical_pages_total);
     }
+    outln("Contiguous 2 MiB blocks allocated: {} ({} failed)", contiguous_2mib_blocks_allocated, contiguous_2mib_block_allocation_failures);
     outln("Kmalloc call count: {}", kmalloc_call_count);
     outln("Kfree call count: {}", kfree_call_count);
     outln("Kmalloc/Kfree delta: {}", TRY(String::formatted("{:+}", kmalloc_call_count - kfree_call_count)));
@@ -5,21 +5,33 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinaryHeap.h>
 #include <AK/ByteString.h>
+#include <AK/Checked.h>
 #include <AK/CharacterTypes.h>
-#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/QuickSort.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
+#include <string.h>
+
+static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * MiB;
+// Below this, starting a thread costs more than sorting the lines it would get.
+static constexpr size_t MINIMUM_LINES_PER_THREAD = 16384;
+// How many runs are merged at once, which bounds the number of open temporary files.
+static constexpr size_t MAXIMUM_MERGE_WIDTH = 64;
 
 struct Line {
     StringView key;
     long int numeric_key;
     ByteString line;
     bool numeric;
+    // Position in the input, used to keep lines with equal keys in input order.
+    u64 sequence { 0 };
 
     bool operator<(Line const& other) const
     {
@@ -36,19 +48,6 @@ struct Line {
 
         return key == other.key;
     }
-
-private:
-};
-
-template<>
-struct AK::Traits<Line> : public DefaultTraits<Line> {
-    static unsigned hash(Line const& l)
-    {
-        if (l.numeric)
-            return l.numeric_key;
-
-        return l.key.hash();
-    }
 };
 
 struct Options {
@@ -56,12 +55,313 @@ struct Options {
     bool unique { false };
     bool numeric { false };
     bool reverse { false };
+    bool stable { false };
     bool zero_terminated { false };
+    size_t buffer_size { DEFAULT_BUFFER_SIZE };
     StringView separator {};
     Vector<ByteString> files;
 };
 
-static ErrorOr<void> load_file(Options const& options, StringView filename, StringView line_delimiter, Vector<Line>& lines, HashTable<Line>& seen)
+static Line make_line(Options const& options, ByteString line, u64 sequence)
+{
+    StringView key = line;
+    if (options.key_field != 0) {
+        auto split = (!options.separator.is_empty())
+            ? key.split_view(options.separator)
+            : key.split_view_if(is_ascii_space);
+        if (options.key_field - 1 >= split.size()) {
+            key = ""sv;
+        } else {
+            key = split[options.key_field - 1];
+        }
+    }
+
+    // The key points into the line's buffer, which stays where it is when the line is moved.
+    auto numeric_key = key.to_number<int>().value_or(0);
+    return { key, numeric_key, move(line), options.numeric, sequence };
+}
+
+static bool line_precedes(Line const& a, Line const& b, Options const& options)
+{
+    if (a < b)
+        return !options.reverse;
+    if (b < a)
+        return options.reverse;
+
+    // With -u, the first line of every group of equal keys is the one that is kept.
+    if (options.stable || options.unique)
+        return a.sequence < b.sequence;
+
+    // Otherwise, fall back to comparing whole lines, so that the output doesn't depend on how the input was split up.
+    if (options.reverse)
+        return b.line.view() < a.line.view();
+    return a.line.view() < b.line.view();
+}
+
+// Sorts consecutive slices of the lines on separate threads. The slices still have to be merged afterwards.
+static Vector<Span<Line>> sort_in_slices(Vector<Line>& lines, Options const& options)
+{
+    auto compare = [&options](Line const& a, Line const& b) { return line_precedes(a, b, options); };
+
+    auto slice_count = clamp<size_t>(lines.size() / MINIMUM_LINES_PER_THREAD, 1, max(Core::System::hardware_concurrency(), 1u));
+    auto slice_size = ceil_div(lines.size(), slice_count);
+    Vector<Span<Line>> slices;
+    for (size_t start = 0; start < lines.size(); start += slice_size)
+        slices.append(lines.span().slice(start, min(slice_size, lines.size() - start)));
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 0; i < slices.size(); ++i) {
+        auto slice = slices[i];
+        // The last slice is sorted on this thread, as is any slice that we couldn't start a thread for.
+        if (i + 1 < slices.size()) {
+            auto thread = Threading::Thread::try_create([slice, compare]() mutable -> intptr_t {
+                quick_sort(slice, compare);
+                return 0;
+            },
+                "sort"sv);
+            if (!thread.is_error()) {
+                thread.value()->start();
+                threads.append(thread.release_value());
+                continue;
+            }
+        }
+        quick_sort(slice, compare);
+    }
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    return slices;
+}
+
+// A sorted sequence of lines, either a slice of the lines in memory or a run that was written to a temporary file.
+class MergeSource {
+public:
+    explicit MergeSource(Span<Line> lines)
+        : m_lines(lines)
+    {
+    }
+
+    MergeSource(NonnullOwnPtr<Core::InputBufferedFile> file, size_t line_count)
+        : m_file(move(file))
+        , m_remaining_lines(line_count)
+    {
+    }
+
+    Line const& current() const { return *m_current; }
+
+    ErrorOr<bool> advance(Options const& options, StringView line_delimiter)
+    {
+        if (!m_file) {
+            if (m_index == m_lines.size())
+                return false;
+            m_current = &m_lines[m_index++];
+            return true;
+        }
+
+        // We know how many lines there are, so a trailing empty line isn't mistaken for the end of the file.
+        if (m_remaining_lines == 0)
+            return false;
+        --m_remaining_lines;
+        if (m_buffer.is_empty())
+            m_buffer = TRY(ByteBuffer::create_uninitialized(4096));
+        ByteString line { TRY(m_file->read_until_with_resize(m_buffer, line_delimiter)) };
+        m_file_line = make_line(options, move(line), 0);
+        m_current = &m_file_line;
+        return true;
+    }
+
+private:
+    Span<Line> m_lines;
+    size_t m_index { 0 };
+
+    OwnPtr<Core::InputBufferedFile> m_file;
+    ByteBuffer m_buffer;
+    size_t m_remaining_lines { 0 };
+    Line m_file_line { {}, 0, {}, false };
+
+    Line const* m_current { nullptr };
+};
+
+struct MergeKey {
+    Line const* line;
+    size_t source_index;
+    Options const* options;
+
+    bool operator<(MergeKey const& other) const
+    {
+        if (line_precedes(*line, *other.line, *options))
+            return true;
+        if (line_precedes(*other.line, *line, *options))
+            return false;
+        // The sources are in input order, so this keeps equal lines from different sources in input order.
+        return source_index < other.source_index;
+    }
+};
+
+template<typename Callback>
+static ErrorOr<void> merge(Vector<MergeSource>& sources, Options const& options, StringView line_delimiter, Callback callback)
+{
+    BinaryHeap<MergeKey, size_t, 16> heap;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (TRY(sources[i].advance(options, line_delimiter)))
+            heap.insert({ &sources[i].current(), i, &options }, i);
+    }
+
+    while (!heap.is_empty()) {
+        auto index = heap.pop_min();
+        TRY(callback(sources[index].current()));
+        if (TRY(sources[index].advance(options, line_delimiter)))
+            heap.insert({ &sources[index].current(), index, &options }, index);
+    }
+
+    return {};
+}
+
+// Passes every line on to the callback, except for lines that have the same key as the previous one with -u.
+template<typename Callback>
+static auto unique_filter(Options const& options, Callback callback)
+{
+    return [&options, callback = move(callback), previous_line = Line { {}, 0, {}, false }, has_previous_line = false](Line const& line) mutable -> ErrorOr<void> {
+        if (options.unique) {
+            if (has_previous_line && previous_line == line)
+                return {};
+            previous_line = line;
+            has_previous_line = true;
+        }
+        return callback(line);
+    };
+}
+
+// Sorts lines in chunks that fit into the memory budget, and writes every chunk to a temporary file
+// once the budget is exhausted. The runs are then merged together to produce the output.
+class ExternalSorter {
+public:
+    ExternalSorter(Options const& options, StringView line_delimiter)
+        : m_options(options)
+        , m_line_delimiter(line_delimiter)
+    {
+    }
+
+    ErrorOr<void> add_line(ByteString line)
+    {
+        // Account for the line's buffer and its entry in the vector.
+        m_chunk_size += line.length() + sizeof(Line) + 32;
+        TRY(m_chunk.try_append(make_line(m_options, move(line), m_next_sequence++)));
+        if (m_chunk_size >= m_options.buffer_size)
+            TRY(write_chunk_to_run());
+        return {};
+    }
+
+    ErrorOr<void> finish()
+    {
+        auto write_line = [this](Line const& line) -> ErrorOr<void> {
+            out("{}{}", line.line, m_line_delimiter);
+            return {};
+        };
+
+        if (m_runs.is_empty()) {
+            Vector<MergeSource> sources;
+            for (auto slice : sort_in_slices(m_chunk, m_options))
+                sources.empend(slice);
+            return merge(sources, m_options, m_line_delimiter, unique_filter(m_options, write_line));
+        }
+
+        if (!m_chunk.is_empty())
+            TRY(write_chunk_to_run());
+
+        // There can be fewer than MAXIMUM_MERGE_WIDTH runs left on every level, so the lowest ones are merged
+        // until the rest can be merged at once.
+        while (m_runs.size() > MAXIMUM_MERGE_WIDTH)
+            TRY(merge_last_runs(min(MAXIMUM_MERGE_WIDTH, m_runs.size() - MAXIMUM_MERGE_WIDTH + 1)));
+
+        auto sources = TRY(open_runs(0, m_runs.size()));
+        return merge(sources, m_options, m_line_delimiter, unique_filter(m_options, write_line));
+    }
+
+private:
+    struct Run {
+        int fd;
+        size_t line_count;
+        // How many times the lines of this run have been merged into a bigger run.
+        size_t level { 0 };
+    };
+
+    ErrorOr<void> write_chunk_to_run()
+    {
+        auto slices = sort_in_slices(m_chunk, m_options);
+        Vector<MergeSource> sources;
+        for (auto slice : slices)
+            sources.empend(slice);
+        auto run = TRY(write_run([&](auto callback) { return merge(sources, m_options, m_line_delimiter, unique_filter(m_options, move(callback))); }));
+        TRY(m_runs.try_append(run));
+
+        m_chunk.clear_with_capacity();
+        m_chunk_size = 0;
+
+        // Every run keeps its temporary file open, so MAXIMUM_MERGE_WIDTH runs of the same level are merged into one
+        // run of the next level, and every line is only written once per level. The levels never increase towards
+        // the end, so the runs that are merged are consecutive, which keeps them in input order.
+        while (m_runs.size() >= MAXIMUM_MERGE_WIDTH && m_runs[m_runs.size() - MAXIMUM_MERGE_WIDTH].level == m_runs.last().level)
+            TRY(merge_last_runs(MAXIMUM_MERGE_WIDTH));
+        return {};
+    }
+
+    ErrorOr<void> merge_last_runs(size_t count)
+    {
+        auto level = m_runs.last().level + 1;
+        auto sources = TRY(open_runs(m_runs.size() - count, count));
+        auto merged_run = TRY(write_run([&](auto callback) { return merge(sources, m_options, m_line_delimiter, move(callback)); }));
+        merged_run.level = level;
+        TRY(m_runs.try_append(merged_run));
+        return {};
+    }
+
+    template<typename Producer>
+    ErrorOr<Run> write_run(Producer produce)
+    {
+        char pattern[] = "/tmp/sort.XXXXXX";
+        auto fd = TRY(Core::System::mkstemp(pattern));
+        // The file stays around until we close it, and nobody has to clean up after us if we crash.
+        TRY(Core::System::unlink({ pattern, strlen(pattern) }));
+
+        auto file = TRY(Core::OutputBufferedFile::create(TRY(Core::File::adopt_fd(TRY(Core::System::dup(fd)), Core::File::OpenMode::Write))));
+        size_t line_count = 0;
+        TRY(produce([&](Line const& line) -> ErrorOr<void> {
+            TRY(file->write_until_depleted(line.line.bytes()));
+            TRY(file->write_until_depleted(m_line_delimiter.bytes()));
+            ++line_count;
+            return {};
+        }));
+        file->close();
+
+        return Run { fd, line_count };
+    }
+
+    // Takes count runs starting at index first out of the list of runs, and opens them for merging.
+    ErrorOr<Vector<MergeSource>> open_runs(size_t first, size_t count)
+    {
+        Vector<MergeSource> sources;
+        for (size_t i = 0; i < count; ++i) {
+            auto run = m_runs.take(first);
+            TRY(Core::System::lseek(run.fd, 0, SEEK_SET));
+            auto file = TRY(Core::InputBufferedFile::create(TRY(Core::File::adopt_fd(run.fd, Core::File::OpenMode::Read))));
+            TRY(sources.try_empend(move(file), run.line_count));
+        }
+        return sources;
+    }
+
+    Options const& m_options;
+    StringView m_line_delimiter;
+
+    Vector<Line> m_chunk;
+    size_t m_chunk_size { 0 };
+    u64 m_next_sequence { 0 };
+
+    Vector<Run> m_runs;
+};
+
+static ErrorOr<void> load_file(StringView filename, StringView line_delimiter, ExternalSorter& sorter)
 {
     auto file = TRY(Core::InputBufferedFile::create(
         TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read))));
@@ -73,35 +373,36 @@ static ErrorOr<void> load_file(Options const& options, StringView filename, Stri
         if (line.is_empty() && file->is_eof())
             break;
 
-        StringView key = line;
-        if (options.key_field != 0) {
-            auto split = (!options.separator.is_empty())
-                ? key.split_view(options.separator)
-                : key.split_view_if(is_ascii_space);
-            if (options.key_field - 1 >= split.size()) {
-                key = ""sv;
-            } else {
-                key = split[options.key_field - 1];
-            }
-        }
-
-        Line l = { key, key.to_number<int>().value_or(0), line, options.numeric };
-
-        if (!options.unique || !seen.contains(l)) {
-            lines.append(l);
-            if (options.unique)
-                seen.set(l);
-        }
+        TRY(sorter.add_line(move(line)));
     }
 
     return {};
 }
 
+static ErrorOr<size_t> parse_buffer_size(StringView size)
+{
+    size_t multiplier = 1;
+    if (size.ends_with('K') || size.ends_with('k'))
+        multiplier = KiB;
+    else if (size.ends_with('M') || size.ends_with('m'))
+        multiplier = MiB;
+    else if (size.ends_with('G') || size.ends_with('g'))
+        multiplier = GiB;
+    if (multiplier != 1)
+        size = size.substring_view(0, size.length() - 1);
+
+    auto value = size.to_number<size_t>();
+    if (!value.has_value() || value.value() == 0 || Checked<size_t>::multiplication_would_overflow(value.value(), multiplier))
+        return Error::from_string_literal("Invalid buffer size");
+    return value.value() * multiplier;
+}
+
 ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
 
     Options options;
+    StringView buffer_size;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(options.key_field, "The field to sort by", "key-field", 'k', "keydef");
@@ -109,33 +410,27 @@ ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
     args_parser.add_option(options.numeric, "treat the key field as a number", "numeric", 'n');
     args_parser.add_option(options.separator, "The separator to split fields by", "sep", 't', "char");
     args_parser.add_option(options.reverse, "Sort in reverse order", "reverse", 'r');
+    args_parser.add_option(options.stable, "Keep lines with equal keys in input order", "stable", 's');
+    args_parser.add_option(buffer_size, "How much memory to use before sorting in temporary files", "buffer-size", 'S', "size");
     args_parser.add_option(options.zero_terminated, "Use '\\0' as the line delimiter instead of a newline", "zero-terminated", 'z');
     args_parser.add_positional_argument(options.files, "Files to sort", "file", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (!buffer_size.is_empty())
+        options.buffer_size = TRY(parse_buffer_size(buffer_size));
+
     auto line_delimiter = options.zero_terminated ? "\0"sv : "\n"sv;
-    Vector<Line> lines;
-    HashTable<Line> seen;
+    ExternalSorter sorter { options, line_delimiter };
 
     if (options.files.size() == 0) {
-        TRY(load_file(options, "-"sv, line_delimiter, lines, seen));
+        TRY(load_file("-"sv, line_delimiter, sorter));
     } else {
         for (auto& file : options.files) {
-            TRY(load_file(options, file, line_delimiter, lines, seen));
+            TRY(load_file(file, line_delimiter, sorter));
         }
     }
 
-    quick_sort(lines);
-
-    auto print_lines = [line_delimiter](auto const& lines) {
-        for (auto& line : lines)
-            out("{}{}", line.line, line_delimiter);
-    };
-
-    if (options.reverse)
-        print_lines(lines.in_reverse());
-    else
-        print_lines(lines);
+    TRY(sorter.finish());
 
     return 0;
 }
@@ -13,11 +13,28 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto app = TRY(GUI::Application::create(arguments));
 
     int flash_flush = -1;
+    bool show_statistics = false;
+    bool reset_statistics = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(flash_flush, "Flash flush (repaint) rectangles", "flash-flush", 'f', "0/1");
+    args_parser.add_option(show_statistics, "Show compositor frame statistics", "statistics", 's');
+    args_parser.add_option(reset_statistics, "Reset compositor frame statistics", "reset-statistics", 'r');
     args_parser.parse(arguments);
 
+    auto& connection = GUI::ConnectionToWindowServer::the();
     if (flash_flush != -1)
-        GUI::ConnectionToWindowServer::the().async_set_flash_flush(flash_flush);
+        connection.async_set_flash_flush(flash_flush);
+
+    if (show_statistics) {
+        auto statistics = connection.get_compositor_statistics();
+        auto frame_count = max<u64>(statistics.frame_count(), 1);
+        outln("Frames composed:     {}", statistics.frame_count());
+        outln("Compose time:        average {} µs, max {} µs", statistics.total_compose_time_us() / frame_count, statistics.max_compose_time_us());
+        outln("Pixels per frame:    {} opaque, {} transparent", statistics.opaque_pixel_count() / frame_count, statistics.transparent_pixel_count() / frame_count);
+        outln("Occluded windows:    {} skipped", statistics.occluded_window_count());
+    }
+
+    if (reset_statistics)
+        connection.async_reset_compositor_statistics();
     return 0;
 }